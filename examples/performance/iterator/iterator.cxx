@@ -121,6 +121,29 @@ int main(int argc, char **argv) {
     }
     );
 #endif
+
+  // Region blocks with raw pointers
+  ITERATOR_TEST_BLOCK(
+    "Region blocks (serial)",
+    BOUT_FOR_BLOCKS_SERIAL(first, last, mesh->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int j = first; j < last; ++j) {
+        rd[j] = ad[j] + bd[j];
+      }
+    }
+    );
+
+#ifdef _OPENMP
+  ITERATOR_TEST_BLOCK(
+    "Region blocks (omp)",
+    BOUT_FOR_BLOCKS(first, last, mesh->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int j = first; j < last; ++j) {
+        rd[j] = ad[j] + bd[j];
+      }
+    }
+    );
+#endif
   
   if(profileMode){
     int nthreads=0;
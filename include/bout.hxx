@@ -162,6 +162,20 @@ void setRunStartInfo(Options& options);
 /// options
 void setRunFinishInfo(Options& options);
 
+/// Configure the memory pool used by Array from the `memory` section
+/// of \p options
+void setupArrayAllocator(Options& options);
+
+/// Split the processors into the number of time slices given by
+/// `solver:time_slices` in \p options, for parallel-in-time solvers.
+/// Every time slice has the same state at each output, so only the
+/// first writes the output and restart files. Throws if there is more
+/// than one time slice, but `solver:type` isn't parareal
+void setupTimeSlices(Options& options);
+
+/// Print statistics about the use of the Array memory pool
+void printArrayAllocatorStatistics();
+
 /// Write \p options to \p settings_file in directory \p data_dir
 void writeSettingsFile(Options& options, const std::string& data_dir,
                        const std::string& settings_file);
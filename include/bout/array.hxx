@@ -4,9 +4,9 @@
  * Provides an interface to create, iterate over and release
  * arrays of templated types.
  *
- * Each type and array size has an object store, so when
- * arrays are released they are put into a store. Rather
- * than allocating memory, objects are retrieved from the
+ * The memory for the data comes from bout::ArrayAllocator, so when
+ * arrays are released their memory is put into a store. Rather
+ * than allocating memory, blocks are retrieved from the
  * store. This minimises new and delete operations.
  * 
  * 
@@ -29,6 +29,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <new>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -36,6 +37,7 @@
 
 #include <bout/assert.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/sys/array_allocator.hxx>
 
 namespace {
 template <typename T>
@@ -47,11 +49,24 @@ using const_iterator = const T*;
 /*!
  * ArrayData holds the actual data
  * Handles the allocation and deletion of data
+ *
+ * Memory is obtained from bout::ArrayAllocator, so is aligned to
+ * (at least) bout::ArrayAllocator::alignment bytes
  */
 template <typename T>
 struct ArrayData {
-  ArrayData(int size) : len(size) { data = new T[len]; }
-  ~ArrayData() { delete[] data; }
+  ArrayData(int size) : len(size) {
+    data = static_cast<T*>(bout::ArrayAllocator::allocate(len * sizeof(T)));
+    for (int i = 0; i < len; ++i) {
+      new (data + i) T;
+    }
+  }
+  ~ArrayData() {
+    for (int i = 0; i < len; ++i) {
+      data[i].~T();
+    }
+    bout::ArrayAllocator::deallocate(data, len * sizeof(T));
+  }
   iterator<T> begin() const { return data; }
   iterator<T> end() const { return data + len; }
   int size() const { return len; }
@@ -76,19 +91,23 @@ private:
  * vals[10] = 1.0;  // ok
  * 
  * When an Array goes out of scope or is deleted,
- * the underlying memory (dataBlock/Backing) is put into
- * a map, rather than being freed. 
- * If the same size arrays are used repeatedly then this
- * avoids the need to use new and delete.
+ * the underlying memory is kept by bout::ArrayAllocator,
+ * rather than being freed.
+ * If arrays of similar sizes are used repeatedly then this
+ * avoids the need to allocate memory from the system.
  *
  * This behaviour can be disabled by calling the static function useStore:
  *
  * Array<dcomplex>::useStore(false); // Disables memory store
+ *
+ * Note that the store is shared by all Array types, so this
+ * disables it for every type.
  * 
  * The second template argument determines what type of container to use to
  * store data. This defaults to a custom struct but can be std::valarray (
  * provided T is a compatible type), std::vector etc. Must provide the following :
  *  size, operator=, operator[], begin, end
+ * Only the default container uses the store.
  */
 template<typename T, typename Backing = ArrayData<T>>
 class Array {
@@ -156,22 +175,18 @@ public:
   }
 
   /*!
-   * Holds a static variable which controls whether
-   * memory blocks (dataBlock) are put into a store
-   * or new/deleted each time. 
+   * Controls whether memory blocks are put into a store
+   * or freed each time.
    *
-   * The variable is initialised to true on first use,
-   * but can be set to false by passing "false" as input.
+   * The store is initially used, but can be disabled by passing
+   * "false" as input. This frees the memory already held.
    * Once set to false it can't be changed back to true.
    */
   static bool useStore( bool keep_using = true ) noexcept {
-    static bool value = true;
-    if (keep_using) {
-      return value; 
+    if (!keep_using) {
+      bout::ArrayAllocator::cleanup();
     }
-    // Change to false
-    value = false;
-    return value;
+    return bout::ArrayAllocator::isEnabled();
   }
   
   /*!
@@ -188,11 +203,10 @@ public:
    * Note: After this is called the store cannot be re-enabled
    */
   static void cleanup() {
-    // Clean the store, deleting data
-    store(true);
-    // Don't use the store anymore. This is so that array releases
-    // after cleanup() get deleted rather than put into the store
-    useStore(false);
+    // Delete the data in the store, and don't use the store
+    // anymore. This is so that array releases after cleanup() get
+    // deleted rather than put into the store
+    bout::ArrayAllocator::cleanup();
   }
 
   /*!
@@ -239,7 +253,6 @@ public:
     p->operator=((*ptr));
 
     //Update the local pointer and release old
-    //Can't just do ptr=p as need to try to add to store.
     release(ptr);
     ptr = std::move(p);
   }
@@ -294,112 +307,28 @@ private:
    */
   dataPtrType ptr;
 
-  using storeType = std::map<size_type, std::vector<dataPtrType>>;
-  using arenaType = std::vector<storeType>;
-
-  /*!
-   * This maps from array size (size_type) to vectors of pointers to dataBlock objects
-   *
-   * By putting the static store inside a function it is initialised on first use,
-   * and doesn't need to be separately declared for each type T
-   *
-   * Inputs
-   * ------
-   *
-   * @param[in] cleanup   If set to true, deletes all dataBlock and clears the store
-   */
-  static storeType& store(bool cleanup=false) {
-#ifdef _OPENMP    
-    static arenaType arena(omp_get_max_threads());
-#else
-    static arenaType arena(1);
-#endif
-    
-    if (!cleanup) {
-#ifdef _OPENMP 
-      return arena[omp_get_thread_num()];
-#else
-      return arena[0];
-#endif
-    }
-
-    // Clean by deleting all data -- possible that just stores.clear() is
-    // sufficient rather than looping over each entry.
-    BOUT_OMP(single)
-    {
-      for (auto &stores : arena) {
-        for (auto &p : stores) {
-          auto &v = p.second;
-          for (dataPtrType a : v) {
-            a.reset();
-          }
-          v.clear();
-        }
-        stores.clear();
-      }
-      // Here we ensure there is exactly one empty map still
-      // left in the arena as we have to return one such item
-      arena.resize(1);
-    }
-
-    //Store should now be empty but we need to return something,
-    //so return an empty storeType from the arena.
-    return arena[0];
-  }
-  
   /*!
-   * Returns a pointer to a dataBlock object of size \p len with no
-   * references. This is either from the store, or newly allocated
+   * Returns a pointer to a new dataBlock object of size \p len with
+   * no references. The memory for this comes from the store, if the
+   * default ArrayData backing is used
    *
    * Expects \p len >= 0
    */
   dataPtrType get(size_type len) {
     ASSERT3(len >= 0);
 
-    dataPtrType p;
-
-    auto& st = store()[len];
-    
-    if (!st.empty()) {
-      p = st.back();
-      st.pop_back();
-    } else {
-      // Ensure that when we release the data block later we'll have
-      // enough space to put it in the store so that `release` can be
-      // noexcept
-      st.reserve(1);
-      p = std::make_shared<dataBlock>(len);
-    }
-
-    return p;
+    return std::make_shared<dataBlock>(len);
   }
 
   /*!
    * Release an dataBlock object, reducing its reference count by one.
-   * If no more references, then put back into the store.
+   * If no more references, then the dataBlock is deleted, returning
+   * its memory to the store.
    * It's important to pass a reference to the pointer, otherwise we get
    * a copy of the shared_ptr, which therefore increases the use count
    * and doesn't allow us to free the pass pointer directly
-   *
-   * Note that this is noexcept only because we've ensure that both a)
-   * store()[<size>] already exists, and b) it has space for at least
-   * one data block. Of course, store() could throw -- in which case
-   * we're doomed anyway, so the only thing we can do is abort
    */
   void release(dataPtrType& d) noexcept {
-    if (!d)
-      return;
-
-    // Reduce reference count, and if zero return to store
-    if (d.use_count() == 1) {
-      if (useStore()) {
-        // Put back into store
-        store()[d->size()].push_back(std::move(d));
-        // Could return here but seems to slow things down a lot
-      }
-    }
-
-    // Finish by setting pointer to nullptr if not putting on store
     d = nullptr;
   }
 };
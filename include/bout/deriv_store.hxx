@@ -33,6 +33,7 @@
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <bout/scorepwrapper.hxx>
 
@@ -53,6 +54,11 @@ struct DerivativeStore {
   using standardFunc = std::function<void(const FieldType&, FieldType&, const std::string&)>;
   using flowFunc =
       std::function<void(const FieldType&, const FieldType&, FieldType&, const std::string&)>;
+  /// References to several input fields, so that their parallel
+  /// slices are kept
+  using fieldRefs = std::vector<std::reference_wrapper<const FieldType>>;
+  using standardManyFunc =
+      std::function<void(const fieldRefs&, std::vector<FieldType>&, const std::string&)>;
   using upwindFunc = flowFunc;
   using fluxFunc = flowFunc;
 
@@ -229,6 +235,39 @@ struct DerivativeStore {
                        method.meta.key);
   };
 
+  /// Register a function which applies a standard derivative to
+  /// several fields at once. This is optional: methods without one
+  /// are applied to each field in turn by getStandardDerivativeMany
+  void registerDerivativeMany(standardManyFunc func, DERIV derivType,
+                              DIRECTION direction, STAGGER stagger,
+                              std::string methodName) {
+    AUTO_TRACE();
+    if (derivType != DERIV::Standard && derivType != DERIV::StandardSecond
+        && derivType != DERIV::StandardFourth) {
+      throw BoutException("Invalid function signature in registerDerivativeMany : "
+                          "Function signature 'standardMany' but derivative type %s "
+                          "passed",
+                          toString(derivType).c_str());
+    }
+
+    const auto key = getKey(direction, stagger, toString(derivType) + methodName);
+    if (standardMany.count(key) != 0) {
+      throw BoutException("Trying to override batched %s derivative : "
+                          "direction %s, stagger %s, key %s",
+                          toString(derivType).c_str(), toString(direction).c_str(),
+                          toString(stagger).c_str(), methodName.c_str());
+    }
+    standardMany[key] = func;
+  }
+
+  template <typename Direction, typename Stagger, typename Method>
+  void registerDerivativeMany(standardManyFunc func, Direction direction,
+                              Stagger stagger, Method method) {
+    AUTO_TRACE();
+    registerDerivativeMany(func, method.meta.derivType, direction.lookup(),
+                           stagger.lookup(), method.meta.key);
+  }
+
   /// Routines to return a specific differential operator. Note we
   /// have to have a separate routine for different methods as they
   /// have different return types. As such we choose to use a
@@ -279,6 +318,32 @@ struct DerivativeStore {
     return getStandardDerivative(name, direction, stagger, DERIV::StandardFourth);
   };
 
+  /// Return a function applying a standard derivative to several
+  /// fields at once. If the method didn't register a batched version,
+  /// this applies its standardFunc to each field in turn
+  standardManyFunc getStandardDerivativeMany(std::string name, DIRECTION direction,
+                                             STAGGER stagger = STAGGER::None,
+                                             DERIV derivType = DERIV::Standard) const {
+    AUTO_TRACE();
+    const auto realName = nameLookup(
+        name, defaultMethods.at(getKey(direction, stagger, toString(derivType))));
+
+    const auto resultOfFind =
+        standardMany.find(getKey(direction, stagger, toString(derivType) + realName));
+    if (resultOfFind != standardMany.end()) {
+      return resultOfFind->second;
+    }
+
+    // Throws if there's no such method
+    const auto func = getStandardDerivative(realName, direction, stagger, derivType);
+    return [func](const fieldRefs& vars, std::vector<FieldType>& results,
+                  const std::string& region) {
+      for (std::size_t k = 0; k < vars.size(); ++k) {
+        func(vars[k], results[k], region);
+      }
+    };
+  }
+
   flowFunc getFlowDerivative(std::string name, DIRECTION direction,
                              STAGGER stagger = STAGGER::None,
                              DERIV derivType = DERIV::Upwind) const {
@@ -418,6 +483,7 @@ struct DerivativeStore {
     standard.clear();
     standardSecond.clear();
     standardFourth.clear();
+    standardMany.clear();
     upwind.clear();
     flux.clear();
     registeredMethods.clear();
@@ -442,6 +508,8 @@ private:
   storageType<std::size_t, standardFunc> standard;
   storageType<std::size_t, standardFunc> standardSecond;
   storageType<std::size_t, standardFunc> standardFourth;
+  /// Optional batched versions of all the standard derivatives
+  storageType<std::size_t, standardManyFunc> standardMany;
   storageType<std::size_t, upwindFunc> upwind;
   storageType<std::size_t, fluxFunc> flux;
 
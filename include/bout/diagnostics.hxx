@@ -0,0 +1,120 @@
+/*!************************************************************************
+ * \file diagnostics.hxx
+ *
+ * Reduced diagnostics calculated from 3D fields at each output
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef __DIAGNOSTICS_H__
+#define __DIAGNOSTICS_H__
+
+#include "bout/monitor.hxx"
+#include "field2d.hxx"
+#include "fieldperp.hxx"
+#include "unused.hxx"
+
+#include <functional>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+class Datafile;
+class Field3D;
+class Mesh;
+class Options;
+class Solver;
+
+namespace bout {
+
+/*!
+ * Reductions of 3D fields, calculated at each output and written to
+ * the output file instead of (or as well as) the full fields.
+ *
+ * Which reductions are wanted is set in the input, as lists of field
+ * names:
+ *
+ *     [diagnostics]
+ *     dc = n, phi      # Z average: n_dc, phi_dc
+ *     average_x = n    # X and Z average: n_avg_x
+ *     average_y = n    # Y and Z average: n_avg_y
+ *     slice = phi      # X-Z slice at global Y index slice_y: phi_slice
+ *     slice_y = 8
+ *     modes = phi      # Z Fourier mode amplitudes: phi_mode1 ... phi_mode<nmodes>
+ *     nmodes = 4
+ *
+ * Fields are made available with add(). PhysicsModel adds all the
+ * evolving Field3Ds, and any others can be added in init():
+ *
+ *     diagnostics.add(phi, "phi");
+ *
+ * Each reduction is added to the output file as a time-dependent
+ * variable. As a Monitor, the reductions are calculated before each
+ * output is written.
+ */
+class Diagnostics : public Monitor {
+public:
+  /// Read the wanted reductions from \p options, and write the
+  /// results to \p file
+  Diagnostics(Options& options, Datafile& file, Mesh* mesh = nullptr);
+
+  /// Make \p f available as \p name, adding any reductions of it to
+  /// the output file. \p f must not be destroyed before this object
+  void add(const Field3D& f, const std::string& name);
+
+  /// Are any reductions wanted?
+  bool enabled() const { return not wanted.empty(); }
+
+  /// Calculate all the reductions from the current values of the
+  /// fields. Throws if any requested field hasn't been added
+  void calculate();
+
+  int call(Solver* UNUSED(solver), BoutReal UNUSED(time), int UNUSED(iter),
+           int UNUSED(nout)) override {
+    calculate();
+    return 0;
+  }
+
+private:
+  Datafile& file;
+  Mesh* mesh;
+
+  std::vector<std::string> dc, average_x, average_y, slice, modes;
+  int slice_y; ///< Global Y index of slices
+  int nmodes;  ///< Number of Z Fourier modes
+
+  /// All the names in the lists above
+  std::set<std::string> wanted;
+  /// Names passed to add()
+  std::set<std::string> added;
+
+  /// The results, which must not move once added to the file
+  std::list<Field2D> results2d;
+  std::list<FieldPerp> results_perp;
+
+  /// Each calculates one or more results
+  std::vector<std::function<void()>> calculations;
+
+  /// Add a Field2D result called \p name to the output file
+  Field2D& addResult2D(const std::string& name);
+};
+
+} // namespace bout
+
+#endif // __DIAGNOSTICS_H__
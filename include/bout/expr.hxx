@@ -12,7 +12,7 @@
 #ifndef __EXPR_H__
 #define __EXPR_H__
 
-#warning expr.hxx is deprecated. Do not use!
+#warning expr.hxx is deprecated. Do not use! See bout/field_expr.hxx instead
 
 #include <field3d.hxx>
 #include <field2d.hxx>
@@ -0,0 +1,333 @@
+/*!************************************************************************
+ * \file field_expr.hxx
+ *
+ * Lazy expression templates for fused Field2D/Field3D arithmetic
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+/// The ordinary arithmetic operators on Field3D and Field2D (see
+/// generated_fieldops.cxx) are eager: each one allocates a new field
+/// and makes a full pass over memory. A right-hand side like
+/// `a * b + c / d - e` therefore makes four passes and four
+/// allocations.
+///
+/// The classes here build a lightweight tree describing the whole
+/// expression instead, which is only evaluated when it is assigned
+/// to a Field3D with `evaluate` or `assign`. Evaluation is a single
+/// pass over the Region, blocked in the same way as BOUT_FOR and
+/// with a contiguous inner loop over Z that the compiler can
+/// vectorise.
+///
+/// Expressions are opt-in: at least one operand must be wrapped with
+/// `bout::expr::lazy`, after which any Field3D, Field2D or BoutReal
+/// can be combined with the expression using `+`, `-`, `*` and `/`:
+///
+///     using bout::expr::lazy;
+///     Field3D result = bout::expr::evaluate(lazy(a) * b + lazy(c) / d - e);
+///
+///     // Or update an existing field in place
+///     bout::expr::assign(result, lazy(a) * b + 1.0, "RGN_NOBNDRY");
+///
+/// Note that `c / d` is only fused if one of `c` or `d` is lazy,
+/// otherwise the usual eager operator is used.
+///
+/// Expressions only hold pointers to their operands, so they must
+/// not outlive the fields they refer to: don't store them with
+/// `auto`, evaluate them in the same statement.
+///
+/// This replaces the deprecated expr.hxx
+
+#ifndef __FIELD_EXPR_H__
+#define __FIELD_EXPR_H__
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+#include "bout/assert.hxx"
+#include "bout/openmpwrap.hxx"
+#include "bout/region.hxx"
+#include "bout_types.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "unused.hxx"
+
+namespace bout {
+namespace expr {
+
+/// Leaf node wrapping a Field3D
+///
+/// Holds a pointer to the field, so the field must outlive the
+/// expression
+class Field3DLeaf {
+public:
+  static constexpr bool has_field3d = true;
+
+  explicit Field3DLeaf(const Field3D& f)
+      : field(&f), data(f.isAllocated() ? f(0, 0) : nullptr) {}
+
+  BoutReal operator()(int index3d, int UNUSED(index2d)) const { return data[index3d]; }
+
+  /// The first Field3D in the expression, used to construct the result
+  const Field3D& base() const { return *field; }
+
+  /// Check that this operand can be combined with \p reference
+  void check(const Field3D& reference) const {
+    ASSERT1(areFieldsCompatible(*field, reference));
+    checkData(*field);
+  }
+
+private:
+  const Field3D* field;
+  const BoutReal* data;
+};
+
+/// Leaf node wrapping a Field2D, broadcast along Z
+class Field2DLeaf {
+public:
+  static constexpr bool has_field3d = false;
+
+  explicit Field2DLeaf(const Field2D& f)
+      : field(&f), data(f.isAllocated() ? &f(0, 0) : nullptr) {}
+
+  BoutReal operator()(int UNUSED(index3d), int index2d) const { return data[index2d]; }
+
+  void check(const Field3D& reference) const {
+    ASSERT1(areFieldsCompatible(*field, reference));
+    checkData(*field);
+  }
+
+private:
+  const Field2D* field;
+  const BoutReal* data;
+};
+
+/// Leaf node wrapping a constant value
+class ScalarLeaf {
+public:
+  static constexpr bool has_field3d = false;
+
+  ScalarLeaf(BoutReal value_in) : value(value_in) {}
+
+  BoutReal operator()(int UNUSED(index3d), int UNUSED(index2d)) const { return value; }
+
+  void check(const Field3D& UNUSED(reference)) const {}
+
+private:
+  BoutReal value;
+};
+
+/// Node applying the binary operation \p Op to the nodes \p L and \p R
+///
+/// The operation tags (Addition, Multiplication, etc.) are generated
+/// by gen_fieldops.py, along with the operators which create these
+/// nodes
+template <class Op, class L, class R>
+class BinaryExpr {
+public:
+  static constexpr bool has_field3d = L::has_field3d or R::has_field3d;
+
+  BinaryExpr(L lhs, R rhs) : lhs(lhs), rhs(rhs) {}
+
+  BoutReal operator()(int index3d, int index2d) const {
+    return Op::apply(lhs(index3d, index2d), rhs(index3d, index2d));
+  }
+
+  template <bool LeftHasField3D = L::has_field3d>
+  const typename std::enable_if<LeftHasField3D, Field3D>::type& base() const {
+    return lhs.base();
+  }
+  template <bool LeftHasField3D = L::has_field3d>
+  const typename std::enable_if<not LeftHasField3D, Field3D>::type& base() const {
+    return rhs.base();
+  }
+
+  void check(const Field3D& reference) const {
+    lhs.check(reference);
+    rhs.check(reference);
+  }
+
+private:
+  L lhs;
+  R rhs;
+};
+
+/// Node for unary minus
+template <class E>
+class NegateExpr {
+public:
+  static constexpr bool has_field3d = E::has_field3d;
+
+  explicit NegateExpr(E expr) : expr(expr) {}
+
+  BoutReal operator()(int index3d, int index2d) const {
+    return -expr(index3d, index2d);
+  }
+
+  const Field3D& base() const { return expr.base(); }
+
+  void check(const Field3D& reference) const { expr.check(reference); }
+
+private:
+  E expr;
+};
+
+/// If `T` is a lazy expression node, provides the member constant
+/// `value` equal to `true`. Otherwise `value` is `false`
+template <class T>
+struct is_expr : std::false_type {};
+template <>
+struct is_expr<Field3DLeaf> : std::true_type {};
+template <>
+struct is_expr<Field2DLeaf> : std::true_type {};
+template <class Op, class L, class R>
+struct is_expr<BinaryExpr<Op, L, R>> : std::true_type {};
+template <class E>
+struct is_expr<NegateExpr<E>> : std::true_type {};
+
+/// Map an operand type to the node type used to store it
+template <class T, class Enable = void>
+struct as_leaf {};
+template <class T>
+struct as_leaf<T, typename std::enable_if<is_expr<T>::value>::type> {
+  using type = T;
+};
+template <class T>
+struct as_leaf<T, typename std::enable_if<std::is_base_of<Field3D, T>::value>::type> {
+  using type = Field3DLeaf;
+};
+template <class T>
+struct as_leaf<T, typename std::enable_if<std::is_base_of<Field2D, T>::value>::type> {
+  using type = Field2DLeaf;
+};
+template <class T>
+struct as_leaf<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+  using type = ScalarLeaf;
+};
+
+template <class T>
+using Leaf = typename as_leaf<T>::type;
+
+/// Enable a function only if both \p L and \p R are valid operands
+/// and at least one of them is already a lazy expression. This
+/// prevents these operators hiding the eager Field operators
+template <class L, class R>
+using EnableIfExprOperands = typename std::enable_if<
+    (is_expr<L>::value or is_expr<R>::value)
+    and std::is_class<typename as_leaf<L>::type>::value
+    and std::is_class<typename as_leaf<R>::type>::value>::type;
+
+/// Convert an operand to an expression node
+template <class T, typename = typename std::enable_if<is_expr<T>::value>::type>
+const T& asLeaf(const T& expr) {
+  return expr;
+}
+inline Field3DLeaf asLeaf(const Field3D& f) { return Field3DLeaf{f}; }
+inline Field2DLeaf asLeaf(const Field2D& f) { return Field2DLeaf{f}; }
+inline ScalarLeaf asLeaf(BoutReal value) { return ScalarLeaf{value}; }
+
+/// Start a lazy expression from the field \p f
+inline Field3DLeaf lazy(const Field3D& f) { return Field3DLeaf{f}; }
+inline Field2DLeaf lazy(const Field2D& f) { return Field2DLeaf{f}; }
+
+/// Unary minus of an expression
+template <class E, typename = typename std::enable_if<is_expr<E>::value>::type>
+NegateExpr<E> operator-(const E& expr) {
+  return NegateExpr<E>{expr};
+}
+
+/// Evaluate \p expr over \p region, writing the result into \p out
+///
+/// The outer loop is over the contiguous blocks of \p region, and is
+/// parallelised with OpenMP. Each block is split into pieces which
+/// lie in a single Z-line, so that Field2D operands are loop
+/// invariant and the inner loop can be vectorised
+template <class Expr>
+void evaluateInto(BoutReal* out, const Expr& expr, const Region<Ind3D>& region,
+                  int nz) {
+  BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+  for (auto block = region.getBlocks().cbegin(); block < region.getBlocks().cend();
+       ++block) {
+    const int block_end = block->second.ind;
+    for (int index = block->first.ind; index < block_end;) {
+      const int index2d = index / nz;
+      const int line_end = std::min(block_end, (index2d + 1) * nz);
+      for (int index3d = index; index3d < line_end; ++index3d) {
+        out[index3d] = expr(index3d, index2d);
+      }
+      index = line_end;
+    }
+  }
+}
+
+/// Evaluate the expression \p expr in a single pass over \p region,
+/// returning a new Field3D. The result has the same mesh, location
+/// and directions as the first Field3D operand in the expression
+///
+/// As with the eager operators, the default is to evaluate over all
+/// points including guard cells
+template <class Expr, typename = typename std::enable_if<is_expr<Expr>::value>::type>
+Field3D evaluate(const Expr& expr, const std::string& region = "RGN_ALL") {
+  static_assert(Expr::has_field3d,
+                "bout::expr::evaluate requires at least one Field3D operand");
+
+  const Field3D& base = expr.base();
+  expr.check(base);
+
+  Field3D result{emptyFrom(base)};
+  evaluateInto(&result(0, 0, 0), expr, result.getRegion(region), result.getNz());
+
+  checkData(result, region);
+  return result;
+}
+
+/// Evaluate the expression \p expr in a single pass over \p region,
+/// writing the result into the existing field \p result. Points
+/// outside \p region are unchanged. \p result may itself appear in
+/// \p expr
+template <class Expr, typename = typename std::enable_if<is_expr<Expr>::value>::type>
+Field3D& assign(Field3D& result, const Expr& expr, const std::string& region = "RGN_ALL") {
+  static_assert(Expr::has_field3d,
+                "bout::expr::assign requires at least one Field3D operand");
+
+  const Field3D& base = expr.base();
+  expr.check(base);
+
+  if (not result.isAllocated()) {
+    result = emptyFrom(base);
+  } else {
+    ASSERT1(areFieldsCompatible(result, base));
+    // Make sure we don't write into data shared with another field
+    result.allocate();
+  }
+  // Any parallel slices will no longer be correct
+  result.clearParallelSlices();
+
+  evaluateInto(&result(0, 0, 0), expr, result.getRegion(region), result.getNz());
+
+  checkData(result, region);
+  return result;
+}
+
+} // namespace expr
+} // namespace bout
+
+#include "bout/generated_fieldexpr.hxx"
+
+#endif // __FIELD_EXPR_H__
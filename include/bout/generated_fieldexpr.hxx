@@ -0,0 +1,61 @@
+// This file is autogenerated - see gen_fieldops.py
+#ifndef __GENERATED_FIELDEXPR_H__
+#define __GENERATED_FIELDEXPR_H__
+
+#include "bout/field_expr.hxx"
+
+namespace bout {
+namespace expr {
+
+/// Lazy multiplication node tag: applies `lhs * rhs` pointwise
+struct Multiplication {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs * rhs; }
+};
+
+/// Lazy multiplication of \p lhs and \p rhs, at least one of
+/// which is already an expression
+template <class L, class R, typename = EnableIfExprOperands<L, R>>
+BinaryExpr<Multiplication, Leaf<L>, Leaf<R>> operator*(const L& lhs, const R& rhs) {
+  return BinaryExpr<Multiplication, Leaf<L>, Leaf<R>>{asLeaf(lhs), asLeaf(rhs)};
+}
+
+/// Lazy division node tag: applies `lhs / rhs` pointwise
+struct Division {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs / rhs; }
+};
+
+/// Lazy division of \p lhs and \p rhs, at least one of
+/// which is already an expression
+template <class L, class R, typename = EnableIfExprOperands<L, R>>
+BinaryExpr<Division, Leaf<L>, Leaf<R>> operator/(const L& lhs, const R& rhs) {
+  return BinaryExpr<Division, Leaf<L>, Leaf<R>>{asLeaf(lhs), asLeaf(rhs)};
+}
+
+/// Lazy addition node tag: applies `lhs + rhs` pointwise
+struct Addition {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs + rhs; }
+};
+
+/// Lazy addition of \p lhs and \p rhs, at least one of
+/// which is already an expression
+template <class L, class R, typename = EnableIfExprOperands<L, R>>
+BinaryExpr<Addition, Leaf<L>, Leaf<R>> operator+(const L& lhs, const R& rhs) {
+  return BinaryExpr<Addition, Leaf<L>, Leaf<R>>{asLeaf(lhs), asLeaf(rhs)};
+}
+
+/// Lazy subtraction node tag: applies `lhs - rhs` pointwise
+struct Subtraction {
+  static BoutReal apply(BoutReal lhs, BoutReal rhs) { return lhs - rhs; }
+};
+
+/// Lazy subtraction of \p lhs and \p rhs, at least one of
+/// which is already an expression
+template <class L, class R, typename = EnableIfExprOperands<L, R>>
+BinaryExpr<Subtraction, Leaf<L>, Leaf<R>> operator-(const L& lhs, const R& rhs) {
+  return BinaryExpr<Subtraction, Leaf<L>, Leaf<R>>{asLeaf(lhs), asLeaf(rhs)};
+}
+
+} // namespace expr
+} // namespace bout
+
+#endif // __GENERATED_FIELDEXPR_H__
@@ -92,6 +92,10 @@ public:
 /*!
  * This is a thin wrapper around a DataFormat object. Only needs to implement
  * reading routines.
+ *
+ * Each field is read as a single block. If the DataFormat is
+ * collective (see shared_read_format), all processors must get the
+ * same variables in the same order, as they do when loading the mesh.
  */
 class GridFile : public GridDataSource {
 public:
@@ -29,8 +29,11 @@
 #ifndef __INDEX_DERIVS_HXX__
 #define __INDEX_DERIVS_HXX__
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 
 #include <bout/assert.hxx>
 #include <bout/constants.hxx>
@@ -89,12 +92,54 @@ public:
             || meta.derivType == DERIV::StandardFourth)
     ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
 
+    if (stagger == STAGGER::None and direction != DIRECTION::YOrthogonal) {
+      standardLines<direction, nGuards>(var, result, region);
+      return;
+    }
+
     BOUT_FOR(i, var.getRegion(region)) {
       result[i] = apply(populateStencil<direction, stagger, nGuards>(var, i));
     }
     return;
   }
 
+  /// Apply the derivative to each of \p vars, putting the results in
+  /// the corresponding element of \p results. Unstaggered derivatives
+  /// are calculated for all the fields in one pass over \p region,
+  /// so each block of the region is only set up once and stays in
+  /// cache while it is used by every field
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standardMany(const std::vector<std::reference_wrapper<const T>>& vars,
+                    std::vector<T>& results, const std::string& region) const {
+    AUTO_TRACE();
+    ASSERT2(meta.derivType == DERIV::Standard || meta.derivType == DERIV::StandardSecond
+            || meta.derivType == DERIV::StandardFourth)
+    ASSERT2(vars.size() == results.size());
+
+    if (vars.empty()) {
+      return;
+    }
+    ASSERT2(vars.front().get().getMesh()->getNguard(direction) >= nGuards);
+
+    if (stagger == STAGGER::None and direction != DIRECTION::YOrthogonal) {
+      std::vector<const BoutReal*> in;
+      std::vector<BoutReal*> out;
+      for (std::size_t k = 0; k < vars.size(); ++k) {
+        in.push_back(&vars[k].get()(0, 0, 0));
+        out.push_back(&results[k](0, 0, 0));
+      }
+
+      forEachLine<direction, nGuards>(
+          vars.front().get(), region, in,
+          [&](std::size_t k, const stencil& s, int i) { out[k][i] = apply(s); });
+      return;
+    }
+
+    for (std::size_t k = 0; k < vars.size(); ++k) {
+      standard<direction, stagger, nGuards>(vars[k].get(), results[k], region);
+    }
+  }
+
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
   void upwindOrFlux(const T& vel, const T& var, T& result, const std::string& region) const {
     AUTO_TRACE();
@@ -106,6 +151,8 @@ public:
         result[i] = apply(populateStencil<direction, stagger, nGuards>(vel, i),
                           populateStencil<direction, STAGGER::None, nGuards>(var, i));
       }
+    } else if (direction != DIRECTION::YOrthogonal) {
+      upwindLines<direction, nGuards>(vel, var, result, region);
     } else {
       BOUT_FOR(i, var.getRegion(region)) {
         result[i] =
@@ -121,6 +168,126 @@ public:
 
   const FF func{};
   const metaData meta = func.meta;
+
+private:
+  /// Line-based versions of standard and upwindOrFlux, for
+  /// unstaggered derivatives in X, Y or Z
+  ///
+  /// Rather than finding the neighbours of each point through the
+  /// index classes, these work on each contiguous block of the
+  /// region with raw pointers. In X and Y the neighbours of a block
+  /// are themselves contiguous, at a constant offset in memory, so
+  /// the inner loop loads whole neighbouring Z-lines and can be
+  /// vectorised. In Z only the points within nGuards of the ends of
+  /// each line need to wrap around periodically
+  template <DIRECTION direction, int nGuards, typename T>
+  void standardLines(const T& var, T& result, const std::string& region) const {
+    BoutReal* out = &result(0, 0, 0);
+
+    forEachLine<direction, nGuards>(
+        var, region, {&var(0, 0, 0)},
+        [&](std::size_t, const stencil& s, int i) { out[i] = apply(s); });
+  }
+
+  template <DIRECTION direction, int nGuards, typename T>
+  void upwindLines(const T& vel, const T& var, T& result,
+                   const std::string& region) const {
+    const BoutReal* v = &vel(0, 0, 0);
+    BoutReal* out = &result(0, 0, 0);
+
+    forEachLine<direction, nGuards>(
+        var, region, {&var(0, 0, 0)},
+        [&](std::size_t, const stencil& s, int i) { out[i] = apply(v[i], s); });
+  }
+
+  /// Call \p kernel with the index of the field, the stencil in
+  /// \p direction and the flat index, for every point in \p region of
+  /// each of \p fields. These point to the data of fields with the
+  /// same shape as \p var. All the fields are done for each block of
+  /// the region before moving on to the next
+  template <DIRECTION direction, int nGuards, typename T, typename Kernel>
+  static void forEachLine(const T& var, const std::string& region,
+                          const std::vector<const BoutReal*>& fields,
+                          const Kernel& kernel) {
+    static_assert(nGuards == 1 || nGuards == 2,
+                  "forEachLine currently only supports one or two guard cells");
+
+    const auto& reg = var.getRegion(region);
+    const std::size_t nfields = fields.size();
+    // Field2D has no Z dimension, so its Z-lines have one point
+    const int nz = std::is_same<typename T::ind_type, Ind2D>::value ? 1 : var.getNz();
+
+    if (direction != DIRECTION::Z) {
+      const int stride = (direction == DIRECTION::X) ? var.getNy() * nz : nz;
+
+      BOUT_FOR_BLOCKS(first, last, reg) {
+        for (std::size_t k = 0; k < nfields; ++k) {
+          const BoutReal* f = fields[k];
+          BOUT_OMP(simd)
+          for (int i = first; i < last; ++i) {
+            kernel(k, stencilAt<nGuards>(f, i, stride), i);
+          }
+        }
+      }
+      return;
+    }
+
+    BOUT_FOR_BLOCKS(first, last, reg) {
+      for (std::size_t k = 0; k < nfields; ++k) {
+        const BoutReal* f = fields[k];
+        // Split the block into pieces in a single Z-line
+        for (int i = first; i < last;) {
+          const int line_start = (i / nz) * nz;
+          const int line_end = std::min(last, line_start + nz);
+          // Points whose stencil doesn't wrap around the line
+          const int inner_start = std::min(line_end, std::max(i, line_start + nGuards));
+          const int inner_end =
+              std::max(inner_start, std::min(line_end, line_start + nz - nGuards));
+
+          for (; i < inner_start; ++i) {
+            kernel(k, stencilWrapped<nGuards>(f, line_start, i - line_start, nz), i);
+          }
+          BOUT_OMP(simd)
+          for (int j = inner_start; j < inner_end; ++j) {
+            kernel(k, stencilAt<nGuards>(f, j, 1), j);
+          }
+          for (i = inner_end; i < line_end; ++i) {
+            kernel(k, stencilWrapped<nGuards>(f, line_start, i - line_start, nz), i);
+          }
+        }
+      }
+    }
+  }
+
+  /// Stencil around flat index \p i, with neighbours \p stride apart
+  template <int nGuards>
+  static stencil stencilAt(const BoutReal* f, int i, int stride) {
+    stencil s;
+    if (nGuards == 2) {
+      s.mm = f[i - 2 * stride];
+      s.pp = f[i + 2 * stride];
+    }
+    s.m = f[i - stride];
+    s.c = f[i];
+    s.p = f[i + stride];
+    return s;
+  }
+
+  /// Stencil around point \p z of the periodic Z-line starting at
+  /// \p line_start
+  template <int nGuards>
+  static stencil stencilWrapped(const BoutReal* f, int line_start, int z, int nz) {
+    const auto at = [&](int dz) { return f[line_start + (z + dz + 2 * nz) % nz]; };
+    stencil s;
+    if (nGuards == 2) {
+      s.mm = at(-2);
+      s.pp = at(2);
+    }
+    s.m = at(-1);
+    s.c = f[line_start + z];
+    s.p = at(1);
+    return s;
+  }
 };
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -162,6 +329,12 @@ struct registerMethod {
             // for input field, output field, region
             method, _1, _2, _3);
         derivativeRegister.registerDerivative(theFunc, Direction{}, Stagger{}, method);
+        const auto theManyFunc = std::bind(
+            &Method::template standardMany<Direction::value, Stagger::value, 1,
+                                           FieldType>,
+            method, _1, _2, _3);
+        derivativeRegister.registerDerivativeMany(theManyFunc, Direction{}, Stagger{},
+                                                  method);
       } else {
         const auto theFunc = std::bind(
             // Method to store in function
@@ -170,6 +343,12 @@ struct registerMethod {
             // for input field, output field, region
             method, _1, _2, _3);
         derivativeRegister.registerDerivative(theFunc, Direction{}, Stagger{}, method);
+        const auto theManyFunc = std::bind(
+            &Method::template standardMany<Direction::value, Stagger::value, 2,
+                                           FieldType>,
+            method, _1, _2, _3);
+        derivativeRegister.registerDerivativeMany(theManyFunc, Direction{}, Stagger{},
+                                                  method);
       }
       break;
     }
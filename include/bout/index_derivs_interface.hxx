@@ -29,6 +29,10 @@
 #ifndef __INDEX_DERIVS_INTERFACE_HXX__
 #define __INDEX_DERIVS_INTERFACE_HXX__
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include <bout/deriv_store.hxx>
 #include <bout_types.hxx>
 #include <msg_stack.hxx>
@@ -100,7 +104,7 @@ T flowDerivative(const T& vel, const T& f, CELL_LOC outloc, const std::string& m
   // Check the result is valid
   {
     TRACE("Checking result");
-    checkData(result);
+    checkData(result, region);
   }
 
   return result;
@@ -162,7 +166,97 @@ T standardDerivative(const T& f, CELL_LOC outloc, const std::string& method,
   // Check the result is valid
   {
     TRACE("Checking result");
-    checkData(result);
+    checkData(result, region);
+  }
+
+  return result;
+}
+
+/// Batched version of standardDerivative, which calculates the
+/// derivative of each of \p fs, returning the results in the same
+/// order. The inputs are references rather than copies, so that any
+/// parallel slices are kept. All of \p fs must be on the same mesh
+/// and at the same location. The checks and lookup of the method are only done once,
+/// and methods which support it calculate all the derivatives in a
+/// single pass over \p region
+template <typename T, DIRECTION direction, DERIV derivType>
+std::vector<T> standardDerivative(const std::vector<std::reference_wrapper<const T>>& fs,
+                                  CELL_LOC outloc, const std::string& method,
+                                  const std::string& region) {
+  AUTO_TRACE();
+
+  // Checks
+  static_assert(bout::utils::is_Field2D<T>::value || bout::utils::is_Field3D<T>::value,
+                "standardDerivative only works on Field2D or Field3D input");
+
+  static_assert(derivType == DERIV::Standard || derivType == DERIV::StandardSecond
+                    || derivType == DERIV::StandardFourth,
+                "standardDerivative only works for derivType in {Standard, "
+                "StandardSecond, StandardFourth}");
+
+  std::vector<T> result;
+  if (fs.empty()) {
+    return result;
+  }
+  result.reserve(fs.size());
+
+  auto* localmesh = fs.front().get().getMesh();
+  const CELL_LOC inloc = fs.front().get().getLocation(); // Input location
+
+  // Check the input data is valid
+  {
+    TRACE("Checking inputs");
+    for (const T& f : fs) {
+      // Check that the mesh is correct
+      ASSERT1(f.getMesh() == localmesh);
+      // Check that the input variable has data
+      ASSERT1(f.isAllocated());
+      if (f.getLocation() != inloc) {
+        throw BoutException("standardDerivative: all fields must be at the same "
+                            "location, but got %s and %s",
+                            toString(inloc).c_str(), toString(f.getLocation()).c_str());
+      }
+      checkData(f);
+    }
+  }
+
+  // Define properties of this approach
+  const CELL_LOC allowedStaggerLoc = localmesh->getAllowedStaggerLoc(direction);
+
+  // Handle the staggering
+  if (outloc == CELL_DEFAULT) {
+    outloc = inloc;
+  }
+  const STAGGER stagger = localmesh->getStagger(inloc, outloc, allowedStaggerLoc);
+
+  // Check for early exit
+  const int nPoint = localmesh->getNpoints(direction);
+
+  if (nPoint == 1) {
+    for (const T& f : fs) {
+      result.push_back(zeroFrom(f).setLocation(outloc));
+    }
+    return result;
+  }
+
+  // Lookup the method
+  auto derivativeMethod = DerivativeStore<T>::getInstance().getStandardDerivativeMany(
+      method, direction, stagger, derivType);
+
+  // Create the result fields
+  for (const T& f : fs) {
+    result.push_back(emptyFrom(f).setLocation(outloc));
+  }
+
+  // Apply method
+  derivativeMethod(fs, result, region);
+
+  // Check the result is valid
+  {
+    TRACE("Checking result");
+    for (const auto& r : result) {
+      checkData(r, region);
+    }
   }
 
   return result;
@@ -178,6 +272,15 @@ T DDX(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "D
   return standardDerivative<T, DIRECTION::X, DERIV::Standard>(f, outloc, method, region);
 }
 
+/// Calculate DDX of each of \p fs, in a single pass where possible
+template <typename T>
+std::vector<T> DDX(const std::vector<std::reference_wrapper<const T>>& fs,
+                   CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
+                   const std::string& region = "RGN_NOBNDRY") {
+  AUTO_TRACE();
+  return standardDerivative<T, DIRECTION::X, DERIV::Standard>(fs, outloc, method, region);
+}
+
 template <typename T>
 T D2DX2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
         const std::string& region = "RGN_NOBNDRY") {
@@ -213,6 +316,43 @@ T DDY(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "D
   }
 }
 
+/// Calculate DDY of each of \p fs, in a single pass where possible
+template <typename T>
+std::vector<T> DDY(const std::vector<std::reference_wrapper<const T>>& fs,
+                   CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
+                   const std::string& region = "RGN_NOBNDRY") {
+  AUTO_TRACE();
+  const bool any_parallel_slices = std::any_of(
+      fs.begin(), fs.end(), [](const T& f) { return f.hasParallelSlices(); });
+  if (any_parallel_slices) {
+    // Fields with parallel slices use their own neighbours, so do
+    // each field separately. Note: qualified, so that ADL doesn't
+    // find the DDY in derivs.hxx, which also divides by dy
+    std::vector<T> result;
+    for (const T& f : fs) {
+      result.push_back(bout::derivatives::index::DDY(f, outloc, method, region));
+    }
+    return result;
+  }
+
+  std::vector<T> fs_aligned;
+  std::vector<bool> is_unaligned;
+  for (const T& f : fs) {
+    is_unaligned.push_back(f.getDirectionY() == YDirectionType::Standard);
+    fs_aligned.push_back(is_unaligned.back() ? toFieldAligned(f, "RGN_NOX") : f);
+  }
+  const std::vector<std::reference_wrapper<const T>> fs_aligned_refs(fs_aligned.begin(),
+                                                                      fs_aligned.end());
+  std::vector<T> result = standardDerivative<T, DIRECTION::Y, DERIV::Standard>(
+      fs_aligned_refs, outloc, method, region);
+  for (std::size_t k = 0; k < result.size(); ++k) {
+    if (is_unaligned[k]) {
+      result[k] = fromFieldAligned(result[k], region);
+    }
+  }
+  return result;
+}
+
 template <typename T>
 T D2DY2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
         const std::string& region = "RGN_NOBNDRY") {
@@ -255,6 +395,15 @@ T DDZ(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "D
   return standardDerivative<T, DIRECTION::Z, DERIV::Standard>(f, outloc, method, region);
 }
 
+/// Calculate DDZ of each of \p fs, in a single pass where possible
+template <typename T>
+std::vector<T> DDZ(const std::vector<std::reference_wrapper<const T>>& fs,
+                   CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
+                   const std::string& region = "RGN_NOBNDRY") {
+  AUTO_TRACE();
+  return standardDerivative<T, DIRECTION::Z, DERIV::Standard>(fs, outloc, method, region);
+}
+
 template <typename T>
 T D2DZ2(const T& f, CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
         const std::string& region = "RGN_NOBNDRY") {
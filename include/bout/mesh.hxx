@@ -71,6 +71,7 @@ class Mesh;
 
 #include <bout/region.hxx>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <map>
@@ -78,6 +79,34 @@ class Mesh;
 /// Type used to return pointers to handles
 using comm_handle = void*;
 
+/// A reusable plan for exchanging the guard cells of a fixed group
+/// of fields, created by Mesh::createCommunicationPlan
+///
+/// The setup work (working out message sizes, allocating buffers,
+/// and in BoutMesh initialising persistent MPI requests) is done
+/// once when the plan is created, so communicating the same group
+/// repeatedly, for example in every call to the RHS function, only
+/// needs to pack, start and unpack the messages.
+///
+/// The plan holds pointers to the fields in the group, so they must
+/// outlive the plan
+class CommunicationPlan {
+public:
+  explicit CommunicationPlan(FieldGroup g) : group(std::move(g)) {}
+  virtual ~CommunicationPlan() = default;
+
+  /// Start exchanging guard cells. Must be followed by a call to wait()
+  virtual void start() = 0;
+  /// Wait for the communications started by start() to finish
+  virtual void wait() = 0;
+
+  /// The fields communicated by this plan
+  const FieldGroup& getFields() const { return group; }
+
+protected:
+  FieldGroup group;
+};
+
 class Mesh {
  public:
 
@@ -257,6 +286,42 @@ class Mesh {
   /// @param g  The group of fields to communicate. Guard cells will be modified
   void communicateXZ(FieldGroup &g);
 
+  /// Create a plan for communicating the fields in \p g many times
+  ///
+  /// The default implementation just calls send() and wait()
+  virtual std::unique_ptr<CommunicationPlan> createCommunicationPlan(FieldGroup& g);
+
+  /// Communicate the fields in \p plan. As with
+  /// communicate(FieldGroup&), this also calculates the parallel
+  /// slices of the 3D fields
+  void communicate(CommunicationPlan& plan);
+
+  /// Communicate a group of fields, overlapping the communication
+  /// with computation which doesn't need the guard cells
+  ///
+  /// \p compute is called twice with the name of a region: first
+  /// with "RGN_INTERIOR" while the guard cells are being exchanged,
+  /// then with "RGN_INTERIOR_EDGE" once the communication has
+  /// finished. Together these two regions cover RGN_NOBNDRY, and
+  /// stencils centred on points in RGN_INTERIOR don't reach into the
+  /// guard cells. For example:
+  ///
+  ///     Field3D result{emptyFrom(f)};
+  ///     mesh->communicateOverlapped(comms, [&](const std::string& region) {
+  ///       const Field3D dfdx = DDX(f, CELL_DEFAULT, "DEFAULT", region);
+  ///       BOUT_FOR(i, result.getRegion(region)) { result[i] = g[i] * dfdx[i]; }
+  ///     });
+  ///
+  /// As with communicate(FieldGroup&), parallel slices are only
+  /// calculated after the communication has finished, so \p compute
+  /// must not use the yup/ydown fields of \p g when called with
+  /// "RGN_INTERIOR"
+  ///
+  /// @param g  The group of fields to communicate. Guard cells will be modified
+  /// @param compute  Function to call with the name of each region in turn
+  void communicateOverlapped(FieldGroup &g,
+                             const std::function<void(const std::string&)>& compute);
+
   /*!
    * Communicate an X-Z field
    */
@@ -58,6 +58,17 @@ public:
   const FieldPerp toFieldAligned(const FieldPerp &f, REGION region) {
     return toFieldAligned(f, toString(region));
   }
+
+  /// Convert \p f into field-aligned coordinates, writing the values
+  /// at the points in \p region straight into \p out rather than
+  /// into a new field. \p out must have room for all the points of
+  /// \p f, in the same order. This avoids allocating a temporary
+  /// field, for example when writing output
+  virtual void calcFieldAligned(const Field3D& f, BoutReal* out,
+                                const std::string& region = "RGN_ALL") {
+    const Field3D aligned = toFieldAligned(f, region);
+    BOUT_FOR(i, aligned.getRegion(region)) { out[i.ind] = aligned[i]; }
+  }
   
   /// Convert back from field-aligned coordinates
   /// into standard form
@@ -182,6 +193,13 @@ public:
   const FieldPerp toFieldAligned(const FieldPerp& f,
                                  const std::string& region = "RGN_ALL") override;
 
+  /*!
+   * Shifts the Z-lines of \p f straight into \p out, one block of
+   * lines at a time, without allocating a temporary field
+   */
+  void calcFieldAligned(const Field3D& f, BoutReal* out,
+                        const std::string& region = "RGN_ALL") override;
+
   /*!
    * Converts a field back to X-Z orthogonal coordinates
    * from field aligned coordinates.
@@ -284,6 +302,12 @@ private:
   const Field3D shiftZ(const Field3D& f, const Tensor<dcomplex>& phs,
                        const YDirectionType y_direction_out,
                        const std::string& region = "RGN_NOX") const;
+  /*!
+   * As above, but writes the shifted values at the points in \p region
+   * into \p out, which must have room for all the points of \p f
+   */
+  void shiftZ(const Field3D& f, const Tensor<dcomplex>& phs, BoutReal* out,
+              const std::string& region = "RGN_NOX") const;
   const FieldPerp shiftZ(const FieldPerp& f, const Tensor<dcomplex>& phs,
                          const YDirectionType y_direction_out,
                          const std::string& region = "RGN_NOX") const;
@@ -308,6 +332,19 @@ private:
    */
   void shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const;
 
+  /*!
+   * Shift \p nlines contiguous 1D arrays, assumed to be in Z, using a
+   * single batched FFT
+   *
+   * @param[in] in  \p nlines contiguous 1D arrays of length mesh.LocalNz
+   * @param[in] phs \p nlines contiguous phase shifts, each of length
+   * (mesh.LocalNz/2 + 1)
+   * @param[in] nlines  Number of arrays to shift
+   * @param[out] out  \p nlines contiguous 1D arrays of length mesh.LocalNz,
+   * already allocated
+   */
+  void shiftZ(const BoutReal* in, const dcomplex* phs, int nlines, BoutReal* out) const;
+
   /// Calculate and store the phases for to/from field aligned and for
   /// the parallel slices using zShift
   void cachePhases();
@@ -43,6 +43,7 @@ class PhysicsModel;
 #include "solver.hxx"
 #include "unused.hxx"
 #include "utils.hxx"
+#include "bout/diagnostics.hxx"
 #include "bout/macro_for_each.hxx"
 
 /*!
@@ -245,6 +246,10 @@ protected:
   /// Stores the state for restarting
   Datafile restart; 
 
+  /// Stores the changes to the state since the last full restart
+  /// file, if restart:full_period is greater than one
+  Datafile restart_deltas;
+
   /*!
    * Specify a constrained variable \p var, which will be
    * adjusted to make \p F_var equal to zero.
@@ -265,8 +270,8 @@ protected:
     PhysicsModelMonitor() = delete;
     PhysicsModelMonitor(PhysicsModel *model) : model(model) {}
     int call(Solver* UNUSED(solver), BoutReal simtime, int iter, int nout) override {
-      // Save state to restart file
-      model->restart.write();
+      // Save state to restart files
+      model->writeCheckpoint(iter, nout);
       // Call user output monitor
       return model->outputMonitor(simtime, iter, nout);
     }
@@ -277,6 +282,11 @@ protected:
 
   /// write restarts and pass outputMonitor method inside a Monitor subclass
   PhysicsModelMonitor modelMonitor;
+
+  /// Reductions of fields written to the output file, set in the
+  /// [diagnostics] section of the input. Evolving Field3Ds are added
+  /// by bout_solve; other fields can be added in init()
+  bout::Diagnostics diagnostics;
 private:
   /// Split operator model?
   bool splitop{false};
@@ -286,6 +296,19 @@ private:
   jacobianfunc userjacobian{nullptr};
   /// True if model already initialised
   bool initialised{false};
+
+  /// Number of outputs between writing restart files
+  int checkpoint_period{1};
+  /// Number of checkpoints between full restart files. In between,
+  /// only restart_deltas is written
+  int full_checkpoint_period{1};
+  /// Number of checkpoints written
+  int checkpoint_count{0};
+
+  /// Write a checkpoint after output \p iter of \p nout, if one is
+  /// due: either the full restart file, or the deltas since the last
+  /// full one
+  void writeCheckpoint(int iter, int nout);
 };
 
 /*!
@@ -129,6 +129,61 @@
 #define BOUT_FOR_INNER(index, region)                                                    \
   BOUT_FOR_OMP(index, region, for schedule(OPENMP_SCHEDULE) nowait)
 
+/// Helper macros for iterating over the contiguous blocks of a
+/// Region as ranges of plain integers
+///
+/// @param[in] first  Name of the variable holding the first index of
+///                   each block
+/// @param[in] last   Name of the variable holding one past the last
+///                   index of each block
+/// @param[in] region An already existing Region
+///
+/// Unlike BOUT_FOR, the body is run once per block rather than once
+/// per index, and can loop over `[first, last)` using raw pointers
+/// to the field data. Such loops are simple enough for the compiler
+/// to vectorise, which it often fails to do through the index
+/// classes:
+///
+///     const BoutReal* a_data = &a(0, 0, 0);
+///     BoutReal* result_data = &result(0, 0, 0);
+///     BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+///       BOUT_OMP(simd)
+///       for (int i = first; i < last; ++i) {
+///         result_data[i] = 2. * a_data[i];
+///       }
+///     }
+///
+/// Every block contains between 1 and MAXREGIONBLOCKSIZE consecutive
+/// indices. Field data allocated through Array is aligned to
+/// bout::ArrayAllocator::alignment bytes, which can be passed on to
+/// the compiler with bout::assumeAligned; the start of each block
+/// need not be aligned.
+///
+/// As with BOUT_FOR, there are SERIAL, OMP and INNER variants
+#define BOUT_FOR_BLOCKS_SERIAL(first, last, region)                                      \
+  for (auto block = region.getBlocks().cbegin(), end = region.getBlocks().cend();        \
+       block < end; ++block)                                                             \
+    for (int first = block->first.ind, last = block->second.ind; first < last;           \
+         first = last)
+
+#ifdef _OPENMP
+#define BOUT_FOR_BLOCKS_OMP(first, last, region, omp_pragmas)                            \
+  BOUT_OMP(omp_pragmas)                                                                  \
+  for (auto block = region.getBlocks().cbegin(); block < region.getBlocks().cend();      \
+       ++block)                                                                          \
+    for (int first = block->first.ind, last = block->second.ind; first < last;           \
+         first = last)
+#else
+#define BOUT_FOR_BLOCKS_OMP(first, last, region, omp_pragmas)                            \
+  BOUT_FOR_BLOCKS_SERIAL(first, last, region)
+#endif
+
+#define BOUT_FOR_BLOCKS(first, last, region)                                             \
+  BOUT_FOR_BLOCKS_OMP(first, last, region, parallel for schedule(OPENMP_SCHEDULE))
+
+#define BOUT_FOR_BLOCKS_INNER(first, last, region)                                       \
+  BOUT_FOR_BLOCKS_OMP(first, last, region, for schedule(OPENMP_SCHEDULE) nowait)
+
 
 enum class IND_TYPE { IND_3D = 0, IND_2D = 1, IND_PERP = 2 };
 
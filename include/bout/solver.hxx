@@ -91,7 +91,7 @@ constexpr auto SOLVERIMEXBDF2 = "imexbdf2";
 constexpr auto SOLVERSNES = "snes";
 constexpr auto SOLVERRKGENERIC = "rkgeneric";
 
-enum class SOLVER_VAR_OP {LOAD_VARS, LOAD_DERIVS, SET_ID, SAVE_VARS, SAVE_DERIVS};
+enum class SOLVER_VAR_OP {LOAD_VARS, LOAD_DERIVS, SET_ID, SAVE_VARS, SAVE_DERIVS, SET_SLOW};
 
 /// A type to set where in the list monitors are added
 enum class MonitorPosition {BACK, FRONT};
@@ -295,6 +295,13 @@ public:
   /// Test if this solver supports split operators (e.g. implicit/explicit)
   bool splitOperator() { return split_operator; }
 
+  /// Are the time derivatives of the slow variables needed by this
+  /// call to the RHS? Multirate solvers only use the derivatives of
+  /// the fast variables between slow steps, so the RHS can skip
+  /// calculating the others. Variables are slow if their "slow"
+  /// option is set
+  bool slowDerivsNeeded() const { return slow_derivs_needed; }
+
   bool canReset{false};
 
   /// Add evolving variables to output (dump) file or restart file
@@ -303,6 +310,31 @@ public:
   /// @param[in] save_repeat    If true, add variables with time dimension
   virtual void outputVars(Datafile& outputfile, bool save_repeat = true);
 
+  /// Add variables to \p outputfile which store the evolving
+  /// variables as lossless deltas from a base checkpoint: the bitwise
+  /// XOR of each variable with its value at the last
+  /// setDeltaBase(). Most of the bits of slowly changing variables
+  /// are then zero, so these compress well. The time and iteration
+  /// are also added, along with the iteration of the base
+  void outputDeltas(Datafile& outputfile);
+  /// Make the current values of the evolving variables the base for
+  /// later deltas
+  void setDeltaBase();
+  /// Calculate the deltas of the evolving variables from the base.
+  /// They are marked as incomplete until markDeltasComplete()
+  void calculateDeltas();
+  /// Mark the deltas as complete. This should be written to the file
+  /// (as "complete_hist_hi") only after all the deltas have been, so
+  /// that a partly written file is not used
+  void markDeltasComplete();
+  /// Were the deltas read into the file set up by outputDeltas
+  /// completely written, and calculated from the current state? This
+  /// should be the base checkpoint, read from the restart file
+  bool deltasMatchState() const;
+  /// Set the evolving variables, time and iteration from the deltas,
+  /// which must match the current state
+  void applyDeltas();
+
   /// Create a Solver object. This uses the "type" option in the given
   /// Option section to determine which solver type to create.
   static Solver* create(Options* opts = nullptr);
@@ -346,6 +378,7 @@ protected:
     CELL_LOC location{CELL_DEFAULT};     /// For fields and vector components
     bool covariant{false};               /// For vectors
     bool evolve_bndry{false};            /// Are the boundary regions being evolved?
+    bool slow{false};                    /// Evolved with the slow timestep if multirate?
     std::string name;                    /// Name of the variable
   };
 
@@ -428,10 +461,21 @@ protected:
   void save_vars(BoutReal* udata);
   void save_derivs(BoutReal* dudata);
   void set_id(BoutReal* udata);
+  /// Set \p udata to 1 for the slow variables, and 0 for the others
+  void set_slow(BoutReal* udata);
+
+  /// Are the slow variables' time derivatives needed by the next RHS
+  /// call? Set by multirate solvers
+  bool slow_derivs_needed{true};
 
-  /// Returns a Field3D containing the global indices
+  /// Returns a Field3D containing the global indices. Only
+  /// available if the variables are interleaved (not field_major)
   Field3D globalIndex(int localStart);
 
+  /// Is each variable stored contiguously in the state vector,
+  /// rather than the variables being interleaved at each point?
+  bool field_major{false};
+
   /// Maximum internal timestep
   BoutReal max_dt{-1.0};
 
@@ -475,6 +519,21 @@ private:
   void add_mms_sources(BoutReal t);
   void calculate_mms_error(BoutReal t);
 
+  /// Values of the evolving variables at the last setDeltaBase()
+  std::vector<Field2D> base2d;
+  std::vector<Field3D> base3d;
+  /// Iteration at the last setDeltaBase()
+  int base_iteration{-1};
+  /// Differences of f2d and f3d from the base, in the same order
+  std::vector<Field2D> delta2d;
+  std::vector<Field3D> delta3d;
+  /// Time, iteration, and base iteration of the deltas
+  BoutReal delta_simtime{0.0};
+  int delta_iteration{0};
+  int delta_base_iteration{-1};
+  /// Iteration of the deltas once they are complete, or -1
+  int delta_complete_iteration{-1};
+
   /// List of monitor functions
   std::list<Monitor*> monitors;
   /// List of timestep monitor functions
@@ -486,8 +545,12 @@ private:
   void post_rhs(BoutReal t);
 
   /// Loading data from BOUT++ to/from solver
-  void loop_vars_op(Ind2D i2d, BoutReal* udata, int& p, SOLVER_VAR_OP op, bool bndry);
+  void loop_vars_op(Ind2D i2d, BoutReal* udata, int p, int n3d, SOLVER_VAR_OP op,
+                    bool bndry);
   void loop_vars(BoutReal* udata, SOLVER_VAR_OP op);
+  /// Loading data for the field-major layout, one variable at a time
+  template <class T>
+  void loop_vars_field(VarStr<T>& f, BoutReal* udata, int& p, SOLVER_VAR_OP op);
 
   /// Check if a variable has already been added
   bool varAdded(const std::string& name);
@@ -0,0 +1,72 @@
+/**************************************************************************
+ * \file solver_kernels.hxx
+ *
+ * \brief Fused operations on solver state vectors
+ *
+ * The explicit solvers combine their stages with loops over the whole
+ * state vector. Doing each term of a combination as a separate loop
+ * reads and writes the result once per term, so these kernels instead
+ * combine all the terms in a single pass: the vectors are processed in
+ * short blocks which stay in cache while every term is added. The
+ * blocks are shared between OpenMP threads, and the loop within each
+ * block is vectorised.
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef __SOLVER_KERNELS_H__
+#define __SOLVER_KERNELS_H__
+
+#include "boutcomm.hxx"
+#include "bout_types.hxx"
+
+#include <vector>
+
+namespace bout {
+namespace solver {
+
+/// Set \p result to the linear combination of \p vectors
+///
+///     result[i] = sum_j coefficients[j] * vectors[j][i]
+///
+/// for i in [0, \p n). \p result may be the same as any of \p vectors
+void linearCombination(int n, const std::vector<BoutReal>& coefficients,
+                       const std::vector<const BoutReal*>& vectors, BoutReal* result);
+
+/// Add several scaled vectors to \p x
+///
+///     result[i] = x[i] + sum_j coefficients[j] * vectors[j][i]
+///
+/// \p result may be the same as \p x or any of \p vectors
+void multiAxpy(int n, const BoutReal* x, const std::vector<BoutReal>& coefficients,
+               const std::vector<const BoutReal*>& vectors, BoutReal* result);
+
+/// The mean, over all \p neq values on all processors in \p comm, of
+/// the relative difference between two solutions
+///
+///     |a[i] - b[i]| / (|a[i]| + |b[i]| + atol)
+///
+/// as used to adapt the timestep. \p n is the number of values on
+/// this processor. Collective over \p comm
+BoutReal meanRelativeError(int n, const BoutReal* a, const BoutReal* b, BoutReal atol,
+                           int neq, MPI_Comm comm = BoutComm::get());
+
+} // namespace solver
+} // namespace bout
+
+#endif // __SOLVER_KERNELS_H__
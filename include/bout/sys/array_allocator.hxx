@@ -0,0 +1,140 @@
+/*!************************************************************************
+ * \file array_allocator.hxx
+ *
+ * Pool of aligned memory blocks used by Array
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef __ARRAY_ALLOCATOR_H__
+#define __ARRAY_ALLOCATOR_H__
+
+#include <cstddef>
+
+namespace bout {
+
+/*!
+ * Thread-safe pool of aligned memory blocks
+ *
+ * This provides the memory for the default Array backing
+ * (ArrayData). Rather than returning freed blocks to the system,
+ * they are kept and handed out again by later requests:
+ *
+ *     void* p = ArrayAllocator::allocate(1000);  // Miss: new memory
+ *     ArrayAllocator::deallocate(p, 1000);       // Kept in the pool
+ *     void* q = ArrayAllocator::allocate(990);   // Hit: q == p
+ *
+ * Requests are rounded up to a size class: multiples of 64 bytes
+ * up to 1 KiB, then four classes for each power of two, so at most
+ * a quarter of a block is unused. Blocks of any size within a class
+ * can therefore be reused for each other.
+ *
+ * Each thread keeps a small cache of free blocks for each size
+ * class, which can be used without locking. When that is full,
+ * blocks go to a pool shared by all threads, so memory freed on one
+ * thread can be reused on any other.
+ *
+ * All blocks are aligned to at least `alignment` bytes, suitable
+ * for aligned SIMD loads and stores. Optionally, blocks larger than
+ * `huge_page_size` are aligned to that size and the system asked
+ * to back them with huge pages.
+ */
+class ArrayAllocator {
+public:
+  /// Minimum alignment of all blocks, in bytes
+  static constexpr std::size_t alignment = 64;
+
+  /// Size of a huge page, in bytes
+  static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+  /// Maximum number of free blocks of each size class kept by
+  /// each thread before they go to the shared pool
+  static constexpr std::size_t thread_cache_blocks = 4;
+
+  /// Counters describing the use of the pool
+  struct Statistics {
+    /// Number of allocations reusing a free block
+    std::size_t hits{0};
+    /// Number of allocations which needed new memory from the system
+    std::size_t misses{0};
+    /// Number of freed blocks returned to the system, because the
+    /// pool was full or disabled
+    std::size_t discards{0};
+    /// Number of bytes in free blocks kept for reuse
+    std::size_t bytes_held{0};
+    /// Number of bytes in blocks currently allocated
+    std::size_t bytes_in_use{0};
+    /// Largest value of bytes_in_use since the last resetStatistics()
+    std::size_t peak_bytes_in_use{0};
+  };
+
+  /// Get a block of at least \p bytes bytes. Returns nullptr if
+  /// \p bytes is zero. Throws std::bad_alloc on failure
+  static void* allocate(std::size_t bytes);
+
+  /// Return a block previously obtained from allocate(\p bytes)
+  static void deallocate(void* ptr, std::size_t bytes) noexcept;
+
+  /// The number of bytes actually used for a request of \p bytes
+  static std::size_t sizeClass(std::size_t bytes);
+
+  /// Get the current counters
+  static Statistics getStatistics();
+
+  /// Set the counters of hits, misses and discards to zero, and the
+  /// peak bytes in use to the current value
+  static void resetStatistics();
+
+  /// Limit the number of bytes kept in free blocks. Blocks freed
+  /// when this limit has been reached are returned to the system.
+  /// Default is no limit
+  static void setMaxBytesHeld(std::size_t max_bytes);
+
+  /// Use huge pages for blocks of at least `huge_page_size` bytes.
+  /// Only has an effect on Linux
+  static void setUseHugePages(bool use_huge_pages);
+
+  /// Is the pool being used? If not, all blocks are returned to the
+  /// system as soon as they are freed
+  static bool isEnabled();
+
+  /// Stop using the pool, returning any free blocks held by the
+  /// shared pool and this thread to the system.
+  ///
+  /// Note: the pool can't be re-enabled, and blocks held by other
+  /// threads are only released when those threads exit
+  static void cleanup();
+};
+
+/// Tell the compiler that \p ptr is aligned to
+/// ArrayAllocator::alignment bytes, so that loops using it can be
+/// vectorised without checking. \p ptr must point to the start of a
+/// block from ArrayAllocator, for example the first element of an
+/// Array, or be nullptr
+template <typename T>
+inline T* assumeAligned(T* ptr) {
+#if defined(__GNUC__)
+  return static_cast<T*>(__builtin_assume_aligned(ptr, ArrayAllocator::alignment));
+#else
+  return ptr;
+#endif
+}
+
+} // namespace bout
+
+#endif // __ARRAY_ALLOCATOR_H__
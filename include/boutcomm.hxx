@@ -49,11 +49,25 @@ public:
   static int rank(); ///< Rank: my processor number
   static int size(); ///< Size: number of processors
 
+  /// Communicator between processors which solve the same part of the
+  /// domain at different times. This is MPI_COMM_SELF unless
+  /// splitTime() has been called
+  static MPI_Comm getTime();
+  static int timeRank(); ///< Which time slice this processor solves
+  static int timeSize(); ///< Number of time slices
+
   // Setting options
   void setComm(MPI_Comm c);
 
+  /// Split the processors into \p nslices groups, each of which
+  /// solves the whole domain for a different slice in time. After
+  /// this, get() is the communicator within a group. The number of
+  /// processors must be divisible by \p nslices
+  void splitTime(int nslices);
+
   // Getters
   MPI_Comm getComm();
+  MPI_Comm getTimeComm();
   bool isSet();
 
  private:
@@ -64,6 +78,7 @@ public:
                           ///< so pointers are used
   bool hasBeenSet{false};
   MPI_Comm comm;
+  MPI_Comm time_comm; ///< Between time slices, if split
   
   static BoutComm* instance; ///< The only instance of this class (Singleton)
 
@@ -15,6 +15,7 @@ class Datafile;
 #define __DATAFILE_H__
 
 #include "bout_types.hxx"
+#include "bout/array.hxx"
 #include "bout/macro_for_each.hxx"
 
 #include "dataformat.hxx"
@@ -60,6 +61,9 @@ class Datafile {
   void close();
 
   void setLowPrecision(); ///< Only output floats
+  /// Read files written with a different processor layout. All
+  /// processors must then read the file together
+  void setRepartition(bool repartition_in = true) { repartition = repartition_in; }
   template <typename T>
   void addRepeat(T& value, std::string name) {
     add(value, name.c_str(), true);
@@ -79,6 +83,10 @@ class Datafile {
   
   bool read();  ///< Read data into added variables 
   bool write(); ///< Write added variables
+  /// Write only the added int or BoutReal \p name, after any
+  /// earlier writes have finished. This can mark that a write() has
+  /// been completed
+  bool writeVar(const std::string& name);
 
   /// Opens, writes, closes file
   bool write(const char* filename, ...) const BOUT_FORMAT_ARGS(2, 3);
@@ -90,7 +98,7 @@ class Datafile {
  private:
   Mesh* mesh;
   bool parallel{false}; // Use parallel formats?
-  bool flush{true};     // Flush after every write?
+  bool flush{true};     // Flush after every flushFrequency writes, if not openclose?
   bool guards{true};    // Write guard cells?
   bool floats{false};   // Low precision?
   bool openclose{true}; // Open and close file for each write
@@ -101,7 +109,10 @@ class Datafile {
   bool shiftInput{false};  // Read in shifted space?
   // Counter used in determining when next openclose required
   int flushFrequencyCounter{0};
-  int flushFrequency{1}; // How many write calls do we want between openclose
+  int flushFrequency{1}; // How many write calls between openclose or flush
+  bool async{false};    // Write in a background thread?
+  bool repartition{false}; // Read files from a different processor layout?
+  DataFormat::StorageSettings storage; // Chunking and compression
 
   std::unique_ptr<DataFormat> file;
   size_t filenamelen;
@@ -111,6 +122,19 @@ class Datafile {
   bool appending{false};
   bool first_time{true}; // is this the first time the data will be written?
 
+  /// Buffer for Field3Ds shifted to field-aligned coordinates before
+  /// writing, reused for every variable
+  Array<BoutReal> shift_buffer;
+
+  /// Copies of the variables for one output record, made so that
+  /// they can be written in the background while the simulation
+  /// continues
+  struct StagedRecord;
+  /// Staging buffers used when `async` is true: one record is
+  /// filled while the other is being written
+  struct AsyncBuffers;
+  std::unique_ptr<AsyncBuffers> async_buffers;
+
   /// Shallow copy, not including dataformat, therefore private
   Datafile(const Datafile& other);
 
@@ -144,6 +168,20 @@ class Datafile {
   bool write_f3d(const std::string &name, Field3D *f, bool save_repeat);
   bool write_fperp(const std::string &name, FieldPerp *f, bool save_repeat);
 
+  /// Copy the variables into a staging buffer, and hand it to the
+  /// background I/O thread to be written
+  bool writeAsync();
+  /// Copy the current values of all the variables into \p record
+  void stageVariables(StagedRecord& record);
+
+  /// Wait for any writes being done in the background to finish.
+  /// Throws if one of them failed
+  void waitForWrites();
+
+  /// Set the origin and sizes of the data read and written by each
+  /// processor, once the DataFormat has been created
+  void setOrigin();
+
   /// Check if a variable has already been added
   bool varAdded(const std::string &name);
 
@@ -36,6 +36,7 @@ class DataFormat;
 #include "bout_types.hxx"
 #include "unused.hxx"
 
+#include <cstddef>
 #include <string>
 #include <memory>
 #include <vector>
@@ -60,6 +61,18 @@ class DataFormat {
     return openw(name.c_str(), append);
   }
   virtual bool openw(const std::string &base, int mype, bool append=false);
+
+  /// Is this a single file shared by all processors? If so, the
+  /// versions of openr and openw taking a processor number use the
+  /// same file on every processor, and each processor reads and
+  /// writes its own part of the global arrays, set by
+  /// setLocalOrigin
+  virtual bool isParallel() const { return false; }
+
+  /// Must every processor in a group make the same reads and
+  /// queries, in the same order? If so, a processor which doesn't
+  /// need any of a variable must still read zero elements of it
+  virtual bool isCollective() const { return false; }
   
   virtual bool is_valid() = 0;
   
@@ -114,6 +127,41 @@ class DataFormat {
   
   virtual void setLowPrecision() { }  // By default doesn't do anything
 
+  /// How variables are laid out and compressed in the file. Formats
+  /// which don't support chunking or compression ignore these
+  struct StorageSettings {
+    /// Level of deflate compression, from 0 (none) to 9 (smallest)
+    int deflate_level{0};
+    /// Shuffle the bytes of each value before compressing? Usually
+    /// makes floating point data compress much better
+    bool shuffle{true};
+    /// Number of records in each chunk of time-dependent
+    /// variables. If 0, chosen from chunk_bytes
+    int chunk_records{0};
+    /// Target size of each chunk, in bytes
+    int chunk_bytes{1024 * 1024};
+    /// When writing floats (see setLowPrecision), round to this many
+    /// significant decimal digits so that the values compress better.
+    /// If 0, keep the full precision of a float
+    int significant_digits{0};
+  };
+
+  /// Set how variables added after this call are stored
+  void setStorageSettings(const StorageSettings& settings) { storage = settings; }
+  const StorageSettings& getStorageSettings() const { return storage; }
+
+  /// Choose the shape of the chunks for a variable with dimensions
+  /// \p dims, whose values are \p element_size bytes. If \p repeat,
+  /// the first dimension is time, and its size is ignored.
+  ///
+  /// Z-lines (the last dimension) are kept whole. Other dimensions
+  /// are halved, starting with the first, until a chunk holding one
+  /// record is no bigger than `chunk_bytes`. Time-dependent variables
+  /// then have `chunk_records` records per chunk, or as many as fit
+  /// in `chunk_bytes` (at least 1, at most 128)
+  std::vector<std::size_t> chunkShape(std::vector<std::size_t> dims, bool repeat,
+                                      std::size_t element_size) const;
+
   // Attributes
 
   /// Sets a string attribute
@@ -218,9 +266,32 @@ class DataFormat {
 
  protected:
   Mesh* mesh;
+
+  StorageSettings storage;
+
+  /// Convert \p size values to floats, clamped to the range of a
+  /// float and rounded to `significant_digits`. The result is in a
+  /// buffer owned by this DataFormat, which is valid until the next
+  /// call, so \p data itself is not changed
+  float* toFloat(const BoutReal* data, int size);
+
+ private:
+  std::vector<float> float_buffer;
 };
 
 // For backwards compatability. In formatfactory.cxx
 std::unique_ptr<DataFormat> data_format(const char *filename = nullptr);
 
+/// Read \p format on only one processor in each group of
+/// \p group_size processors (each node if 0), which sends the data
+/// to the others. In formatfactory.cxx
+std::unique_ptr<DataFormat> shared_read_format(std::unique_ptr<DataFormat> format,
+                                               int group_size = 0);
+
+/// Read per-processor files with \p format, even if they were written
+/// with a different processor layout than \p mesh. Opening them is
+/// collective. In formatfactory.cxx
+std::unique_ptr<DataFormat> repartition_format(std::unique_ptr<DataFormat> format,
+                                               Mesh* mesh = nullptr);
+
 #endif // __DATAFORMAT_H__
@@ -29,6 +29,9 @@
 #ifndef __DERIVS_H__
 #define __DERIVS_H__
 
+#include <functional>
+#include <vector>
+
 #include "field2d.hxx"
 #include "field3d.hxx"
 #include "vector2d.hxx"
@@ -206,6 +209,44 @@ Vector2D DDZ(const Vector2D& f, CELL_LOC outloc = CELL_DEFAULT, const std::strin
     method = "DEFAULT", const std::string& region = "RGN_NOBNDRY");
 DERIV_FUNC_REGION_ENUM_TO_STRING(DDZ, Vector2D)
 
+/// Calculate first partial derivative in X of several fields
+///
+/// Gives the same results as calling DDX on each of \p fs, but the
+/// stencils for all the fields are applied in one pass over the
+/// mesh, as is the division by dx, so each value of the metric is
+/// only loaded once. For example
+///
+///     auto ddx = DDX({n, T, phi});
+///
+/// @param[in] fs      The fields to be differentiated. These must all
+///                    be at the same cell location. They are passed by
+///                    reference, so can't be temporaries
+/// @param[in] outloc  The cell location where the result is desired. If
+///                    staggered grids is not enabled then this has no effect
+///                    If not given, defaults to CELL_DEFAULT
+/// @param[in] method  Differencing method to use. This overrides the default
+///                    If not given, defaults to DIFF_DEFAULT
+/// @param[in] region  What region is expected to be calculated
+///                    If not given, defaults to RGN_NOBNDRY
+/// @returns the derivative of each of \p fs, in the same order
+std::vector<Field3D> DDX(const std::vector<std::reference_wrapper<const Field3D>>& fs,
+    CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
+    const std::string& region = "RGN_NOBNDRY");
+
+/// Calculate first partial derivative in Y of several fields
+///
+/// Batched version of DDY, see DDX(const std::vector<Field3D>&, ...)
+std::vector<Field3D> DDY(const std::vector<std::reference_wrapper<const Field3D>>& fs,
+    CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
+    const std::string& region = "RGN_NOBNDRY");
+
+/// Calculate first partial derivative in Z of several fields
+///
+/// Batched version of DDZ, see DDX(const std::vector<Field3D>&, ...)
+std::vector<Field3D> DDZ(const std::vector<std::reference_wrapper<const Field3D>>& fs,
+    CELL_LOC outloc = CELL_DEFAULT, const std::string& method = "DEFAULT",
+    const std::string& region = "RGN_NOBNDRY");
+
 ////////// SECOND DERIVATIVES //////////
 
 /// Calculate second partial derivative in X
@@ -70,6 +70,42 @@ void rfft(const BoutReal *in, int length, dcomplex *out);
  */
 void irfft(const dcomplex *in, int length, BoutReal *out);
 
+/*!
+ * Batched version of rfft: transforms \p howmany contiguous real
+ * signals of \p length points with a single call to FFTW
+ *
+ * Signal `i` starts at `in + i * length`, and its (normalised)
+ * transform is written to `out + i * (length / 2 + 1)`. For example,
+ * all the Z-lines of a Field3D `f` can be transformed with
+ *
+ *     bout::fft::rfft_many(&f(0, 0, 0), nz, nx * ny, out);
+ *
+ * Plans are created with fftw_plan_many_dft_r2c and cached, so
+ * repeated calls with the same length and number of signals do not
+ * need to re-plan. This function is thread-safe.
+ *
+ * \param[in] in      Pointer to `howmany * length` real values
+ * \param[in] length  Number of points in each signal
+ * \param[in] howmany Number of signals to transform
+ * \param[out] out    Pointer to `howmany * (length / 2 + 1)` complex values
+ */
+void rfft_many(const BoutReal *in, int length, int howmany, dcomplex *out);
+
+/*!
+ * Batched version of irfft: inverse transforms \p howmany contiguous
+ * spectra into signals of \p length real points
+ *
+ * Spectrum `i` starts at `in + i * (length / 2 + 1)`, and its
+ * inverse transform is written to `out + i * length`. \p in is not
+ * modified. This function is thread-safe.
+ *
+ * \param[in] in      Pointer to `howmany * (length / 2 + 1)` complex values
+ * \param[in] length  Number of points in each output signal
+ * \param[in] howmany Number of signals to transform
+ * \param[out] out    Pointer to `howmany * length` real values
+ */
+void irfft_many(const dcomplex *in, int length, int howmany, BoutReal *out);
+
 /*!
  * Discrete Sine Transform
  *
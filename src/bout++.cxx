@@ -50,6 +50,7 @@ const char DEFAULT_DIR[] = "data";
 #include "bout/petsclib.hxx"
 #include "bout/slepclib.hxx"
 #include "bout/solver.hxx"
+#include "bout/sys/array_allocator.hxx"
 #include "bout/sys/timer.hxx"
 
 #define BOUT_NO_USING_NAMESPACE_BOUTGLOBALS
@@ -150,6 +151,10 @@ int BoutInitialise(int& argc, char**& argv) {
 
     setRunStartInfo(Options::root());
 
+    setupArrayAllocator(Options::root());
+
+    setupTimeSlices(Options::root());
+
     if (MYPE == 0) {
       writeSettingsFile(Options::root(), args.data_dir, args.set_file);
     }
@@ -516,6 +521,64 @@ void setRunFinishInfo(Options& options) {
   options["run"]["finished"].force(ctime(&end_time), "");
 }
 
+void setupArrayAllocator(Options& options) {
+  auto& memory = options["memory"];
+
+  const BoutReal max_held_mb =
+      memory["max_held_mb"]
+          .doc("Maximum memory (MiB) in freed arrays kept for reuse. Negative for no "
+               "limit")
+          .withDefault(-1.0);
+  if (max_held_mb >= 0.0) {
+    bout::ArrayAllocator::setMaxBytesHeld(
+        static_cast<std::size_t>(max_held_mb * 1024 * 1024));
+  }
+
+  bout::ArrayAllocator::setUseHugePages(
+      memory["huge_pages"]
+          .doc("Ask for huge pages to back large arrays (Linux only)")
+          .withDefault(false));
+}
+
+void setupTimeSlices(Options& options) {
+  const int time_slices =
+      options["solver"]["time_slices"]
+          .doc("Number of groups of processors which solve different slices in time. "
+               "Only used by the parareal solver")
+          .withDefault(1);
+  if (time_slices == 1) {
+    return;
+  }
+
+  // Other solvers would all solve the same times, and wouldn't
+  // communicate between the groups
+  if (not options["solver"].isSet("type")
+      or options["solver"]["type"].as<std::string>() != "parareal") {
+    throw BoutException(_("solver:time_slices is %d, but only the parareal solver can "
+                          "use more than one time slice. Set solver:type = parareal"),
+                        time_slices);
+  }
+
+  BoutComm::getInstance()->splitTime(time_slices);
+
+  if (BoutComm::timeRank() != 0) {
+    options["output"]["enabled"].force(false);
+    options["restart"]["enabled"].force(false);
+  }
+}
+
+void printArrayAllocatorStatistics() {
+  const auto stats = bout::ArrayAllocator::getStatistics();
+  constexpr BoutReal MiB = 1024 * 1024;
+
+  output_info.write(_("Array memory: %lu reused, %lu allocated, %lu released\n"),
+                    static_cast<unsigned long>(stats.hits),
+                    static_cast<unsigned long>(stats.misses),
+                    static_cast<unsigned long>(stats.discards));
+  output_info.write(_("Array memory: peak %.2f MiB in use, %.2f MiB held for reuse\n"),
+                    stats.peak_bytes_in_use / MiB, stats.bytes_held / MiB);
+}
+
 Datafile setupDumpFile(Options& options, Mesh& mesh, const std::string& data_dir) {
   // Check if restarting
   const bool append = options["append"]
@@ -586,7 +649,7 @@ int BoutFinalise(bool write_settings) {
       const auto data_dir = options["datadir"].withDefault(std::string{DEFAULT_DIR});
       const auto set_file = options["settingsfile"].withDefault("");
 
-      if (BoutComm::rank() == 0) {
+      if (BoutComm::rank() == 0 and BoutComm::timeRank() == 0) {
         writeSettingsFile(options, data_dir, set_file);
       }
     } catch (const BoutException& e) {
@@ -607,6 +670,7 @@ int BoutFinalise(bool write_settings) {
   Laplacian::cleanup();
 
   // Delete field memory
+  bout::experimental::printArrayAllocatorStatistics();
   Array<BoutReal>::cleanup();
   Array<dcomplex>::cleanup();
   Array<fcmplx>::cleanup();
@@ -4,6 +4,10 @@
 This uses the jinja template in gen_fieldops.jinja to generate code
 for the arithmetic operators, and prints to stdout.
 
+With the --expr flag, the template in gen_fieldexpr.jinja is used
+instead, to generate the lazy expression node operators which are
+included by include/bout/field_expr.hxx
+
 The `Field` class provides some helper functions for determining how to
 pass a variable by reference or pointer, and how to name arguments in
 function signatures. This allows us to push some logic into the
@@ -69,6 +73,22 @@ header = """// This file is autogenerated - see gen_fieldops.py
 #include <interpolation.hxx>
 """
 
+expr_header = """// This file is autogenerated - see gen_fieldops.py
+#ifndef __GENERATED_FIELDEXPR_H__
+#define __GENERATED_FIELDEXPR_H__
+
+#include "bout/field_expr.hxx"
+
+namespace bout {
+namespace expr {
+"""
+
+expr_footer = """} // namespace expr
+} // namespace bout
+
+#endif // __GENERATED_FIELDEXPR_H__
+"""
+
 
 class Field(object):
     """Abstracts over BoutReals and Field2D/3D/Perps
@@ -79,7 +99,7 @@ class Field(object):
     """
 
     def __init__(self, field_type, dimensions, name=None, index_var=None,
-                 jz_var='jz', mixed_base_ind_var='base_ind'):
+                 jz_var='jz', mixed_base_ind_var='base_ind', block_index_var='i'):
         # C++ type of the field, e.g. Field3D
         self.field_type = field_type
         # array: dimensions of the field
@@ -91,6 +111,8 @@ class Field(object):
         # Name of jz variable
         self.jz_var = jz_var
         self.mixed_base_ind_var = mixed_base_ind_var
+        # Name of the integer index within a contiguous block
+        self.block_index_var = block_index_var
         #Note region_type isn't actually used currently but
         #may be useful in future.
         if self.field_type == "Field3D":
@@ -144,6 +166,40 @@ class Field(object):
         else:
             return "{self.name}[{self.mixed_base_ind_var}]".format(self=self)
 
+    @property
+    def data(self):
+        """Returns "{name}_data", the name of the raw pointer to the
+        field's data, or just the name for BoutReal
+
+        """
+        if self.field_type == "BoutReal":
+            return "{self.name}".format(self=self)
+        else:
+            return "{self.name}_data".format(self=self)
+
+    @property
+    def data_index(self):
+        """Returns "{name}_data[{block_index_var}]", except if field_type
+        is BoutReal, in which case just returns the name
+
+        """
+        if self.field_type == "BoutReal":
+            return "{self.name}".format(self=self)
+        else:
+            return "{self.data}[{self.block_index_var}]".format(self=self)
+
+    @property
+    def data_mixed_index(self):
+        """Returns "{name}_data[{mixed_base_ind_var} + {jz_var}]" if
+        field_type is Field3D, otherwise self.mixed_index
+
+        """
+        if self.field_type == "Field3D":
+            return "{self.data}[{self.mixed_base_ind_var} + {self.jz_var}]".format(
+                self=self)
+        else:
+            return self.mixed_index
+
     def __eq__(self, other):
         try:
             return self.field_type == other.field_type
@@ -184,30 +240,55 @@ if __name__ == "__main__":
     # By default use OpenMP enabled loops but allow to disable
     parser.add_argument("--no-openmp", action="store_false", default=False, dest = "noOpenMP", 
                         help="Don't use OpenMP compatible loops")
+    # Generate the lazy expression operators instead
+    parser.add_argument("--expr", action="store_true", default=False,
+                        help="Generate the expression template operators for field_expr.hxx")
 
     args = parser.parse_args()
 
+    if args.expr:
+        env = jinja2.Environment(loader=jinja2.FileSystemLoader('.'),
+                                 trim_blocks=True)
+        template = env.get_template("gen_fieldexpr.jinja")
+
+        with smart_open(args.filename, "w") as f:
+            f.write(expr_header)
+            f.write("\n")
+            for operator, operator_name in operators.items():
+                f.write(template.render(operator=operator,
+                                        operator_name=operator_name))
+                f.write("\n\n")
+            f.write(expr_footer)
+        sys.exit(0)
+
     #Setup
     index_var = 'index'
     jz_var = 'jz'
     mixed_base_ind_var = "base_ind"
+    block_index_var = 'i'
     region_name = '"RGN_ALL"'
     
     if args.noOpenMP:
         region_loop = 'BOUT_FOR_SERIAL'
+        block_loop = 'BOUT_FOR_BLOCKS_SERIAL'
     else:
         region_loop = 'BOUT_FOR'
+        block_loop = 'BOUT_FOR_BLOCKS'
         
     # Declare what fields we currently support:
     # Field perp is currently missing
     field3D = Field('Field3D', ['x', 'y', 'z'], index_var=index_var,
-                    jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var)
+                    jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var,
+                    block_index_var = block_index_var)
     field2D = Field('Field2D', ['x', 'y'], index_var=index_var,
-                    jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var)
+                    jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var,
+                    block_index_var = block_index_var)
     fieldPerp = Field('FieldPerp', ['x', 'z'], index_var=index_var,
-                    jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var)
+                    jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var,
+                    block_index_var = block_index_var)
     boutreal = Field('BoutReal', [], index_var=index_var,
-                     jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var)
+                     jz_var = jz_var, mixed_base_ind_var = mixed_base_ind_var,
+                     block_index_var = block_index_var)
     
     fields = [field3D, field2D, fieldPerp, boutreal]
 
@@ -244,11 +325,13 @@ if __name__ == "__main__":
                 'rhs': rhs,
                 #
                 'region_loop': region_loop,
+                'block_loop': block_loop,
                 'region_name': region_name,
                 #
                 'index_var': index_var,
                 'mixed_base_ind': mixed_base_ind_var,
                 'jz_var': jz_var,
+                'block_index_var': block_index_var,
             }
 
             with smart_open(args.filename, "a") as f:
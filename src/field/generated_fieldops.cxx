@@ -14,8 +14,15 @@ Field3D operator*(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] * rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -36,7 +43,15 @@ Field3D& Field3D::operator*=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -54,8 +69,15 @@ Field3D operator/(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] / rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] / rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -76,7 +98,15 @@ Field3D& Field3D::operator/=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] /= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -94,8 +124,15 @@ Field3D operator+(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] + rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] + rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -116,7 +153,15 @@ Field3D& Field3D::operator+=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] += rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -134,8 +179,15 @@ Field3D operator-(const Field3D& lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] - rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] - rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -156,7 +208,15 @@ Field3D& Field3D::operator-=(const Field3D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] -= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -176,10 +236,14 @@ Field3D operator*(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[base_ind + jz] * rhs[index];
+      result_data[base_ind + jz] = lhs_data[base_ind + jz] * rhs[index];
     }
   }
 
@@ -201,10 +265,13 @@ Field3D& Field3D::operator*=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
     BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-      const auto base_ind = fieldmesh->ind2Dto3D(index);
+      const int base_ind = fieldmesh->ind2Dto3D(index).ind;
+      BOUT_OMP(simd)
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
-        (*this)[base_ind + jz] *= rhs[index];
+        this_data[base_ind + jz] *= rhs[index];
       }
     }
 
@@ -226,11 +293,15 @@ Field3D operator/(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
     const auto tmp = 1.0 / rhs[index];
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[base_ind + jz] * tmp;
+      result_data[base_ind + jz] = lhs_data[base_ind + jz] * tmp;
     }
   }
 
@@ -252,11 +323,14 @@ Field3D& Field3D::operator/=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
     BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-      const auto base_ind = fieldmesh->ind2Dto3D(index);
+      const int base_ind = fieldmesh->ind2Dto3D(index).ind;
       const auto tmp = 1.0 / rhs[index];
+      BOUT_OMP(simd)
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
-        (*this)[base_ind + jz] *= tmp;
+        this_data[base_ind + jz] *= tmp;
       }
     }
 
@@ -278,10 +352,14 @@ Field3D operator+(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[base_ind + jz] + rhs[index];
+      result_data[base_ind + jz] = lhs_data[base_ind + jz] + rhs[index];
     }
   }
 
@@ -303,10 +381,13 @@ Field3D& Field3D::operator+=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
     BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-      const auto base_ind = fieldmesh->ind2Dto3D(index);
+      const int base_ind = fieldmesh->ind2Dto3D(index).ind;
+      BOUT_OMP(simd)
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
-        (*this)[base_ind + jz] += rhs[index];
+        this_data[base_ind + jz] += rhs[index];
       }
     }
 
@@ -328,10 +409,14 @@ Field3D operator-(const Field3D& lhs, const Field2D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[base_ind + jz] - rhs[index];
+      result_data[base_ind + jz] = lhs_data[base_ind + jz] - rhs[index];
     }
   }
 
@@ -353,10 +438,13 @@ Field3D& Field3D::operator-=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
     BOUT_FOR(index, rhs.getRegion("RGN_ALL")) {
-      const auto base_ind = fieldmesh->ind2Dto3D(index);
+      const int base_ind = fieldmesh->ind2Dto3D(index).ind;
+      BOUT_OMP(simd)
       for (int jz = 0; jz < fieldmesh->LocalNz; ++jz) {
-        (*this)[base_ind + jz] -= rhs[index];
+        this_data[base_ind + jz] -= rhs[index];
       }
     }
 
@@ -455,7 +543,15 @@ Field3D operator*(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -474,7 +570,14 @@ Field3D& Field3D::operator*=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -491,8 +594,16 @@ Field3D operator/(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   const auto tmp = 1.0 / rhs;
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * tmp; }
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * tmp;
+    }
+  }
 
   checkData(result);
   return result;
@@ -512,7 +623,14 @@ Field3D& Field3D::operator/=(const BoutReal rhs) {
     checkData(rhs);
 
     const auto tmp = 1.0 / rhs;
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= tmp; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= tmp;
+      }
+    }
 
     checkData(*this);
 
@@ -529,7 +647,15 @@ Field3D operator+(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] + rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] + rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -548,7 +674,14 @@ Field3D& Field3D::operator+=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] += rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -565,7 +698,15 @@ Field3D operator-(const Field3D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] - rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] - rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -584,7 +725,14 @@ Field3D& Field3D::operator-=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] -= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -604,10 +752,14 @@ Field3D operator*(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[index] * rhs[base_ind + jz];
+      result_data[base_ind + jz] = lhs[index] * rhs_data[base_ind + jz];
     }
   }
 
@@ -625,10 +777,14 @@ Field3D operator/(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[index] / rhs[base_ind + jz];
+      result_data[base_ind + jz] = lhs[index] / rhs_data[base_ind + jz];
     }
   }
 
@@ -646,10 +802,14 @@ Field3D operator+(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[index] + rhs[base_ind + jz];
+      result_data[base_ind + jz] = lhs[index] + rhs_data[base_ind + jz];
     }
   }
 
@@ -667,10 +827,14 @@ Field3D operator-(const Field2D& lhs, const Field3D& rhs) {
 
   Mesh* localmesh = lhs.getMesh();
 
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   BOUT_FOR(index, lhs.getRegion("RGN_ALL")) {
-    const auto base_ind = localmesh->ind2Dto3D(index);
+    const int base_ind = localmesh->ind2Dto3D(index).ind;
+    BOUT_OMP(simd)
     for (int jz = 0; jz < localmesh->LocalNz; ++jz) {
-      result[base_ind + jz] = lhs[index] - rhs[base_ind + jz];
+      result_data[base_ind + jz] = lhs[index] - rhs_data[base_ind + jz];
     }
   }
 
@@ -686,8 +850,15 @@ Field2D operator*(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] * rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -704,7 +875,15 @@ Field2D& Field2D::operator*=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -722,8 +901,15 @@ Field2D operator/(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] / rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] / rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -740,7 +926,15 @@ Field2D& Field2D::operator/=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] /= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -758,8 +952,15 @@ Field2D operator+(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] + rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] + rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -776,7 +977,15 @@ Field2D& Field2D::operator+=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] += rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -794,8 +1003,15 @@ Field2D operator-(const Field2D& lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] - rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] - rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -812,7 +1028,15 @@ Field2D& Field2D::operator-=(const Field2D& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] -= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -909,7 +1133,15 @@ Field2D operator*(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -924,7 +1156,14 @@ Field2D& Field2D::operator*=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -941,8 +1180,16 @@ Field2D operator/(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   const auto tmp = 1.0 / rhs;
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * tmp; }
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * tmp;
+    }
+  }
 
   checkData(result);
   return result;
@@ -958,7 +1205,14 @@ Field2D& Field2D::operator/=(const BoutReal rhs) {
     checkData(rhs);
 
     const auto tmp = 1.0 / rhs;
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= tmp; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= tmp;
+      }
+    }
 
     checkData(*this);
 
@@ -975,7 +1229,15 @@ Field2D operator+(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] + rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] + rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -990,7 +1252,14 @@ Field2D& Field2D::operator+=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] += rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -1007,7 +1276,15 @@ Field2D operator-(const Field2D& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] - rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] - rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -1022,7 +1299,14 @@ Field2D& Field2D::operator-=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] -= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -1408,8 +1692,15 @@ FieldPerp operator*(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] * rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -1426,7 +1717,15 @@ FieldPerp& FieldPerp::operator*=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -1444,8 +1743,15 @@ FieldPerp operator/(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] / rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] / rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -1462,7 +1768,15 @@ FieldPerp& FieldPerp::operator/=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] /= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -1480,8 +1794,15 @@ FieldPerp operator+(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] + rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] + rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -1498,7 +1819,15 @@ FieldPerp& FieldPerp::operator+=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] += rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -1516,8 +1845,15 @@ FieldPerp operator-(const FieldPerp& lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) {
-    result[index] = lhs[index] - rhs[index];
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] - rhs_data[i];
+    }
   }
 
   checkData(result);
@@ -1534,7 +1870,15 @@ FieldPerp& FieldPerp::operator-=(const FieldPerp& rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs[index]; }
+    const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] -= rhs_data[i];
+      }
+    }
 
     checkData(*this);
 
@@ -1551,7 +1895,15 @@ FieldPerp operator*(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -1566,7 +1918,14 @@ FieldPerp& FieldPerp::operator*=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] *= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] *= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -1583,8 +1942,16 @@ FieldPerp operator/(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
   const auto tmp = 1.0 / rhs;
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] * tmp; }
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] * tmp;
+    }
+  }
 
   checkData(result);
   return result;
@@ -1599,7 +1966,14 @@ FieldPerp& FieldPerp::operator/=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] /= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] /= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -1616,7 +1990,15 @@ FieldPerp operator+(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] + rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] + rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -1631,7 +2013,14 @@ FieldPerp& FieldPerp::operator+=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] += rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] += rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -1648,7 +2037,15 @@ FieldPerp operator-(const FieldPerp& lhs, const BoutReal rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs[index] - rhs; }
+  const BoutReal* lhs_data = bout::assumeAligned(&lhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs_data[i] - rhs;
+    }
+  }
 
   checkData(result);
   return result;
@@ -1663,7 +2060,14 @@ FieldPerp& FieldPerp::operator-=(const BoutReal rhs) {
     checkData(*this);
     checkData(rhs);
 
-    BOUT_FOR(index, this->getRegion("RGN_ALL")) { (*this)[index] -= rhs; }
+    BoutReal* this_data = bout::assumeAligned(&(*this)(0, 0, 0));
+
+    BOUT_FOR_BLOCKS(first, last, this->getRegion("RGN_ALL")) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        this_data[i] -= rhs;
+      }
+    }
 
     checkData(*this);
 
@@ -1680,7 +2084,15 @@ Field3D operator*(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs * rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs * rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1693,7 +2105,15 @@ Field3D operator/(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs / rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs / rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1706,7 +2126,15 @@ Field3D operator+(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs + rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs + rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1719,7 +2147,15 @@ Field3D operator-(const BoutReal lhs, const Field3D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs - rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs - rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1732,7 +2168,15 @@ Field2D operator*(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs * rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs * rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1745,7 +2189,15 @@ Field2D operator/(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs / rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs / rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1758,7 +2210,15 @@ Field2D operator+(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs + rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs + rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1771,7 +2231,15 @@ Field2D operator-(const BoutReal lhs, const Field2D& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs - rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs - rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1784,7 +2252,15 @@ FieldPerp operator*(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs * rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs * rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1797,7 +2273,15 @@ FieldPerp operator/(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs / rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs / rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1810,7 +2294,15 @@ FieldPerp operator+(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs + rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs + rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -1823,7 +2315,15 @@ FieldPerp operator-(const BoutReal lhs, const FieldPerp& rhs) {
   checkData(lhs);
   checkData(rhs);
 
-  BOUT_FOR(index, result.getRegion("RGN_ALL")) { result[index] = lhs - rhs[index]; }
+  const BoutReal* rhs_data = bout::assumeAligned(&rhs(0, 0, 0));
+  BoutReal* result_data = bout::assumeAligned(&result(0, 0, 0));
+
+  BOUT_FOR_BLOCKS(first, last, result.getRegion("RGN_ALL")) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      result_data[i] = lhs - rhs_data[i];
+    }
+  }
 
   checkData(result);
   return result;
@@ -49,6 +49,212 @@
 #include <cstring>
 #include "formatfactory.hxx"
 
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace {
+/// A single background thread which does the writing for all
+/// Datafiles with `async` set. Jobs are run one at a time, and the
+/// Datafile methods wait for them to finish before using any file
+/// themselves, so that the I/O libraries are only ever used by one
+/// thread at a time
+class OutputThread {
+public:
+  /// Note: this is never deleted, as joining the thread from a
+  /// static destructor hangs in forked processes, which don't have
+  /// the thread. Datafiles wait for their writes before they are
+  /// destroyed, so nothing is lost
+  static OutputThread& getInstance() {
+    static auto* instance = new OutputThread;
+    return *instance;
+  }
+
+  /// Wait for the previous job to finish, then start running \p new_job
+  void submit(std::function<void()> new_job) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (not thread.joinable()) {
+      thread = std::thread(&OutputThread::run, this);
+    }
+    idle.wait(lock, [this] { return not busy; });
+    throwIfFailed();
+    job = std::move(new_job);
+    busy = true;
+    ready.notify_one();
+  }
+
+  /// Wait until there is no job running. Throws if any job failed
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return not busy; });
+    throwIfFailed();
+  }
+
+  /// Wait until there is no job running, keeping any errors to be
+  /// reported later
+  void waitNoThrow() noexcept {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return not busy; });
+  }
+
+private:
+  OutputThread() = default;
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      ready.wait(lock, [this] { return busy; });
+      auto current = std::move(job);
+      lock.unlock();
+
+      // Can't throw from this thread, so keep the message for
+      // whichever Datafile next waits for the writes
+      std::string message;
+      try {
+        current();
+      } catch (const std::exception& e) {
+        message = e.what();
+      } catch (...) {
+        message = "unknown error";
+      }
+
+      lock.lock();
+      if (error.empty()) {
+        error = message;
+      }
+      busy = false;
+      idle.notify_all();
+    }
+  }
+
+  /// Must be called with the mutex locked
+  void throwIfFailed() {
+    if (not error.empty()) {
+      std::string message;
+      std::swap(message, error);
+      throw BoutException("Datafile: Asynchronous write failed: %s", message.c_str());
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable ready; ///< Signalled when there is a new job
+  std::condition_variable idle;  ///< Signalled when a job has finished
+  std::function<void()> job;
+  bool busy{false};     ///< Is there a job waiting or running?
+  std::string error;    ///< Message from the first job which failed
+  std::thread thread;
+};
+
+/// Copy of one variable, owned by a Datafile::StagedRecord
+struct StagedVar {
+  enum class Type { Int, Real, Field2D, Field3D, FieldPerp };
+
+  Type type;
+  std::string name;
+  bool save_repeat;
+  int int_value;
+  BoutReal real_value;
+  Array<BoutReal> data; ///< Values of fields, including guard cells
+  int lx, ly, lz;       ///< Sizes of the part of fields to write
+
+  /// Make data hold \p size values, reusing the existing buffer if it
+  /// is the right size, and return a pointer to the start
+  BoutReal* resizeData(int size) {
+    if (data.size() != size) {
+      data.reallocate(size);
+    }
+    return std::begin(data);
+  }
+
+  /// Copy \p size values of a field from \p values into data
+  void setData(const BoutReal* values, int size) {
+    std::copy(values, values + size, resizeData(size));
+  }
+};
+} // namespace
+
+struct Datafile::StagedRecord {
+  std::vector<StagedVar> vars;
+  /// Number of entries of vars in use. Entries beyond this are kept
+  /// so that their buffers can be reused
+  std::size_t nvars{0};
+
+  std::string filename;
+  int rank;
+  bool open;   ///< Open the file before writing?
+  bool append; ///< If opening, append to an existing file?
+  bool close;  ///< Close the file after writing?
+  bool flush;  ///< Otherwise, flush the file after writing?
+  bool floats;
+
+  /// Get the next unused entry of vars
+  StagedVar& next() {
+    if (nvars == vars.size()) {
+      vars.emplace_back();
+    }
+    return vars[nvars++];
+  }
+
+  /// Write all the staged variables to \p file. Called on the
+  /// background I/O thread
+  void write(DataFormat& file) {
+    if (open and not file.openw(filename, rank, append)) {
+      throw BoutException("Failed to open file %s for %s!", filename.c_str(),
+                          append ? "appending" : "writing");
+    }
+    if (not file.is_valid()) {
+      throw BoutException("File %s is not valid!", filename.c_str());
+    }
+    if (floats) {
+      file.setLowPrecision();
+    }
+
+    file.setRecord(-1); // Latest record
+
+    for (std::size_t i = 0; i < nvars; ++i) {
+      auto& var = vars[i];
+      bool success = false;
+      switch (var.type) {
+      case StagedVar::Type::Int:
+        success = var.save_repeat ? file.write_rec(&var.int_value, var.name)
+                                  : file.write(&var.int_value, var.name);
+        break;
+      case StagedVar::Type::Real:
+        success = var.save_repeat ? file.write_rec(&var.real_value, var.name)
+                                  : file.write(&var.real_value, var.name);
+        break;
+      case StagedVar::Type::Field2D:
+      case StagedVar::Type::Field3D:
+        success = var.save_repeat
+                      ? file.write_rec(var.data.begin(), var.name, var.lx, var.ly, var.lz)
+                      : file.write(var.data.begin(), var.name, var.lx, var.ly, var.lz);
+        break;
+      case StagedVar::Type::FieldPerp:
+        success = var.save_repeat
+                      ? file.write_rec_perp(var.data.begin(), var.name, var.lx, var.lz)
+                      : file.write_perp(var.data.begin(), var.name, var.lx, var.lz);
+        break;
+      }
+      if (not success) {
+        throw BoutException("Failed to write %s!", var.name.c_str());
+      }
+    }
+
+    if (close) {
+      file.close();
+    } else if (flush) {
+      file.flush();
+    }
+  }
+};
+
+struct Datafile::AsyncBuffers {
+  StagedRecord records[2];
+  int current{0}; ///< Index of the record to fill next
+};
+
 Datafile::Datafile(Options* opt, Mesh* mesh_in)
     : mesh(mesh_in == nullptr ? bout::globals::mesh : mesh_in), file(nullptr) {
   filenamelen=FILENAMELEN;
@@ -70,6 +276,37 @@ Datafile::Datafile(Options* opt, Mesh* mesh_in)
   OPTION(opt, shiftOutput, false); // Do we want to write 3D fields in shifted space?
   OPTION(opt, shiftInput, false); // Do we want to read 3D fields in shifted space?
   OPTION(opt, flushFrequency, 1); // How frequently do we flush the file
+  OPTION(opt, async, false); // Write in a background thread?
+
+  // How variables are chunked and compressed, if the format supports it
+  storage.deflate_level = (*opt)["deflate"].withDefault(storage.deflate_level);
+  storage.shuffle = (*opt)["shuffle"].withDefault(storage.shuffle);
+  storage.chunk_records = (*opt)["chunk_records"].withDefault(storage.chunk_records);
+  storage.chunk_bytes = (*opt)["chunk_bytes"].withDefault(storage.chunk_bytes);
+  storage.significant_digits =
+      (*opt)["significant_digits"].withDefault(storage.significant_digits);
+
+  if (storage.deflate_level < 0 or storage.deflate_level > 9) {
+    throw BoutException("Datafile: 'deflate' must be between 0 and 9, not %d",
+                        storage.deflate_level);
+  }
+  if (storage.chunk_records < 0 or storage.chunk_bytes <= 0) {
+    throw BoutException("Datafile: 'chunk_records' must not be negative, and "
+                        "'chunk_bytes' must be positive");
+  }
+  if (storage.significant_digits < 0 or storage.significant_digits > 7) {
+    throw BoutException("Datafile: 'significant_digits' must be between 0 and 7, not %d",
+                        storage.significant_digits);
+  }
+
+  if (flushFrequency < 1) {
+    throw BoutException("Datafile: 'flushFrequency' must be at least 1, not %d",
+                        flushFrequency);
+  }
+
+  if (async and parallel) {
+    throw BoutException("Datafile: The 'async' and 'parallel' options can't be used together");
+  }
 }
 
 Datafile::Datafile(Datafile &&other) noexcept
@@ -77,8 +314,10 @@ Datafile::Datafile(Datafile &&other) noexcept
       floats(other.floats), openclose(other.openclose), Lx(other.Lx), Ly(other.Ly),
       Lz(other.Lz), enabled(other.enabled), shiftOutput(other.shiftOutput),
       shiftInput(other.shiftInput), flushFrequencyCounter(other.flushFrequencyCounter),
-      flushFrequency(other.flushFrequency), file(std::move(other.file)),
-      writable(other.writable), appending(other.appending), first_time(other.first_time),
+      flushFrequency(other.flushFrequency), async(other.async),
+      repartition(other.repartition), storage(other.storage),
+      file(std::move(other.file)), writable(other.writable), appending(other.appending),
+      first_time(other.first_time), async_buffers(std::move(other.async_buffers)),
       int_arr(std::move(other.int_arr)), BoutReal_arr(std::move(other.BoutReal_arr)),
       bool_arr(std::move(other.bool_arr)), f2d_arr(std::move(other.f2d_arr)),
       f3d_arr(std::move(other.f3d_arr)), v2d_arr(std::move(other.v2d_arr)),
@@ -93,7 +332,7 @@ Datafile::Datafile(Datafile &&other) noexcept
 Datafile::Datafile(const Datafile &other) :
   mesh(other.mesh), parallel(other.parallel), flush(other.flush), guards(other.guards),
   floats(other.floats), openclose(other.openclose), Lx(other.Lx), Ly(other.Ly), Lz(other.Lz),
-  enabled(other.enabled), shiftOutput(other.shiftOutput), shiftInput(other.shiftInput), flushFrequencyCounter(other.flushFrequencyCounter), flushFrequency(other.flushFrequency), 
+  enabled(other.enabled), shiftOutput(other.shiftOutput), shiftInput(other.shiftInput), flushFrequencyCounter(other.flushFrequencyCounter), flushFrequency(other.flushFrequency), async(other.async), repartition(other.repartition), storage(other.storage),
   file(nullptr), writable(other.writable), appending(other.appending), first_time(other.first_time),
   int_arr(other.int_arr), BoutReal_arr(other.BoutReal_arr),
   bool_arr(other.bool_arr), f2d_arr(other.f2d_arr), f3d_arr(other.f3d_arr),
@@ -106,6 +345,10 @@ Datafile::Datafile(const Datafile &other) :
 }
 
 Datafile& Datafile::operator=(Datafile &&rhs) noexcept {
+  // The file and buffers are about to be replaced, so can't still be
+  // in use by the I/O thread
+  OutputThread::getInstance().waitNoThrow();
+
   mesh         = rhs.mesh;
   parallel     = rhs.parallel;
   flush        = rhs.flush;
@@ -118,10 +361,14 @@ Datafile& Datafile::operator=(Datafile &&rhs) noexcept {
   shiftInput   = rhs.shiftInput;
   flushFrequencyCounter = 0;
   flushFrequency = rhs.flushFrequency;
+  async        = rhs.async;
+  repartition  = rhs.repartition;
+  storage      = rhs.storage;
   file         = std::move(rhs.file);
   writable     = rhs.writable;
   appending    = rhs.appending;
   first_time   = rhs.first_time;
+  async_buffers = std::move(rhs.async_buffers);
   int_arr      = std::move(rhs.int_arr);
   BoutReal_arr = std::move(rhs.BoutReal_arr);
   bool_arr     = std::move(rhs.bool_arr);
@@ -139,6 +386,10 @@ Datafile& Datafile::operator=(Datafile &&rhs) noexcept {
 }
 
 Datafile::~Datafile() {
+  if (async_buffers) {
+    // Don't destroy the file or buffers while they're being used
+    OutputThread::getInstance().waitNoThrow();
+  }
   if (filename != nullptr){
     delete[] filename;
     filename=nullptr;
@@ -153,20 +404,20 @@ bool Datafile::openr(const char *format, ...) {
 
   bout_vsnprintf(filename,filenamelen, format);
   
+  waitForWrites();
+
   // Get the data format
   file = FormatFactory::getInstance()->createDataFormat(filename, parallel);
   
   if(!file)
     throw BoutException("Datafile::open: Factory failed to create a DataFormat!");
-  
-  // If parallel do not want to write ghost points, and it is easier then to ignore the boundary guard cells as well
-  if (parallel) {
-    file->setLocalOrigin(0, 0, 0, mesh->xstart, mesh->ystart, 0);
-  }
-  else {
-    file->setGlobalOrigin(0,0,0);
+
+  if (repartition and not parallel) {
+    file = repartition_format(std::move(file), mesh);
   }
   
+  setOrigin();
+  
   if(!openclose) {
     // Open the file now. Otherwise defer until later
     if(!file->openr(filename, BoutComm::rank()))
@@ -189,25 +440,16 @@ bool Datafile::openw(const char *format, ...) {
 
   bout_vsnprintf(filename, filenamelen, format);
   
+  waitForWrites();
+
   // Get the data format
   file = FormatFactory::getInstance()->createDataFormat(filename, parallel, mesh);
   
   if(!file)
     throw BoutException("Datafile::open: Factory failed to create a DataFormat!");
   
-  // If parallel do not want to write ghost points, and it is easier then to ignore the boundary guard cells as well
-  if (parallel) {
-    file->setLocalOrigin(0, 0, 0, mesh->xstart, mesh->ystart, 0);
-    Lx = mesh->LocalNx-2*mesh->xstart;
-    Ly = mesh->LocalNy-2*mesh->ystart;
-    Lz = mesh->LocalNz;
-  }
-  else {
-    file->setGlobalOrigin(0,0,0);
-    Lx = mesh->LocalNx;
-    Ly = mesh->LocalNy;
-    Lz = mesh->LocalNz;
-  }
+  setOrigin();
+  file->setStorageSettings(storage);
   
   appending = false;
   // Open the file
@@ -306,25 +548,16 @@ bool Datafile::opena(const char *format, ...) {
 
   bout_vsnprintf(filename, filenamelen, format);
 
+  waitForWrites();
+
   // Get the data format
   file = FormatFactory::getInstance()->createDataFormat(filename, parallel);
   
   if(!file)
     throw BoutException("Datafile::open: Factory failed to create a DataFormat!");
 
-  // If parallel do not want to write ghost points, and it is easier then to ignore the boundary guard cells as well
-  if (parallel) {
-    file->setLocalOrigin(0, 0, 0, mesh->xstart, mesh->ystart, 0);
-    Lx = mesh->LocalNx-2*mesh->xstart;
-    Ly = mesh->LocalNy-2*mesh->ystart;
-    Lz = mesh->LocalNz;
-  }
-  else {
-    file->setGlobalOrigin(0,0,0);
-    Lx = mesh->LocalNx;
-    Ly = mesh->LocalNy;
-    Lz = mesh->LocalNz;
-  }
+  setOrigin();
+  file->setStorageSettings(storage);
   
   appending = true;
   // Open the file
@@ -413,19 +646,45 @@ bool Datafile::opena(const char *format, ...) {
   return true;
 }
 
+void Datafile::setOrigin() {
+  if (parallel) {
+    if (!file->isParallel()) {
+      throw BoutException("Datafile::open: Parallel I/O is not available for file %s. "
+                          "This needs an HDF5 file, and BOUT++ configured with "
+                          "parallel HDF5",
+                          filename);
+    }
+    // All processors share one file, and each writes its part of the
+    // global arrays. Ghost points are not written, and it is easier
+    // then to ignore the boundary guard cells as well
+    file->setLocalOrigin(0, 0, 0, mesh->xstart, mesh->ystart, 0);
+    Lx = mesh->LocalNx-2*mesh->xstart;
+    Ly = mesh->LocalNy-2*mesh->ystart;
+    Lz = mesh->LocalNz;
+  }
+  else {
+    file->setGlobalOrigin(0,0,0);
+    Lx = mesh->LocalNx;
+    Ly = mesh->LocalNy;
+    Lz = mesh->LocalNz;
+  }
+}
+
 bool Datafile::isValid() {
   if(!enabled)
     return true; // Pretend to be valid
   
   if(!file)
     return false;
-  
+
+  waitForWrites();
   return file->is_valid();
 }
 
 void Datafile::close() {
   if(!file)
     return;
+  waitForWrites();
   if(!openclose)
     file->close();
   // free:
@@ -437,6 +696,7 @@ void Datafile::setLowPrecision() {
   if(!enabled)
     return;
   floats = true;
+  waitForWrites();
   file->setLowPrecision();
 }
 
@@ -465,6 +725,8 @@ void Datafile::add(int &i, const char *name, bool save_repeat) {
   int_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -522,6 +784,8 @@ void Datafile::add(BoutReal &r, const char *name, bool save_repeat) {
   BoutReal_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -581,6 +845,8 @@ void Datafile::add(bool &b, const char *name, bool save_repeat) {
   bool_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -638,6 +904,8 @@ void Datafile::add(Field2D &f, const char *name, bool save_repeat) {
   f2d_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -697,6 +965,8 @@ void Datafile::add(Field3D &f, const char *name, bool save_repeat) {
   f3d_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -735,6 +1005,12 @@ void Datafile::add(FieldPerp &f, const char *name, bool save_repeat) {
   AUTO_TRACE();
   if (!enabled)
     return;
+  if (parallel) {
+    // Only some processors contain a FieldPerp, but parallel writes
+    // are collective so need all of them
+    throw BoutException("Datafile::add: Can't write FieldPerp '%s' with parallel I/O",
+                        name);
+  }
   if (varAdded(name)) {
     // Check if it's the same variable
     if (&f == varPtr(name)) {
@@ -756,6 +1032,8 @@ void Datafile::add(FieldPerp &f, const char *name, bool save_repeat) {
   fperp_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -815,6 +1093,8 @@ void Datafile::add(Vector2D &f, const char *name, bool save_repeat) {
   v2d_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -884,6 +1164,8 @@ void Datafile::add(Vector3D &f, const char *name, bool save_repeat) {
   v3d_arr.push_back(d);
 
   if (writable) {
+    waitForWrites();
+
     // Otherwise will add variables when Datafile is opened for writing/appending
     if (openclose) {
       // Open the file
@@ -931,6 +1213,8 @@ void Datafile::add(Vector3D &f, const char *name, bool save_repeat) {
 bool Datafile::read() {
   Timer timer("io");  ///< Start timer. Stops when goes out of scope
 
+  waitForWrites();
+
   if(openclose) {
     // Open the file
     if(!file->openr(filename, BoutComm::rank())) {
@@ -1079,6 +1363,14 @@ bool Datafile::write() {
   if(!file)
     throw BoutException("Datafile::write: File is not valid!");
 
+  if (async and not first_time) {
+    // The first write is always done here, as the field attributes
+    // need the fields themselves
+    return writeAsync();
+  }
+
+  waitForWrites();
+
   if(openclose && (flushFrequencyCounter % flushFrequency == 0)) {
     // Open the file
     if(!file->openw(filename, BoutComm::rank(), appending)) {
@@ -1213,13 +1505,236 @@ bool Datafile::write() {
     write_f3d(name+"z", &(v.z), var.save_repeat);
   }
   
-  if(openclose  && (flushFrequencyCounter+1 % flushFrequency == 0)){
+  if ((flushFrequencyCounter + 1) % flushFrequency == 0) {
+    if (openclose) {
+      file->close();
+    } else if (flush) {
+      // Keeping the file open, but make sure the records are on disk
+      file->flush();
+    }
+  }
+  flushFrequencyCounter++;
+  return true;
+}
+
+bool Datafile::writeVar(const std::string& name) {
+  if(!enabled)
+    return true; // Just pretend it worked
+
+  TRACE("Datafile::writeVar");
+
+  if(!file)
+    throw BoutException("Datafile::writeVar: File is not valid!");
+
+  // Everything written before this must be in the file first
+  waitForWrites();
+
+  Timer timer("io");
+
+  const bool was_open = file->is_valid();
+  if (not was_open) {
+    if (!file->openw(filename, BoutComm::rank(), true)) {
+      throw BoutException("Datafile::writeVar: Failed to open file %s for appending!",
+                          filename);
+    }
+  }
+
+  file->setRecord(-1); // Latest record
+
+  const auto int_var = std::find_if(begin(int_arr), end(int_arr),
+                                    [&name](const VarStr<int>& var) { return var.name == name; });
+  const auto real_var =
+      std::find_if(begin(BoutReal_arr), end(BoutReal_arr),
+                   [&name](const VarStr<BoutReal>& var) { return var.name == name; });
+
+  bool result;
+  if (int_var != end(int_arr)) {
+    result = write_int(int_var->name, int_var->ptr, int_var->save_repeat);
+  } else if (real_var != end(BoutReal_arr)) {
+    result = write_real(real_var->name, real_var->ptr, real_var->save_repeat);
+  } else {
+    throw BoutException("Datafile::writeVar: No int or BoutReal '%s' has been added",
+                        name.c_str());
+  }
+
+  if (not was_open) {
     file->close();
+  } else if (flush) {
+    file->flush();
+  }
+  return result;
+}
+
+bool Datafile::writeAsync() {
+  // Includes the time spent waiting for the previous write
+  Timer timer("io");
+
+  if (!async_buffers) {
+    async_buffers = bout::utils::make_unique<AsyncBuffers>();
+  }
+  // This record was last written two calls ago, so is no longer in
+  // use: submit() waits for each write to finish before starting the
+  // next one
+  auto& record = async_buffers->records[async_buffers->current];
+
+  record.filename = filename;
+  record.rank = BoutComm::rank();
+  record.floats = floats;
+  record.append = appending;
+  record.open = openclose && (flushFrequencyCounter % flushFrequency == 0);
+  if (record.open) {
+    appending = true;
+    flushFrequencyCounter = 0;
   }
+  const bool end_of_batch = (flushFrequencyCounter + 1) % flushFrequency == 0;
+  record.close = openclose and end_of_batch;
+  record.flush = not openclose and flush and end_of_batch;
   flushFrequencyCounter++;
+
+  stageVariables(record);
+
+  DataFormat* format = file.get();
+  OutputThread::getInstance().submit([format, &record]() { record.write(*format); });
+
+  async_buffers->current = 1 - async_buffers->current;
   return true;
 }
 
+void Datafile::stageVariables(StagedRecord& record) {
+  record.nvars = 0;
+
+  for (const auto& var : int_arr) {
+    auto& staged = record.next();
+    staged.type = StagedVar::Type::Int;
+    staged.name = var.name;
+    staged.save_repeat = var.save_repeat;
+    staged.int_value = *var.ptr;
+  }
+
+  for (const auto& var : BoutReal_arr) {
+    auto& staged = record.next();
+    staged.type = StagedVar::Type::Real;
+    staged.name = var.name;
+    staged.save_repeat = var.save_repeat;
+    staged.real_value = *var.ptr;
+  }
+
+  // Bools are written as ints
+  for (const auto& var : bool_arr) {
+    auto& staged = record.next();
+    staged.type = StagedVar::Type::Int;
+    staged.name = var.name;
+    staged.save_repeat = var.save_repeat;
+    staged.int_value = int(*var.ptr);
+  }
+
+  auto stageField2D = [this, &record](const std::string& name, const Field2D& f,
+                                      bool save_repeat) {
+    if (!f.isAllocated()) {
+      throw BoutException("Datafile::write_f2d: Field2D '%s' is not allocated!",
+                          name.c_str());
+    }
+    auto& staged = record.next();
+    staged.type = StagedVar::Type::Field2D;
+    staged.name = name;
+    staged.save_repeat = save_repeat;
+    staged.setData(&f(0, 0), mesh->LocalNx * mesh->LocalNy);
+    staged.lx = Lx;
+    staged.ly = Ly;
+    staged.lz = 0;
+  };
+
+  auto stageField3D = [this, &record](const std::string& name, const Field3D& f,
+                                      bool save_repeat) {
+    if (!f.isAllocated()) {
+      throw BoutException("Datafile::write_f3d: Field3D '%s' is not allocated!",
+                          name.c_str());
+    }
+    auto& staged = record.next();
+    staged.type = StagedVar::Type::Field3D;
+    staged.name = name;
+    staged.save_repeat = save_repeat;
+    const int size = mesh->LocalNx * mesh->LocalNy * mesh->LocalNz;
+    if (shiftOutput) {
+      // Shift straight into the staging buffer
+      f.getCoordinates()->getParallelTransform().calcFieldAligned(f,
+                                                                  staged.resizeData(size));
+    } else {
+      staged.setData(&f(0, 0, 0), size);
+    }
+    staged.lx = Lx;
+    staged.ly = Ly;
+    staged.lz = Lz;
+  };
+
+  for (const auto& var : f2d_arr) {
+    stageField2D(var.name, *var.ptr, var.save_repeat);
+  }
+
+  for (const auto& var : f3d_arr) {
+    stageField3D(var.name, *var.ptr, var.save_repeat);
+  }
+
+  for (const auto& var : fperp_arr) {
+    const FieldPerp& f = *var.ptr;
+    const int yindex = f.getIndex();
+    if (yindex < 0 or yindex >= mesh->LocalNy) {
+      // Not on this processor, so nothing to write
+      continue;
+    }
+    if (!f.isAllocated()) {
+      throw BoutException("Datafile::write_fperp: FieldPerp '%s' is not allocated!",
+                          var.name.c_str());
+    }
+    auto& staged = record.next();
+    staged.type = StagedVar::Type::FieldPerp;
+    staged.name = var.name;
+    staged.save_repeat = var.save_repeat;
+    const int size = mesh->LocalNx * mesh->LocalNz;
+    if (shiftOutput) {
+      const FieldPerp f_out = toFieldAligned(f);
+      staged.setData(&f_out(0, 0), size);
+    } else {
+      staged.setData(&f(0, 0), size);
+    }
+    staged.lx = Lx;
+    staged.ly = 0;
+    staged.lz = Lz;
+  }
+
+  for (const auto& var : v2d_arr) {
+    Vector2D v = *(var.ptr);
+    auto name = var.name;
+    if (var.covar) {
+      v.toCovariant();
+      name += "_";
+    } else {
+      v.toContravariant();
+    }
+    stageField2D(name + "x", v.x, var.save_repeat);
+    stageField2D(name + "y", v.y, var.save_repeat);
+    stageField2D(name + "z", v.z, var.save_repeat);
+  }
+
+  for (const auto& var : v3d_arr) {
+    Vector3D v = *(var.ptr);
+    auto name = var.name;
+    if (var.covar) {
+      v.toCovariant();
+      name += "_";
+    } else {
+      v.toContravariant();
+    }
+    stageField3D(name + "x", v.x, var.save_repeat);
+    stageField3D(name + "y", v.y, var.save_repeat);
+    stageField3D(name + "z", v.z, var.save_repeat);
+  }
+}
+
+void Datafile::waitForWrites() {
+  OutputThread::getInstance().wait();
+}
+
 bool Datafile::write(const char *format, ...) const {
   if(!enabled)
     return true;
@@ -1258,6 +1773,8 @@ void Datafile::setAttribute(const std::string &varname, const std::string &attrn
   if(!file)
     throw BoutException("Datafile::write: File is not valid!");
 
+  waitForWrites();
+
   if(openclose && (flushFrequencyCounter % flushFrequency == 0)) {
     // Open the file
     if(!file->openw(filename, BoutComm::rank(), appending)) {
@@ -1296,6 +1813,8 @@ void Datafile::setAttribute(const std::string &varname, const std::string &attrn
   if(!file)
     throw BoutException("Datafile::write: File is not valid!");
 
+  waitForWrites();
+
   if(openclose && (flushFrequencyCounter % flushFrequency == 0)) {
     // Open the file
     if(!file->openw(filename, BoutComm::rank(), appending)) {
@@ -1334,6 +1853,8 @@ void Datafile::setAttribute(const std::string &varname, const std::string &attrn
   if(!file)
     throw BoutException("Datafile::write: File is not valid!");
 
+  waitForWrites();
+
   if(openclose && (flushFrequencyCounter % flushFrequency == 0)) {
     // Open the file
     if(!file->openw(filename, BoutComm::rank(), appending)) {
@@ -1375,7 +1896,7 @@ bool Datafile::read_f2d(const std::string &name, Field2D *f, bool save_repeat) {
   f->allocate();
   
   if(save_repeat) {
-    if(!file->read_rec(&((*f)(0,0)), name, mesh->LocalNx, mesh->LocalNy)) {
+    if(!file->read_rec(&((*f)(0,0)), name, Lx, Ly)) {
       if(init_missing) {
         output_warn.write("\tWARNING: Could not read 2D field %s. Setting to zero\n", name.c_str());
         *f = 0.0;
@@ -1385,7 +1906,7 @@ bool Datafile::read_f2d(const std::string &name, Field2D *f, bool save_repeat) {
       return false;
     }
   }else {
-    if(!file->read(&((*f)(0,0)), name, mesh->LocalNx, mesh->LocalNy)) {
+    if(!file->read(&((*f)(0,0)), name, Lx, Ly)) {
       if(init_missing) {
         output_warn.write("\tWARNING: Could not read 2D field %s. Setting to zero\n", name.c_str());
         *f = 0.0;
@@ -1413,7 +1934,7 @@ bool Datafile::read_f3d(const std::string &name, Field3D *f, bool save_repeat) {
   f->allocate();
   
   if(save_repeat) {
-    if(!file->read_rec(&((*f)(0,0,0)), name, mesh->LocalNx, mesh->LocalNy, mesh->LocalNz)) {
+    if(!file->read_rec(&((*f)(0,0,0)), name, Lx, Ly, Lz)) {
       if(init_missing) {
         output_warn.write("\tWARNING: Could not read 3D field %s. Setting to zero\n", name.c_str());
         *f = 0.0;
@@ -1423,7 +1944,7 @@ bool Datafile::read_f3d(const std::string &name, Field3D *f, bool save_repeat) {
       return false;
     }
   }else {
-    if(!file->read(&((*f)(0,0,0)), name, mesh->LocalNx, mesh->LocalNy, mesh->LocalNz)) {
+    if(!file->read(&((*f)(0,0,0)), name, Lx, Ly, Lz)) {
       if(init_missing) {
         output_warn.write("\tWARNING: Could not read 3D field %s. Setting to zero\n", name.c_str());
         *f = 0.0;
@@ -1461,7 +1982,7 @@ bool Datafile::read_fperp(const std::string &name, FieldPerp *f, bool save_repea
     f->allocate();
 
     if(save_repeat) {
-      if(!file->read_rec_perp(&((*f)(0,0)), name, mesh->LocalNx, mesh->LocalNz)) {
+      if(!file->read_rec_perp(&((*f)(0,0)), name, Lx, Lz)) {
         if(init_missing) {
           output_warn.write("\tWARNING: Could not read FieldPerp %s. Setting to zero\n", name.c_str());
           *f = 0.0;
@@ -1471,7 +1992,7 @@ bool Datafile::read_fperp(const std::string &name, FieldPerp *f, bool save_repea
         return false;
       }
     }else {
-      if(!file->read_perp(&((*f)(0,0)), name, mesh->LocalNx, mesh->LocalNz)) {
+      if(!file->read_perp(&((*f)(0,0)), name, Lx, Lz)) {
         if(init_missing) {
           output_warn.write("\tWARNING: Could not read FieldPerp %s. Setting to zero\n", name.c_str());
           *f = 0.0;
@@ -1512,11 +2033,11 @@ bool Datafile::write_f2d(const std::string &name, Field2D *f, bool save_repeat)
     throw BoutException("Datafile::write_f2d: Field2D '%s' is not allocated!", name.c_str());
   }
   if (save_repeat) {
-    if (!file->write_rec(&((*f)(0, 0)), name, mesh->LocalNx, mesh->LocalNy)) {
+    if (!file->write_rec(&((*f)(0, 0)), name, Lx, Ly)) {
       throw BoutException("Datafile::write_f2d: Failed to write %s!", name.c_str());
     }
   } else {
-    if (!file->write(&((*f)(0, 0)), name, mesh->LocalNx, mesh->LocalNy)) {
+    if (!file->write(&((*f)(0, 0)), name, Lx, Ly)) {
       throw BoutException("Datafile::write_f2d: Failed to write %s!", name.c_str());
     }
   }
@@ -1528,18 +2049,23 @@ bool Datafile::write_f3d(const std::string &name, Field3D *f, bool save_repeat)
     throw BoutException("Datafile::write_f3d: Field3D '%s' is not allocated!", name.c_str());
   }
 
-  //Deal with shifting the output
-  Field3D f_out{emptyFrom(*f)};
-  if(shiftOutput) {
-    f_out = toFieldAligned(*f);
-  }else {
-    f_out = *f;
+  // Write straight from the field's own data, unless it needs shifting
+  BoutReal* data = &((*f)(0, 0, 0));
+  if (shiftOutput) {
+    // Shift into a buffer which is reused for every variable, rather
+    // than creating a new field each time
+    const int size = mesh->LocalNx * mesh->LocalNy * mesh->LocalNz;
+    if (shift_buffer.size() != size) {
+      shift_buffer.reallocate(size);
+    }
+    data = std::begin(shift_buffer);
+    f->getCoordinates()->getParallelTransform().calcFieldAligned(*f, data);
   }
 
   if(save_repeat) {
-    return file->write_rec(&(f_out(0,0,0)), name, mesh->LocalNx, mesh->LocalNy, mesh->LocalNz);
+    return file->write_rec(data, name, Lx, Ly, Lz);
   }else {
-    return file->write(&(f_out(0,0,0)), name, mesh->LocalNx, mesh->LocalNy, mesh->LocalNz);
+    return file->write(data, name, Lx, Ly, Lz);
   }
 }
 
@@ -1550,18 +2076,13 @@ bool Datafile::write_fperp(const std::string &name, FieldPerp *f, bool save_repe
       throw BoutException("Datafile::write_fperp: FieldPerp '%s' is not allocated!", name.c_str());
     }
 
-    //Deal with shifting the output
-    FieldPerp f_out{emptyFrom(*f)};
-    if(shiftOutput) {
-      f_out = toFieldAligned(*f);
-    }else {
-      f_out = *f;
-    }
+    // Write straight from the field's own data, unless it needs shifting
+    FieldPerp f_out = shiftOutput ? toFieldAligned(*f) : *f;
 
     if(save_repeat) {
-      return file->write_rec_perp(&(f_out(0,0)), name, mesh->LocalNx, mesh->LocalNz);
+      return file->write_rec_perp(&(f_out(0,0)), name, Lx, Lz);
     }else {
-      return file->write_perp(&(f_out(0,0)), name, mesh->LocalNx, mesh->LocalNz);
+      return file->write_perp(&(f_out(0,0)), name, Lx, Lz);
     }
   }
 
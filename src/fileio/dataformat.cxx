@@ -4,6 +4,11 @@
 #include <dataformat.hxx>
 #include <utils.hxx>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
 DataFormat::DataFormat(Mesh* mesh_in)
   : mesh(mesh_in==nullptr ? bout::globals::mesh : mesh_in) {}
 
@@ -35,6 +40,82 @@ bool DataFormat::setLocalOrigin(int x, int y, int z, int UNUSED(offset_x),
   return setGlobalOrigin(x + mesh->OffsetX, y + mesh->OffsetY, z + mesh->OffsetZ);
 }
 
+std::vector<std::size_t> DataFormat::chunkShape(std::vector<std::size_t> dims,
+                                                bool repeat,
+                                                std::size_t element_size) const {
+  // Most records in a chunk when choosing automatically, so that
+  // short time series aren't padded out to a large chunk
+  constexpr std::size_t max_auto_records = 128;
+
+  const std::size_t chunk_bytes = std::max(storage.chunk_bytes, 1);
+  const std::size_t first = repeat ? 1 : 0;
+
+  std::size_t record_bytes = element_size;
+  for (std::size_t i = first; i < dims.size(); ++i) {
+    dims[i] = std::max<std::size_t>(dims[i], 1);
+    record_bytes *= dims[i];
+  }
+
+  // Split the slowest varying dimensions first, keeping Z-lines whole
+  for (std::size_t i = first; i + 1 < dims.size(); ++i) {
+    while (record_bytes > chunk_bytes and dims[i] > 1) {
+      record_bytes /= dims[i];
+      dims[i] = (dims[i] + 1) / 2;
+      record_bytes *= dims[i];
+    }
+  }
+
+  if (repeat and not dims.empty()) {
+    if (storage.chunk_records > 0) {
+      dims[0] = storage.chunk_records;
+    } else {
+      dims[0] = std::min(std::max<std::size_t>(chunk_bytes / record_bytes, 1),
+                         max_auto_records);
+    }
+  }
+  return dims;
+}
+
+namespace {
+/// Round the mantissa of \p value to \p keep_bits bits, to nearest
+/// with ties to even. The discarded bits are zero, so compress well
+float roundMantissa(float value, int keep_bits) {
+  constexpr int mantissa_bits = 23;
+  if (keep_bits >= mantissa_bits or not std::isfinite(value)) {
+    return value;
+  }
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const int drop = mantissa_bits - keep_bits;
+  const std::uint32_t half = std::uint32_t{1} << (drop - 1);
+  const std::uint32_t mask = ~((std::uint32_t{1} << drop) - 1);
+  bits = (bits + half - 1 + ((bits >> drop) & 1)) & mask;
+
+  std::memcpy(&value, &bits, sizeof(bits));
+  return value;
+}
+} // namespace
+
+float* DataFormat::toFloat(const BoutReal* data, int size) {
+  float_buffer.resize(size);
+
+  // Number of bits of mantissa needed for the significant digits
+  const int keep_bits =
+      storage.significant_digits > 0
+          ? static_cast<int>(std::ceil(storage.significant_digits * std::log2(10.0)))
+          : 23;
+
+  for (int i = 0; i < size; ++i) {
+    // An out of range value can make the conversion
+    // corrupt the whole dataset. Make sure everything
+    // is in the range of a float
+    const BoutReal clamped = std::min(std::max(data[i], -1e20), 1e20);
+    float_buffer[i] = roundMantissa(static_cast<float>(clamped), keep_bits);
+  }
+  return float_buffer.data();
+}
+
 void DataFormat::writeFieldAttributes(const std::string& name, const Field& f) {
   setAttribute(name, "cell_location", toString(f.getLocation()));
   setAttribute(name, "direction_y", toString(f.getDirectionY()));
@@ -9,6 +9,9 @@
 #include "impls/netcdf/nc_format.hxx"
 #include "impls/hdf5/h5_format.hxx"
 #include "impls/pnetcdf/pnetcdf.hxx"
+#include "impls/shared/shared_read.hxx"
+#include "impls/binary/bin_format.hxx"
+#include "impls/repartition/repartition.hxx"
 
 #include <boutexception.hxx>
 #include <output.hxx>
@@ -111,6 +114,13 @@ std::unique_ptr<DataFormat> FormatFactory::createDataFormat(const char *filename
   }
 #endif
 
+  // Always available, but not for parallel I/O
+  const char *bin_match[] = {"bin"};
+  if(matchString(s, 1, bin_match) != -1) {
+    output.write("\tUsing binary format for file '%s'\n", filename);
+    return bout::utils::make_unique<BinFormat>(mesh_in);
+  }
+
   throw BoutException("\tFile extension not recognised for '%s'\n", filename);
   return nullptr;
 }
@@ -131,3 +141,13 @@ int FormatFactory::matchString(const char *str, int n, const char **match) {
 std::unique_ptr<DataFormat> data_format(const char *filename) {
   return FormatFactory::getInstance()->createDataFormat(filename);
 }
+
+std::unique_ptr<DataFormat> shared_read_format(std::unique_ptr<DataFormat> format,
+                                               int group_size) {
+  return bout::utils::make_unique<SharedReadFormat>(std::move(format), group_size);
+}
+
+std::unique_ptr<DataFormat> repartition_format(std::unique_ptr<DataFormat> format,
+                                               Mesh* mesh) {
+  return bout::utils::make_unique<RepartitionFormat>(std::move(format), mesh);
+}
@@ -0,0 +1,752 @@
+#include "bin_format.hxx"
+
+#include <bout/mesh.hxx>
+#include <boutexception.hxx>
+#include <msg_stack.hxx>
+#include <output.hxx>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+/// The start of every file
+struct Header {
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t byte_order;
+  std::uint64_t index_offset;   ///< Bytes from the start of the file
+  std::uint64_t index_bytes;
+  std::uint64_t index_checksum;
+  std::uint64_t file_bytes;
+  std::uint64_t header_checksum; ///< Of everything above
+};
+
+constexpr char magic[8] = "BOUTBIN";
+constexpr std::uint64_t version = 1;
+/// Reads differently on a machine with a different byte order
+constexpr std::uint64_t byte_order = 0x0102030405060708;
+
+/// Each variable starts on a cache line, so copying it is fast
+constexpr std::size_t alignment = 64;
+std::size_t align(std::size_t offset) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// Fletcher-64 checksum of \p bytes bytes of \p data
+std::uint64_t checksum(const char* data, std::size_t bytes) {
+  constexpr std::uint64_t modulus = 0xffffffff;
+  // Words which can be summed before the sums could overflow
+  constexpr std::size_t block = 32768;
+
+  std::uint64_t a = 0, b = 0;
+  const std::size_t nwords = bytes / sizeof(std::uint32_t);
+  std::size_t i = 0;
+  while (i < nwords) {
+    const std::size_t end = std::min(nwords, i + block);
+    for (; i < end; ++i) {
+      std::uint32_t word;
+      std::memcpy(&word, data + i * sizeof(word), sizeof(word));
+      a += word;
+      b += a;
+    }
+    a %= modulus;
+    b %= modulus;
+  }
+
+  // Any bytes left over make a final, zero-padded, word
+  const std::size_t remainder = bytes % sizeof(std::uint32_t);
+  if (remainder != 0) {
+    std::uint32_t word = 0;
+    std::memcpy(&word, data + nwords * sizeof(word), remainder);
+    a = (a + word) % modulus;
+    b = (b + a) % modulus;
+  }
+
+  return (b << 32) | a;
+}
+
+void put(std::string& out, std::uint64_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put(std::string& out, const std::string& text) {
+  put(out, text.size());
+  out.append(text);
+}
+
+void putReal(std::string& out, BoutReal value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// Reads the index, throwing if it runs off the end
+class IndexReader {
+public:
+  IndexReader(const char* start, std::size_t bytes, const std::string& filename)
+      : position(start), end(start + bytes), filename(filename) {}
+
+  std::uint64_t get() {
+    std::uint64_t value;
+    copy(&value, sizeof(value));
+    return value;
+  }
+  int getInt() { return static_cast<int>(static_cast<std::int64_t>(get())); }
+  BoutReal getReal() {
+    BoutReal value;
+    copy(&value, sizeof(value));
+    return value;
+  }
+  std::string getString() {
+    const auto length = get();
+    check(length);
+    std::string text(position, length);
+    position += length;
+    return text;
+  }
+
+private:
+  const char* position;
+  const char* end;
+  const std::string& filename;
+
+  void check(std::uint64_t bytes) const {
+    if (bytes > static_cast<std::uint64_t>(end - position)) {
+      throw BoutException("The index of binary file '%s' is truncated", filename.c_str());
+    }
+  }
+  void copy(void* value, std::size_t bytes) {
+    check(bytes);
+    std::memcpy(value, position, bytes);
+    position += bytes;
+  }
+};
+
+/// Write all of \p parts to \p fd, which may take more than one call
+bool writeAll(int fd, std::array<iovec, 2> parts) {
+  std::size_t first = 0;
+  while (first < parts.size()) {
+    const auto written = ::writev(fd, &parts[first], parts.size() - first);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    auto remaining = static_cast<std::size_t>(written);
+    while (first < parts.size() and remaining >= parts[first].iov_len) {
+      remaining -= parts[first].iov_len;
+      ++first;
+    }
+    if (first < parts.size()) {
+      parts[first].iov_base = static_cast<char*>(parts[first].iov_base) + remaining;
+      parts[first].iov_len -= remaining;
+    }
+  }
+  return true;
+}
+
+/// A hyperslab of a variable, with missing dimensions of size 1
+struct Slab {
+  std::array<int, 3> shape, start, count;
+};
+
+/// The hyperslab of a variable of size \p dims with \p lengths from
+/// \p origin, following the DataFormat convention that unused
+/// lengths are 0. Returns false if it doesn't fit in the variable
+bool getSlab(const std::vector<int>& dims, const std::array<int, 3>& lengths,
+             const std::array<int, 3>& origin, Slab& slab) {
+  for (std::size_t i = 0; i < 3; ++i) {
+    if (i < dims.size()) {
+      slab.shape[i] = dims[i];
+      slab.start[i] = origin[i];
+      slab.count[i] = lengths[i];
+    } else {
+      if (lengths[i] > 1) {
+        return false;
+      }
+      slab.shape[i] = slab.count[i] = 1;
+      slab.start[i] = 0;
+    }
+    if (slab.start[i] < 0 or slab.count[i] < 0
+        or slab.start[i] + slab.count[i] > slab.shape[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Index of the start of Z-line \p i, \p j of \p slab in the variable
+std::size_t lineStart(const Slab& slab, int i, int j) {
+  return (static_cast<std::size_t>(slab.start[0] + i) * slab.shape[1] + slab.start[1] + j)
+             * slab.shape[2]
+         + slab.start[2];
+}
+
+/// Copy \p slab out of \p stored, converting from Stored to T
+template <typename Stored, typename T>
+void readSlab(const char* stored, T* out, const Slab& slab) {
+  for (int i = 0; i < slab.count[0]; ++i) {
+    for (int j = 0; j < slab.count[1]; ++j) {
+      const char* line = stored + lineStart(slab, i, j) * sizeof(Stored);
+      if (std::is_same<Stored, T>::value) {
+        std::memcpy(out, line, slab.count[2] * sizeof(T));
+        out += slab.count[2];
+      } else {
+        for (int k = 0; k < slab.count[2]; ++k) {
+          Stored value;
+          std::memcpy(&value, line + k * sizeof(Stored), sizeof(Stored));
+          *out++ = static_cast<T>(value);
+        }
+      }
+    }
+  }
+}
+
+/// Copy into \p slab of \p stored, converting from T to Stored
+template <typename Stored, typename T>
+void writeSlab(char* stored, const T* in, const Slab& slab) {
+  for (int i = 0; i < slab.count[0]; ++i) {
+    for (int j = 0; j < slab.count[1]; ++j) {
+      char* line = stored + lineStart(slab, i, j) * sizeof(Stored);
+      if (std::is_same<Stored, T>::value) {
+        std::memcpy(line, in, slab.count[2] * sizeof(T));
+        in += slab.count[2];
+      } else {
+        for (int k = 0; k < slab.count[2]; ++k) {
+          const auto value = static_cast<Stored>(*in++);
+          std::memcpy(line + k * sizeof(Stored), &value, sizeof(Stored));
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+BinFormat::~BinFormat() {
+  try {
+    close();
+  } catch (const BoutException& e) {
+    // Can't throw from a destructor
+    output_error.write("Error closing binary file '%s': %s\n", filename.c_str(),
+                       e.what());
+  }
+}
+
+bool BinFormat::openr(const char* name) {
+  TRACE("BinFormat::openr");
+
+  close();
+
+  if (!mapFile(name)) {
+    return false;
+  }
+  filename = name;
+  mode = Mode::reading;
+  return true;
+}
+
+bool BinFormat::openw(const char* name, bool append) {
+  TRACE("BinFormat::openw");
+
+  close();
+  filename = name;
+
+  std::size_t data_end = sizeof(Header);
+  if (append and mapFile(name)) {
+    // Keep the existing variables where they are, until they are written
+    for (auto& item : variables) {
+      auto& var = item.second;
+      var.old = mapping + var.offset;
+      data_end = std::max(data_end, var.offset + var.bytes);
+    }
+  }
+  image.resize(align(data_end));
+
+  mode = Mode::writing;
+  return true;
+}
+
+void BinFormat::close() {
+  if (mode == Mode::writing) {
+    writeFile();
+  }
+  mode = Mode::closed;
+
+  unmapFile();
+  variables.clear();
+  text_attributes.clear();
+  int_attributes.clear();
+  real_attributes.clear();
+  std::vector<char>().swap(image);
+}
+
+void BinFormat::flush() {
+  if (mode == Mode::writing) {
+    writeFile();
+  }
+}
+
+bool BinFormat::mapFile(const std::string& name) {
+  const int fd = ::open(name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0 or status.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+  const auto bytes = static_cast<std::size_t>(status.st_size);
+
+  void* start = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (start == MAP_FAILED) {
+    return false;
+  }
+  // Restart files are read all the way through, so start reading now
+  ::posix_madvise(start, bytes, POSIX_MADV_WILLNEED);
+
+  mapping = static_cast<const char*>(start);
+  mapping_bytes = bytes;
+
+  try {
+    Header header;
+    if (bytes < sizeof(header)) {
+      throw BoutException("'%s' is too short to be a binary BOUT++ file", name.c_str());
+    }
+    std::memcpy(&header, mapping, sizeof(header));
+
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+      throw BoutException("'%s' is not a binary BOUT++ file", name.c_str());
+    }
+    if (header.byte_order != byte_order) {
+      throw BoutException("Binary file '%s' was written on a machine with a different "
+                          "byte order",
+                          name.c_str());
+    }
+    if (header.version != version) {
+      throw BoutException("Binary file '%s' has version %d, but only version %d can be "
+                          "read",
+                          name.c_str(), static_cast<int>(header.version),
+                          static_cast<int>(version));
+    }
+    if (header.header_checksum
+        != checksum(mapping, offsetof(Header, header_checksum))) {
+      throw BoutException("The header of binary file '%s' is corrupted", name.c_str());
+    }
+    if (header.file_bytes != bytes or header.index_offset > bytes
+        or header.index_bytes != bytes - header.index_offset) {
+      throw BoutException("Binary file '%s' is truncated: expected %lu bytes, found %lu",
+                          name.c_str(), static_cast<unsigned long>(header.file_bytes),
+                          static_cast<unsigned long>(bytes));
+    }
+    const char* index = mapping + header.index_offset;
+    if (header.index_checksum != checksum(index, header.index_bytes)) {
+      throw BoutException("The index of binary file '%s' is corrupted", name.c_str());
+    }
+
+    IndexReader reader{index, header.index_bytes, name};
+
+    variables.clear();
+    const auto nvars = reader.get();
+    for (std::uint64_t i = 0; i < nvars; ++i) {
+      const auto varname = reader.getString();
+      Variable var;
+      var.real = (reader.get() != 0);
+      var.dims.resize(reader.get());
+      std::size_t size = var.real ? sizeof(BoutReal) : sizeof(int);
+      for (auto& dim : var.dims) {
+        dim = reader.getInt();
+        size *= dim;
+      }
+      var.offset = reader.get();
+      var.bytes = reader.get();
+      var.checksum = reader.get();
+
+      if (var.bytes != size or var.offset < sizeof(Header)
+          or var.offset + var.bytes > header.index_offset) {
+        throw BoutException("Variable '%s' in binary file '%s' is the wrong size",
+                            varname.c_str(), name.c_str());
+      }
+      variables[varname] = var;
+    }
+
+    for (auto n = reader.get(); n > 0; --n) {
+      auto varname = reader.getString();
+      auto attrname = reader.getString();
+      text_attributes[{varname, attrname}] = reader.getString();
+    }
+    for (auto n = reader.get(); n > 0; --n) {
+      auto varname = reader.getString();
+      auto attrname = reader.getString();
+      int_attributes[{varname, attrname}] = reader.getInt();
+    }
+    for (auto n = reader.get(); n > 0; --n) {
+      auto varname = reader.getString();
+      auto attrname = reader.getString();
+      real_attributes[{varname, attrname}] = reader.getReal();
+    }
+  } catch (...) {
+    unmapFile();
+    throw;
+  }
+  return true;
+}
+
+void BinFormat::unmapFile() {
+  if (mapping != nullptr) {
+    ::munmap(const_cast<char*>(mapping), mapping_bytes);
+  }
+  mapping = nullptr;
+  mapping_bytes = 0;
+}
+
+void BinFormat::writeFile() {
+  TRACE("BinFormat::writeFile");
+
+  std::string index;
+  put(index, variables.size());
+  for (auto& item : variables) {
+    auto& var = item.second;
+    char* stored = &image[var.offset];
+    if (var.old != nullptr) {
+      // Never written, so keep what was in the existing file
+      std::memcpy(stored, data(item.first, var), var.bytes);
+      var.old = nullptr;
+    }
+    var.checksum = checksum(stored, var.bytes);
+    var.checked = true;
+
+    put(index, item.first);
+    put(index, var.real ? 1 : 0);
+    put(index, var.dims.size());
+    for (const auto& dim : var.dims) {
+      put(index, static_cast<std::uint64_t>(dim));
+    }
+    put(index, var.offset);
+    put(index, var.bytes);
+    put(index, var.checksum);
+  }
+
+  put(index, text_attributes.size());
+  for (const auto& attribute : text_attributes) {
+    put(index, attribute.first.first);
+    put(index, attribute.first.second);
+    put(index, attribute.second);
+  }
+  put(index, int_attributes.size());
+  for (const auto& attribute : int_attributes) {
+    put(index, attribute.first.first);
+    put(index, attribute.first.second);
+    put(index, static_cast<std::uint64_t>(static_cast<std::int64_t>(attribute.second)));
+  }
+  put(index, real_attributes.size());
+  for (const auto& attribute : real_attributes) {
+    put(index, attribute.first.first);
+    put(index, attribute.first.second);
+    putReal(index, attribute.second);
+  }
+
+  Header header;
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.byte_order = byte_order;
+  header.index_offset = image.size();
+  header.index_bytes = index.size();
+  header.index_checksum = checksum(index.data(), index.size());
+  header.file_bytes = image.size() + index.size();
+  header.header_checksum = checksum(reinterpret_cast<const char*>(&header),
+                                    offsetof(Header, header_checksum));
+  std::memcpy(image.data(), &header, sizeof(header));
+
+  // Write a new file and then replace the old one, so that the old
+  // one is still there if anything goes wrong
+  const std::string temporary = filename + ".tmp";
+  const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw BoutException("Couldn't open '%s' for writing: %s", temporary.c_str(),
+                        std::strerror(errno));
+  }
+
+  const bool written = writeAll(fd, {{{image.data(), image.size()},
+                                      {&index[0], index.size()}}});
+  const int error = errno;
+  if ((::close(fd) != 0) or not written) {
+    std::remove(temporary.c_str());
+    throw BoutException("Couldn't write binary file '%s': %s", temporary.c_str(),
+                        std::strerror(written ? errno : error));
+  }
+
+  if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+    throw BoutException("Couldn't replace '%s' with '%s': %s", filename.c_str(),
+                        temporary.c_str(), std::strerror(errno));
+  }
+}
+
+const char* BinFormat::data(const std::string& name, Variable& var) {
+  const char* stored = nullptr;
+  if (mode == Mode::reading) {
+    stored = mapping + var.offset;
+  } else if (var.old != nullptr) {
+    stored = var.old;
+  } else {
+    return &image[var.offset];
+  }
+
+  if (not var.checked) {
+    if (checksum(stored, var.bytes) != var.checksum) {
+      throw BoutException("Variable '%s' in binary file '%s' is corrupted: its checksum "
+                          "doesn't match",
+                          name.c_str(), filename.c_str());
+    }
+    var.checked = true;
+  }
+  return stored;
+}
+
+const std::vector<int> BinFormat::getSize(const std::string& var) {
+  if (mode == Mode::closed) {
+    return {};
+  }
+
+  const auto found = variables.find(var);
+  if (found == variables.end()) {
+    return {};
+  }
+  if (found->second.dims.empty()) {
+    // Scalars have size 1, as for the other formats
+    return {1};
+  }
+  return found->second.dims;
+}
+
+bool BinFormat::setGlobalOrigin(int x, int y, int z) {
+  x0 = x;
+  y0 = y;
+  z0 = z;
+  return true;
+}
+
+bool BinFormat::addVar(const std::string& name, bool repeat, bool real,
+                       std::vector<int> dims) {
+  if (mode != Mode::writing) {
+    return false;
+  }
+  if (repeat) {
+    output_error.write("Binary files can't store time-dependent variables, such as '%s'\n",
+                       name.c_str());
+    return false;
+  }
+
+  const auto found = variables.find(name);
+  if (found != variables.end()) {
+    // Already in the file, which is fine if it's the same shape
+    return found->second.real == real and found->second.dims == dims;
+  }
+
+  Variable var;
+  var.real = real;
+  var.dims = std::move(dims);
+  var.bytes = real ? sizeof(BoutReal) : sizeof(int);
+  for (const auto& dim : var.dims) {
+    var.bytes *= dim;
+  }
+  var.offset = image.size();
+  image.resize(align(var.offset + var.bytes));
+
+  variables[name] = var;
+  return true;
+}
+
+bool BinFormat::addVarInt(const std::string& name, bool repeat) {
+  return addVar(name, repeat, false, {});
+}
+
+bool BinFormat::addVarBoutReal(const std::string& name, bool repeat) {
+  return addVar(name, repeat, true, {});
+}
+
+bool BinFormat::addVarField2D(const std::string& name, bool repeat) {
+  ASSERT1(mesh != nullptr);
+  return addVar(name, repeat, true, {mesh->LocalNx, mesh->LocalNy});
+}
+
+bool BinFormat::addVarField3D(const std::string& name, bool repeat) {
+  ASSERT1(mesh != nullptr);
+  return addVar(name, repeat, true, {mesh->LocalNx, mesh->LocalNy, mesh->LocalNz});
+}
+
+bool BinFormat::addVarFieldPerp(const std::string& name, bool repeat) {
+  ASSERT1(mesh != nullptr);
+  return addVar(name, repeat, true, {mesh->LocalNx, mesh->LocalNz});
+}
+
+template <typename T>
+bool BinFormat::readVar(T* var, const std::string& name, Lengths lengths,
+                        Lengths origin) {
+  if (mode == Mode::closed) {
+    return false;
+  }
+
+  const auto found = variables.find(name);
+  if (found == variables.end()) {
+    return false;
+  }
+
+  Slab slab;
+  if (not getSlab(found->second.dims, lengths, origin, slab)) {
+    return false;
+  }
+
+  const char* stored = data(name, found->second);
+  if (found->second.real) {
+    readSlab<BoutReal>(stored, var, slab);
+  } else {
+    readSlab<int>(stored, var, slab);
+  }
+  return true;
+}
+
+template <typename T>
+bool BinFormat::writeVar(const T* var, const std::string& name, Lengths lengths,
+                         Lengths origin) {
+  if (mode != Mode::writing) {
+    return false;
+  }
+
+  auto found = variables.find(name);
+  if (found == variables.end()) {
+    // Not added, so add it with the size of what is being written
+    std::vector<int> dims;
+    const int nd = (lengths[2] > 0) ? 3 : (lengths[1] > 0) ? 2 : (lengths[0] > 0) ? 1 : 0;
+    for (int i = 0; i < nd; ++i) {
+      dims.push_back(origin[i] + lengths[i]);
+    }
+    if (not addVar(name, false, std::is_same<T, BoutReal>::value, dims)) {
+      return false;
+    }
+    found = variables.find(name);
+  }
+  auto& stored = found->second;
+
+  Slab slab;
+  if (not getSlab(stored.dims, lengths, origin, slab)) {
+    return false;
+  }
+
+  char* destination = &image[stored.offset];
+  if (stored.old != nullptr) {
+    if (slab.count != slab.shape) {
+      // Only part is being written, so keep the rest
+      std::memcpy(destination, data(name, stored), stored.bytes);
+    }
+    stored.old = nullptr;
+  }
+
+  if (stored.real) {
+    writeSlab<BoutReal>(destination, var, slab);
+  } else {
+    writeSlab<int>(destination, var, slab);
+  }
+  return true;
+}
+
+bool BinFormat::read(int* var, const std::string& name, int lx, int ly, int lz) {
+  TRACE("BinFormat::read(int)");
+  return readVar(var, name, {lx, ly, lz}, {x0, y0, z0});
+}
+
+bool BinFormat::read(BoutReal* var, const std::string& name, int lx, int ly, int lz) {
+  TRACE("BinFormat::read(BoutReal)");
+  return readVar(var, name, {lx, ly, lz}, {x0, y0, z0});
+}
+
+bool BinFormat::read_perp(BoutReal* var, const std::string& name, int lx, int lz) {
+  TRACE("BinFormat::read_perp");
+  return readVar(var, name, {lx, lz, 0}, {x0, z0, 0});
+}
+
+bool BinFormat::write(int* var, const std::string& name, int lx, int ly, int lz) {
+  TRACE("BinFormat::write(int)");
+  return writeVar(var, name, {lx, ly, lz}, {x0, y0, z0});
+}
+
+bool BinFormat::write(BoutReal* var, const std::string& name, int lx, int ly, int lz) {
+  TRACE("BinFormat::write(BoutReal)");
+  return writeVar(var, name, {lx, ly, lz}, {x0, y0, z0});
+}
+
+bool BinFormat::write_perp(BoutReal* var, const std::string& name, int lx, int lz) {
+  TRACE("BinFormat::write_perp");
+  return writeVar(var, name, {lx, lz, 0}, {x0, z0, 0});
+}
+
+void BinFormat::setAttribute(const std::string& varname, const std::string& attrname,
+                             const std::string& text) {
+  if (mode != Mode::writing) {
+    throw BoutException("Can't set attribute '%s' of '%s': binary file not open for "
+                        "writing",
+                        attrname.c_str(), varname.c_str());
+  }
+  text_attributes[{varname, attrname}] = text;
+}
+
+void BinFormat::setAttribute(const std::string& varname, const std::string& attrname,
+                             int value) {
+  if (mode != Mode::writing) {
+    throw BoutException("Can't set attribute '%s' of '%s': binary file not open for "
+                        "writing",
+                        attrname.c_str(), varname.c_str());
+  }
+  int_attributes[{varname, attrname}] = value;
+}
+
+void BinFormat::setAttribute(const std::string& varname, const std::string& attrname,
+                             BoutReal value) {
+  if (mode != Mode::writing) {
+    throw BoutException("Can't set attribute '%s' of '%s': binary file not open for "
+                        "writing",
+                        attrname.c_str(), varname.c_str());
+  }
+  real_attributes[{varname, attrname}] = value;
+}
+
+bool BinFormat::getAttribute(const std::string& varname, const std::string& attrname,
+                             std::string& text) {
+  const auto found = text_attributes.find({varname, attrname});
+  if (found == text_attributes.end()) {
+    return false;
+  }
+  text = found->second;
+  return true;
+}
+
+bool BinFormat::getAttribute(const std::string& varname, const std::string& attrname,
+                             int& value) {
+  const auto found = int_attributes.find({varname, attrname});
+  if (found == int_attributes.end()) {
+    return false;
+  }
+  value = found->second;
+  return true;
+}
+
+bool BinFormat::getAttribute(const std::string& varname, const std::string& attrname,
+                             BoutReal& value) {
+  const auto found = real_attributes.find({varname, attrname});
+  if (found == real_attributes.end()) {
+    return false;
+  }
+  value = found->second;
+  return true;
+}
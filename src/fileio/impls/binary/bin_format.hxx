@@ -0,0 +1,227 @@
+/*!
+ * \file bin_format.hxx
+ *
+ * \brief Native binary data format, for fast restart files
+ *
+ * Files have a fixed header, then the data of every variable one
+ * after another, then an index of the variables and attributes. The
+ * header and index, and the data of each variable, have checksums
+ * which are checked when the file is read.
+ *
+ * While the file is open for writing, the whole file is kept in
+ * memory, and written with a single large write when it is closed
+ * or flushed. The new file is written next to the old one and then
+ * renamed, so a crash while writing leaves the old file intact.
+ * Files are read by mapping them into memory, so reading a variable
+ * is a single copy out of the page cache.
+ *
+ * Only variables without a time dimension can be stored, which is
+ * what restart files need, and values are always stored in full
+ * precision. Data is stored in the byte order of the machine, and
+ * files from a machine with a different byte order are rejected.
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+class BinFormat;
+
+#ifndef __BINFORMAT_H__
+#define __BINFORMAT_H__
+
+#include "dataformat.hxx"
+#include "unused.hxx"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class BinFormat : public DataFormat {
+public:
+  BinFormat(Mesh* mesh_in = nullptr) : DataFormat(mesh_in) {}
+  ~BinFormat() override;
+
+  using DataFormat::openr;
+  bool openr(const char* name) override;
+  using DataFormat::openw;
+  bool openw(const char* name, bool append = false) override;
+
+  bool is_valid() override { return mode != Mode::closed; }
+
+  void close() override;
+
+  /// Write the file now, keeping it open
+  void flush() override;
+
+  const std::vector<int> getSize(const char* var) override {
+    return getSize(std::string(var));
+  }
+  const std::vector<int> getSize(const std::string& var) override;
+
+  bool setGlobalOrigin(int x = 0, int y = 0, int z = 0) override;
+  /// There are no records, so this does nothing
+  bool setRecord(int UNUSED(t)) override { return true; }
+
+  bool addVarInt(const std::string& name, bool repeat) override;
+  bool addVarBoutReal(const std::string& name, bool repeat) override;
+  bool addVarField2D(const std::string& name, bool repeat) override;
+  bool addVarField3D(const std::string& name, bool repeat) override;
+  bool addVarFieldPerp(const std::string& name, bool repeat) override;
+
+  bool read(int* var, const char* name, int lx = 1, int ly = 0, int lz = 0) override {
+    return read(var, std::string(name), lx, ly, lz);
+  }
+  bool read(int* var, const std::string& name, int lx = 1, int ly = 0,
+            int lz = 0) override;
+  bool read(BoutReal* var, const char* name, int lx = 1, int ly = 0,
+            int lz = 0) override {
+    return read(var, std::string(name), lx, ly, lz);
+  }
+  bool read(BoutReal* var, const std::string& name, int lx = 1, int ly = 0,
+            int lz = 0) override;
+  bool read_perp(BoutReal* var, const std::string& name, int lx = 1,
+                 int lz = 0) override;
+
+  bool write(int* var, const char* name, int lx = 0, int ly = 0, int lz = 0) override {
+    return write(var, std::string(name), lx, ly, lz);
+  }
+  bool write(int* var, const std::string& name, int lx = 0, int ly = 0,
+             int lz = 0) override;
+  bool write(BoutReal* var, const char* name, int lx = 0, int ly = 0,
+             int lz = 0) override {
+    return write(var, std::string(name), lx, ly, lz);
+  }
+  bool write(BoutReal* var, const std::string& name, int lx = 0, int ly = 0,
+             int lz = 0) override;
+  bool write_perp(BoutReal* var, const std::string& name, int lx = 0,
+                  int lz = 0) override;
+
+  // No time-dependent variables
+  bool read_rec(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 1,
+                int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 1,
+                int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 1,
+                int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                int UNUSED(lx) = 1, int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                     int UNUSED(lx) = 1, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  bool write_rec(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                 int UNUSED(lx) = 0, int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                      int UNUSED(lx) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    const std::string& text) override;
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    int value) override;
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    BoutReal value) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    std::string& text) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    int& value) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    BoutReal& value) override;
+
+private:
+  enum class Mode { closed, reading, writing };
+  Mode mode{Mode::closed};
+
+  std::string filename;
+
+  int x0{0}, y0{0}, z0{0};
+
+  struct Variable {
+    bool real{true};             ///< BoutReal, or int
+    std::vector<int> dims;       ///< Empty for scalars
+    std::size_t offset{0};       ///< Bytes from the start of the file
+    std::size_t bytes{0};        ///< Size of the data
+    std::uint64_t checksum{0};   ///< Of the data in the existing file
+    bool checked{false};         ///< Has the checksum been checked?
+    const char* old{nullptr};    ///< When appending: the data in the existing file,
+                                 ///< until this variable is written
+  };
+  std::map<std::string, Variable> variables;
+
+  using AttributeKey = std::pair<std::string, std::string>;
+  std::map<AttributeKey, std::string> text_attributes;
+  std::map<AttributeKey, int> int_attributes;
+  std::map<AttributeKey, BoutReal> real_attributes;
+
+  /// The existing file, mapped into memory when reading or appending
+  const char* mapping{nullptr};
+  std::size_t mapping_bytes{0};
+
+  /// When writing: the header and data of the new file
+  std::vector<char> image;
+
+  /// Map \p name into memory, check the header and index, and read
+  /// the index. Returns false if the file can't be opened
+  bool mapFile(const std::string& name);
+  void unmapFile();
+
+  /// Add a variable of shape \p dims to the end of image
+  bool addVar(const std::string& name, bool repeat, bool real, std::vector<int> dims);
+
+  /// Write image and the index to the file
+  void writeFile();
+
+  /// The data of \p var, checking it against its checksum the first
+  /// time it is read from the existing file
+  const char* data(const std::string& name, Variable& var);
+
+  using Lengths = std::array<int, 3>;
+
+  template <typename T>
+  bool readVar(T* var, const std::string& name, Lengths lengths, Lengths origin);
+  template <typename T>
+  bool writeVar(const T* var, const std::string& name, Lengths lengths, Lengths origin);
+};
+
+#endif // __BINFORMAT_H__
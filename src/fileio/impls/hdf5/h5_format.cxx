@@ -28,6 +28,7 @@
 #include <utils.hxx>
 #include <cmath>
 #include <string>
+#include <vector>
 #include <mpi.h>
 
 #include <bout/mesh.hxx>
@@ -41,7 +42,6 @@ H5Format::H5Format(bool parallel_in, Mesh* mesh_in) : DataFormat(mesh_in) {
   lowPrecision = false;
   fname = nullptr;
   dataFile = -1;
-  chunk_length = 10; // could change this to try to optimize IO performance (i.e. allocate new chunks of disk space less often)
   
   dataFile_plist = H5Pcreate(H5P_FILE_ACCESS);
   if (dataFile_plist < 0)
@@ -58,9 +58,10 @@ H5Format::H5Format(bool parallel_in, Mesh* mesh_in) : DataFormat(mesh_in) {
     throw BoutException("Failed to create dataSet_plist");
 
 #ifdef PHDF5
+  // Collective writes, so that the MPI-IO layer can combine the
+  // pieces from each processor. Every processor writes every variable
   if (parallel)
-    if (H5Pset_dxpl_mpio(dataSet_plist, H5FD_MPIO_INDEPENDENT) < 0) // Default, independent writes
-//     if (H5Pset_dxpl_mpio(dataSet_plist, H5FD_MPIO_COLLECTIVE) < 0) // Alternative, collective writes
+    if (H5Pset_dxpl_mpio(dataSet_plist, H5FD_MPIO_COLLECTIVE) < 0)
       throw BoutException("Failed to set dataSet_plist");
 #endif
 
@@ -77,7 +78,6 @@ H5Format::H5Format(const char *name, bool parallel_in, Mesh* mesh_in)
   lowPrecision = false;
   fname = nullptr;
   dataFile = -1;
-  chunk_length = 10; // could change this to try to optimize IO performance (i.e. allocate new chunks of disk space less often)
   
   dataFile_plist = H5Pcreate(H5P_FILE_ACCESS);
   if (dataFile_plist < 0)
@@ -147,12 +147,32 @@ bool H5Format::openw(const char *name, bool append) {
   return true;
 }
 
+bool H5Format::openr(const std::string &base, int mype) {
+  if (parallel) {
+    // All processors share the same file
+    return openr(base.c_str());
+  }
+  return DataFormat::openr(base, mype);
+}
+
+bool H5Format::openw(const std::string &base, int mype, bool append) {
+  if (parallel) {
+    // All processors share the same file
+    return openw(base.c_str(), append);
+  }
+  return DataFormat::openw(base, mype, append);
+}
+
 bool H5Format::is_valid() { return dataFile >= 0; }
 
 void H5Format::close() {
   TRACE("H5Format::close");
   
   if (H5Format::is_valid()) {
+    for (const auto& dataset : datasets) {
+      H5Dclose(dataset.second);
+    }
+    datasets.clear();
     H5Fclose(dataFile);
     dataFile = -1;
   }
@@ -167,6 +187,19 @@ void H5Format::flush() {
   }
 }
 
+hid_t H5Format::getDataSet(const std::string& name) {
+  const auto found = datasets.find(name);
+  if (found != datasets.end()) {
+    return found->second;
+  }
+
+  hid_t dataSet = H5Dopen(dataFile, name.c_str(), H5P_DEFAULT);
+  if (dataSet >= 0) {
+    datasets[name] = dataSet;
+  }
+  return dataSet;
+}
+
 const std::vector<int> H5Format::getSize(const char *name) {
   TRACE("H5Format::getSize");
 
@@ -250,10 +283,8 @@ bool H5Format::setRecord(int t) {
 // Add a variable to the file
 bool H5Format::addVar(const std::string &name, bool repeat, hid_t write_hdf5_type,
     std::string datatype) {
-  hid_t dataSet = H5Dopen(dataFile, name.c_str(), H5P_DEFAULT);
+  hid_t dataSet = getDataSet(name);
   if (dataSet >= 0) { // >=0 means variable already exists, so return.
-    if (H5Dclose(dataSet) < 0)
-      throw BoutException("Failed to close dataSet");
     return true;
   }
 
@@ -293,14 +324,9 @@ bool H5Format::addVar(const std::string &name, bool repeat, hid_t write_hdf5_typ
     }
 
     // Modify dataset creation properties, i.e. enable chunking.
-    hid_t propertyList = H5Pcreate(H5P_DATASET_CREATE);
-    if (propertyList < 0)
-      throw BoutException("Failed to create propertyList");
-    hsize_t chunk_dims[4],max_dims[4];
+    hid_t propertyList = createProperties(nd, init_size, true, write_hdf5_type);
+    hsize_t max_dims[4];
     max_dims[0] = H5S_UNLIMITED; max_dims[1]=init_size[1]; max_dims[2]=init_size[2]; max_dims[3]=init_size[3];
-    chunk_dims[0] = chunk_length; chunk_dims[1]=init_size[1]; chunk_dims[2]=init_size[2]; chunk_dims[3]=init_size[3];
-    if (H5Pset_chunk(propertyList, nd, chunk_dims) < 0)
-      throw BoutException("Failed to set chunk property");
 
     hid_t init_space = H5Screate_simple(nd, init_size, max_dims);
     if (init_space < 0)
@@ -348,9 +374,9 @@ bool H5Format::addVar(const std::string &name, bool repeat, hid_t write_hdf5_typ
       if (parallel) {
         init_size[0] = mesh->GlobalNx - 2 * mesh->xstart;
         if (datatype == "FieldPerp") {
-          init_size[1] = mesh->GlobalNy - 2 * mesh->ystart;
-        } else {
           init_size[1] = mesh->GlobalNz;
+        } else {
+          init_size[1] = mesh->GlobalNy - 2 * mesh->ystart;
         }
         init_size[2] = mesh->GlobalNz;
       } else {
@@ -374,20 +400,70 @@ bool H5Format::addVar(const std::string &name, bool repeat, hid_t write_hdf5_typ
       hid_t init_space = H5Screate_simple(nd, init_size, init_size);
       if (init_space < 0)
         throw BoutException("Failed to create init_space");
-      dataSet = H5Dcreate(dataFile, name.c_str(), write_hdf5_type, init_space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      hid_t propertyList = createProperties(nd, init_size, false, write_hdf5_type);
+      dataSet = H5Dcreate(dataFile, name.c_str(), write_hdf5_type, init_space, H5P_DEFAULT, propertyList, H5P_DEFAULT);
       if (dataSet < 0)
         throw BoutException("Failed to create dataSet");
+      if (H5Pclose(propertyList) < 0)
+        throw BoutException("Failed to close propertyList");
 
       // Add attribute to say what kind of field this is
       setAttribute(dataSet, "bout_type", datatype);
     }
   }
 
-  if (H5Dclose(dataSet) < 0)
-    throw BoutException("Failed to close dataSet");
+  // Keep open for writing
+  datasets[name] = dataSet;
   return true;
 }
 
+hid_t H5Format::createProperties(int nd, const hsize_t* dims, bool repeat,
+                                 hid_t hdf5_type) {
+  hid_t propertyList = H5Pcreate(H5P_DATASET_CREATE);
+  if (propertyList < 0)
+    throw BoutException("Failed to create propertyList");
+
+  // Time-dependent variables must be chunked so that they can be
+  // extended, others only if they are compressed
+  if (not repeat and storage.deflate_level == 0)
+    return propertyList;
+
+  const auto chunks = chunkShape(std::vector<std::size_t>(dims, dims + nd), repeat,
+                                 H5Tget_size(hdf5_type));
+  const std::vector<hsize_t> chunk_dims(chunks.begin(), chunks.end());
+  if (H5Pset_chunk(propertyList, nd, chunk_dims.data()) < 0)
+    throw BoutException("Failed to set chunk property");
+
+  if (storage.deflate_level > 0) {
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+      throw BoutException("HDF5 deflate compression is not available");
+    if (storage.shuffle and H5Pset_shuffle(propertyList) < 0)
+      throw BoutException("Failed to set shuffle filter");
+    if (H5Pset_deflate(propertyList, storage.deflate_level) < 0)
+      throw BoutException("Failed to set deflate filter");
+  }
+
+  return propertyList;
+}
+
+int H5Format::localSize(int lx, int ly, int lz) const {
+  if (lz != 0)
+    return mesh->LocalNx * mesh->LocalNy * mesh->LocalNz;
+  if (ly != 0)
+    return mesh->LocalNx * mesh->LocalNy;
+  if (lx != 0)
+    return mesh->LocalNx;
+  return 1;
+}
+
+int H5Format::localSizePerp(int lx, int lz) const {
+  if (lz != 0)
+    return mesh->LocalNx * mesh->LocalNz;
+  if (lx != 0)
+    return mesh->LocalNx;
+  return 1;
+}
+
 bool H5Format::addVarInt(const std::string &name, bool repeat) {
   return addVar(name, repeat, H5T_NATIVE_INT, "scalar");
 }
@@ -448,14 +524,28 @@ bool H5Format::read(void *data, hid_t hdf5_type, const char *name, int lx, int l
   offset_local[1]=y0_local;
   offset_local[2]=z0_local;
 
-  // Want to be able to use without needing mesh to be initialised; makes hyperslab selection redundant
-  init_size_local[0]=offset_local[0]+counts[0];
-  init_size_local[1]=offset_local[1]+counts[1];
-  init_size_local[2]=offset_local[2]+counts[2];
-  
+  // With a local origin, e.g. for parallel files which don't include
+  // the guard cells, only part of a whole local field is read, as in
+  // read_rec(). Otherwise the memory is just the points read, so this
+  // can be used without the mesh, and for arrays of other shapes
+  const bool local_origin = (x0_local != 0) or (y0_local != 0) or (z0_local != 0);
+  if (local_origin) {
+    init_size_local[0] = mesh->LocalNx;
+    init_size_local[1] = mesh->LocalNy;
+    init_size_local[2] = mesh->LocalNz;
+  } else {
+    init_size_local[0] = counts[0];
+    init_size_local[1] = counts[1];
+    init_size_local[2] = counts[2];
+  }
+
   hid_t mem_space = H5Screate_simple(nd, init_size_local, init_size_local);
   if (mem_space < 0)
     throw BoutException("Failed to create mem_space");
+  if (local_origin
+      and H5Sselect_hyperslab(mem_space, H5S_SELECT_SET, offset_local, /*stride=*/nullptr,
+                              counts, /*block=*/nullptr) < 0)
+    throw BoutException("Failed to select hyperslab");
 
   hid_t dataSet = H5Dopen(dataFile, name, H5P_DEFAULT);
   if (dataSet < 0) {
@@ -503,13 +593,23 @@ bool H5Format::read_perp(BoutReal *data, const std::string& name, int lx, int lz
   offset_local[0]=x0_local;
   offset_local[1]=z0_local;
 
-  // Want to be able to use without needing mesh to be initialised; makes hyperslab selection redundant
-  init_size_local[0]=offset_local[0]+counts[0];
-  init_size_local[1]=offset_local[1]+counts[1];
+  // Only part of a whole local FieldPerp with a local origin, as in read()
+  const bool local_origin = (x0_local != 0) or (z0_local != 0);
+  if (local_origin) {
+    init_size_local[0] = mesh->LocalNx;
+    init_size_local[1] = mesh->LocalNz;
+  } else {
+    init_size_local[0] = counts[0];
+    init_size_local[1] = counts[1];
+  }
 
   hid_t mem_space = H5Screate_simple(nd, init_size_local, init_size_local);
   if (mem_space < 0)
     throw BoutException("Failed to create mem_space");
+  if (local_origin
+      and H5Sselect_hyperslab(mem_space, H5S_SELECT_SET, offset_local, /*stride=*/nullptr,
+                              counts, /*block=*/nullptr) < 0)
+    throw BoutException("Failed to select hyperslab");
 
   hid_t dataSet = H5Dopen(dataFile, name.c_str(), H5P_DEFAULT);
   if (dataSet < 0) {
@@ -548,27 +648,12 @@ bool H5Format::write(int *var, const std::string &name, int lx, int ly, int lz)
 bool H5Format::write(BoutReal *data, const char *name, int lx, int ly, int lz) {
   
   if(lowPrecision) {
-    // An out of range value can make the conversion
-    // corrupt the whole dataset. Make sure everything
-    // is in the range of a float
-    int i_max=1;
-    if (lx>0) i_max*=lx;
-    if (ly>0) i_max*=ly;
-    if (lz>0) i_max*=lz;
-    
-    for(int i=0;i<i_max;i++) {
-      if(data[i] > 1e20)
-        data[i] = 1e20;
-      if(data[i] < -1e20)
-        data[i] = -1e20;
-    }
-    
-    return write(data, H5T_NATIVE_DOUBLE, name, lx, ly, lz);
+    // Convert in a separate buffer, so that data is not changed
+    return write(toFloat(data, localSize(lx, ly, lz)), H5T_NATIVE_FLOAT, name, lx, ly,
+                 lz);
   }
-  else {
-    return write(data, H5T_NATIVE_DOUBLE, name, lx, ly, lz);
-  }
-  
+
+  return write(data, H5T_NATIVE_DOUBLE, name, lx, ly, lz);
 }
 
 bool H5Format::write(BoutReal *var, const std::string &name, int lx, int ly, int lz) {
@@ -619,7 +704,7 @@ bool H5Format::write(void *data, hid_t mem_hdf5_type, const char *name, int lx,
                           counts, /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
   
-  hid_t dataSet = H5Dopen(dataFile, name, H5P_DEFAULT);
+  hid_t dataSet = getDataSet(name);
   if (dataSet < 0) {
     output_error.write("ERROR: HDF5 variable '%s' has not been added to file '%s'\n", name, fname);
     return false;
@@ -639,8 +724,6 @@ bool H5Format::write(void *data, hid_t mem_hdf5_type, const char *name, int lx,
     throw BoutException("Failed to close mem_space");
   if (H5Sclose(dataSpace) < 0)
     throw BoutException("Failed to close dataSpace");
-  if (H5Dclose(dataSet) < 0)
-    throw BoutException("Failed to close dataSet");
 
   return true;
 }
@@ -656,6 +739,13 @@ bool H5Format::write_perp(BoutReal *data, const std::string& name, int lx, int l
   if((lx < 0) || (lz < 0))
     return false;
 
+  void* values = data;
+  if (lowPrecision) {
+    // Convert in a separate buffer, so that data is not changed
+    values = toFloat(data, localSizePerp(lx, lz));
+    mem_hdf5_type = H5T_NATIVE_FLOAT;
+  }
+
   int nd = 0; // Number of dimensions
   if(lx != 0) nd = 1;
   if(lz != 0) nd = 2;
@@ -685,7 +775,7 @@ bool H5Format::write_perp(BoutReal *data, const std::string& name, int lx, int l
                           counts, /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
 
-  hid_t dataSet = H5Dopen(dataFile, name.c_str(), H5P_DEFAULT);
+  hid_t dataSet = getDataSet(name);
   if (dataSet < 0) {
     output_error.write("ERROR: HDF5 variable '%s' has not been added to file '%s'\n", name.c_str(), fname);
     return false;
@@ -698,15 +788,13 @@ bool H5Format::write_perp(BoutReal *data, const std::string& name, int lx, int l
                           /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
 
-  if (H5Dwrite(dataSet, mem_hdf5_type, mem_space, dataSpace, dataSet_plist, data) < 0)
+  if (H5Dwrite(dataSet, mem_hdf5_type, mem_space, dataSpace, dataSet_plist, values) < 0)
     throw BoutException("Failed to write data");
 
   if (H5Sclose(mem_space) < 0)
     throw BoutException("Failed to close mem_space");
   if (H5Sclose(dataSpace) < 0)
     throw BoutException("Failed to close dataSpace");
-  if (H5Dclose(dataSet) < 0)
-    throw BoutException("Failed to close dataSet");
 
   return true;
 }
@@ -753,12 +841,17 @@ bool H5Format::read_rec(void *data, hid_t hdf5_type, const char *name, int lx, i
   if (lz != 0) {
     nd = 4;
   }
+  // The time dimension isn't in memory
+  int nd_local = nd - 1;
   hsize_t counts[4], offset[4];
-  hsize_t offset_local[3], init_size_local[3];
+  hsize_t counts_local[3], offset_local[3], init_size_local[3];
   counts[0] = 1;
   counts[1] = lx;
   counts[2] = ly;
   counts[3] = lz;
+  counts_local[0] = lx;
+  counts_local[1] = ly;
+  counts_local[2] = lz;
   offset[0] = t0;
   offset[1] = x0;
   offset[2] = y0;
@@ -770,19 +863,19 @@ bool H5Format::read_rec(void *data, hid_t hdf5_type, const char *name, int lx, i
   init_size_local[1] = mesh->LocalNy;
   init_size_local[2] = mesh->LocalNz;
 
-  if (nd == 1) {
-    // Need to write a time-series of scalars
-    nd = 1;
-    counts[1] = 1;
-    offset[1] = 0;
+  if (nd_local == 0) {
+    // Need to read a time-series of scalars
+    nd_local = 1;
+    counts_local[0] = 1;
+    offset_local[0] = 0;
     init_size_local[0] = 1;
   }
 
-  hid_t mem_space = H5Screate_simple(nd, init_size_local, init_size_local);
+  hid_t mem_space = H5Screate_simple(nd_local, init_size_local, init_size_local);
   if (mem_space < 0)
     throw BoutException("Failed to create mem_space");
   if (H5Sselect_hyperslab(mem_space, H5S_SELECT_SET, offset_local, /*stride=*/nullptr,
-                          counts, /*block=*/nullptr) < 0)
+                          counts_local, /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
 
   hid_t dataSet = H5Dopen(dataFile, name, H5P_DEFAULT);
@@ -890,21 +983,9 @@ bool H5Format::write_rec(int *var, const std::string &name, int lx, int ly, int
 bool H5Format::write_rec(BoutReal *data, const char *name, int lx, int ly, int lz) {
   
   if(lowPrecision) {
-    // An out of range value can make the conversion
-    // corrupt the whole dataset. Make sure everything
-    // is in the range of a float
-    int i_max=1;
-    if (lx>0) i_max*=lx;
-    if (ly>0) i_max*=ly;
-    if (lz>0) i_max*=lz;
-    
-    for(int i=0;i<i_max;i++) {
-      if(data[i] > 1e20)
-        data[i] = 1e20;
-      if(data[i] < -1e20)
-        data[i] = -1e20;
-    }
-    return write_rec(data, H5T_NATIVE_DOUBLE, name, lx, ly, lz);
+    // Convert in a separate buffer, so that data is not changed
+    return write_rec(toFloat(data, localSize(lx, ly, lz)), H5T_NATIVE_FLOAT, name, lx,
+                     ly, lz);
   }
   
   return write_rec(data, H5T_NATIVE_DOUBLE, name, lx, ly, lz);
@@ -961,7 +1042,7 @@ bool H5Format::write_rec(void *data, hid_t mem_hdf5_type, const char *name, int
                           counts_local, /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
   
-  hid_t dataSet = H5Dopen(dataFile, name, H5P_DEFAULT);
+  hid_t dataSet = getDataSet(name);
   if (dataSet >= 0) { // >=0 means file exists, so open. Else error.
     
     hsize_t dims[4] = {};
@@ -1004,8 +1085,6 @@ bool H5Format::write_rec(void *data, hid_t mem_hdf5_type, const char *name, int
     throw BoutException("Failed to close mem_space");
   if (H5Sclose(dataSpace) < 0)
     throw BoutException("Failed to close dataSpace");
-  if (H5Dclose(dataSet) < 0)
-    throw BoutException("Failed to close dataSet");
   
   return true;
 }
@@ -1019,6 +1098,13 @@ bool H5Format::write_rec_perp(BoutReal *data, const std::string& name, int lx, i
   if((lx < 0) || (lz < 0))
     return false;
 
+  void* values = data;
+  if (lowPrecision) {
+    // Convert in a separate buffer, so that data is not changed
+    values = toFloat(data, localSizePerp(lx, lz));
+    mem_hdf5_type = H5T_NATIVE_FLOAT;
+  }
+
   int nd = 1; // Number of dimensions
   if(lx != 0) nd = 2;
   if(lz != 0) nd = 3;
@@ -1053,7 +1139,7 @@ bool H5Format::write_rec_perp(BoutReal *data, const std::string& name, int lx, i
                           counts_local, /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
 
-  hid_t dataSet = H5Dopen(dataFile, name.c_str(), H5P_DEFAULT);
+  hid_t dataSet = getDataSet(name);
   if (dataSet >= 0) { // >=0 means file exists, so open. Else error.
 
     hsize_t dims[3] = {};
@@ -1089,15 +1175,13 @@ bool H5Format::write_rec_perp(BoutReal *data, const std::string& name, int lx, i
                           /*block=*/nullptr) < 0)
     throw BoutException("Failed to select hyperslab");
 
-  if (H5Dwrite(dataSet, mem_hdf5_type, mem_space, dataSpace, dataSet_plist, data) < 0)
+  if (H5Dwrite(dataSet, mem_hdf5_type, mem_space, dataSpace, dataSet_plist, values) < 0)
     throw BoutException("Failed to write data");
 
   if (H5Sclose(mem_space) < 0)
     throw BoutException("Failed to close mem_space");
   if (H5Sclose(dataSpace) < 0)
     throw BoutException("Failed to close dataSpace");
-  if (H5Dclose(dataSet) < 0)
-    throw BoutException("Failed to close dataSet");
 
   return true;
 }
@@ -62,8 +62,12 @@ class H5Format : public DataFormat {
 
   using DataFormat::openr;
   bool openr(const char *name) override;
+  bool openr(const std::string &base, int mype) override;
   using DataFormat::openw;
   bool openw(const char *name, bool append=false) override;
+  bool openw(const std::string &base, int mype, bool append=false) override;
+
+  bool isParallel() const override { return parallel; }
   
   bool is_valid() override;
   
@@ -143,8 +147,14 @@ class H5Format : public DataFormat {
 
   int x0, y0, z0, t0; ///< Data origins for file access
   int x0_local, y0_local, z0_local; ///< Data origins for memory access
-  
-  hsize_t chunk_length;
+
+  /// Datasets which have been written or added, kept open until the
+  /// file is closed so they aren't looked up by name for each write
+  std::map<std::string, hid_t> datasets;
+
+  /// Get the dataset called \p name, opening it if it isn't already
+  /// open. Returns a negative value if there is no such dataset
+  hid_t getDataSet(const std::string& name);
 
   bool addVar(const std::string &name, bool repeat, hid_t write_hdf5_type, std::string datatype);
   bool read(void *var, hid_t hdf5_type, const char *name, int lx = 1, int ly = 0, int lz = 0);
@@ -152,6 +162,18 @@ class H5Format : public DataFormat {
   bool read_rec(void *var, hid_t hdf5_type, const char *name, int lx = 1, int ly = 0, int lz = 0);
   bool write_rec(void *var, hid_t mem_hdf5_type, const char *name, int lx = 0, int ly = 0, int lz = 0);
 
+  /// Dataset creation properties for a variable of type \p hdf5_type
+  /// with \p nd dimensions of sizes \p dims, chunked and compressed
+  /// according to the storage settings. If \p repeat, the first
+  /// dimension is time. The caller must close the property list
+  hid_t createProperties(int nd, const hsize_t* dims, bool repeat, hid_t hdf5_type);
+
+  /// Number of values in the local array holding a variable written
+  /// with sizes \p lx, \p ly, \p lz, including any guard cells
+  int localSize(int lx, int ly, int lz) const;
+  /// As localSize, for a FieldPerp
+  int localSizePerp(int lx, int lz) const;
+
   // Attributes
 
   void setAttribute(const hid_t &dataSet, const std::string &attrname,
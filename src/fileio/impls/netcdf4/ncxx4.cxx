@@ -39,6 +39,21 @@ using namespace netCDF;
 // Define this to see loads of info messages
 //#define NCDF_VERBOSE
 
+namespace {
+/// Number of values in a variable with lengths \p lx, \p ly and \p
+/// lz. Lengths are zero for dimensions the variable doesn't have, so
+/// scalars have one value and Field2Ds lx * ly
+int dataSize(int lx, int ly, int lz) {
+  int size = 1;
+  for (const int length : {lx, ly, lz}) {
+    if (length != 0) {
+      size *= length;
+    }
+  }
+  return size;
+}
+} // namespace
+
 Ncxx4::Ncxx4(Mesh* mesh_in) : DataFormat(mesh_in) {
   dataFile = nullptr;
   x0 = y0 = z0 = t0 = 0;
@@ -271,7 +286,8 @@ void Ncxx4::close() {
 
   if (dataFile == nullptr)
     return;
-  
+
+  vars.clear();
   delete dataFile;
   dataFile = nullptr;
 
@@ -280,6 +296,23 @@ void Ncxx4::close() {
 }
 
 void Ncxx4::flush() {
+  if (!is_valid())
+    return;
+
+  dataFile->sync();
+}
+
+NcVar Ncxx4::getVar(const std::string& name) {
+  const auto found = vars.find(name);
+  if (found != vars.end()) {
+    return found->second;
+  }
+
+  NcVar var = dataFile->getVar(name);
+  if (!var.isNull()) {
+    vars[name] = var;
+  }
+  return var;
 }
 
 const std::vector<int> Ncxx4::getSize(const char *name) {
@@ -334,7 +367,7 @@ bool Ncxx4::addVarInt(const string &name, bool repeat) {
   if(!is_valid())
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     // Variable not in file, so add it.
     if (repeat)
@@ -346,6 +379,8 @@ bool Ncxx4::addVarInt(const string &name, bool repeat) {
       output_error.write("ERROR: NetCDF could not add int '%s' to file '%s'\n", name.c_str(), fname);
       return false;
     }
+    setStorage(var, repeat);
+    vars[name] = var;
   }
   return true;
 }
@@ -354,7 +389,7 @@ bool Ncxx4::addVarBoutReal(const string &name, bool repeat) {
   if(!is_valid())
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     // Variable not in file, so add it.
     if(lowPrecision) {
@@ -373,6 +408,8 @@ bool Ncxx4::addVarBoutReal(const string &name, bool repeat) {
       output_error.write("ERROR: NetCDF could not add BoutReal '%s' to file '%s'\n", name.c_str(), fname);
       return false;
     }
+    setStorage(var, repeat);
+    vars[name] = var;
   }
   return true;
 }
@@ -381,7 +418,7 @@ bool Ncxx4::addVarField2D(const string &name, bool repeat) {
   if(!is_valid())
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     // Variable not in file, so add it.
     if(lowPrecision) {
@@ -400,6 +437,8 @@ bool Ncxx4::addVarField2D(const string &name, bool repeat) {
       output_error.write("ERROR: NetCDF could not add Field2D '%s' to file '%s'\n", name.c_str(), fname);
       return false;
     }
+    setStorage(var, repeat);
+    vars[name] = var;
   }
   return true;
 }
@@ -408,7 +447,7 @@ bool Ncxx4::addVarField3D(const string &name, bool repeat) {
   if(!is_valid())
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     // Variable not in file, so add it.
     if(lowPrecision) {
@@ -427,6 +466,8 @@ bool Ncxx4::addVarField3D(const string &name, bool repeat) {
       output_error.write("ERROR: NetCDF could not add Field3D '%s' to file '%s'\n", name.c_str(), fname);
       return false;
     }
+    setStorage(var, repeat);
+    vars[name] = var;
   }
   return true;
 }
@@ -435,7 +476,7 @@ bool Ncxx4::addVarFieldPerp(const string &name, bool repeat) {
   if(!is_valid())
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     // Variable not in file, so add it.
     if (repeat) {
@@ -458,6 +499,8 @@ bool Ncxx4::addVarFieldPerp(const string &name, bool repeat) {
       output_error.write("ERROR: NetCDF could not add FieldPerp '%s' to file '%s'\n", name.c_str(), fname);
       return false;
     }
+    setStorage(var, repeat);
+    vars[name] = var;
   }
   return true;
 }
@@ -569,7 +612,7 @@ bool Ncxx4::write(int *data, const char *name, int lx, int ly, int lz) {
   if((lx < 0) || (ly < 0) || (lz < 0))
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     output_error.write("ERROR: NetCDF int variable '%s' has not been added to file '%s'\n", name, fname);
     return false;
@@ -609,7 +652,7 @@ bool Ncxx4::write(BoutReal *data, const char *name, int lx, int ly, int lz) {
   if((lx < 0) || (ly < 0) || (lz < 0))
     return false;
   
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     output_error.write("ERROR: NetCDF BoutReal variable '%s' has not been added to file '%s'\n", name, fname);
     return false;
@@ -620,25 +663,18 @@ bool Ncxx4::write(BoutReal *data, const char *name, int lx, int ly, int lz) {
   std::vector<size_t> counts(3);
   counts[0] = lx; counts[1] = ly; counts[2] = lz;
 
-  if(lowPrecision) {
-    // An out of range value can make the conversion
-    // corrupt the whole dataset. Make sure everything
-    // is in the range of a float
-    
-    for(int i=0;i<lx*ly*lz;i++) {
-      if(data[i] > 1e20)
-	data[i] = 1e20;
-      if(data[i] < -1e20)
-	data[i] = -1e20;
-    }
-  }
-  
-  for(int i=0;i<lx*ly*lz;i++) {
+  const int size = dataSize(lx, ly, lz);
+  for(int i=0;i<size;i++) {
     if(!finite(data[i]))
       data[i] = 0.0;
   }
 
-  var.putVar(start, counts, data);
+  if(lowPrecision) {
+    // Convert in a separate buffer, so that data is not changed
+    var.putVar(start, counts, toFloat(data, size));
+  } else {
+    var.putVar(start, counts, data);
+  }
 
   return true;
 }
@@ -659,7 +695,7 @@ bool Ncxx4::write_perp(BoutReal *data, const std::string& name, int lx, int lz)
   if((lx < 0) || (lz < 0))
     return false;
 
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     output_error.write(
         "ERROR: NetCDF BoutReal variable '%s' has not been added to file '%s'\n",
@@ -672,25 +708,18 @@ bool Ncxx4::write_perp(BoutReal *data, const std::string& name, int lx, int lz)
   std::vector<size_t> counts(2);
   counts[0] = lx; counts[1] = lz;
 
-  if(lowPrecision) {
-    // An out of range value can make the conversion
-    // corrupt the whole dataset. Make sure everything
-    // is in the range of a float
-
-    for(int i=0;i<lx*lz;i++) {
-      if(data[i] > 1e20)
-        data[i] = 1e20;
-      if(data[i] < -1e20)
-        data[i] = -1e20;
-    }
-  }
-
-  for(int i=0;i<lx*lz;i++) {
+  const int size = dataSize(lx, 0, lz);
+  for(int i=0;i<size;i++) {
     if(!finite(data[i]))
       data[i] = 0.0;
   }
 
-  var.putVar(start, counts, data);
+  if(lowPrecision) {
+    // Convert in a separate buffer, so that data is not changed
+    var.putVar(start, counts, toFloat(data, size));
+  } else {
+    var.putVar(start, counts, data);
+  }
 
   return true;
 }
@@ -799,7 +828,7 @@ bool Ncxx4::write_rec(int *data, const char *name, int lx, int ly, int lz) {
     return false;
   
   // Try to find variable
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     output_error.write("ERROR: NetCDF int variable '%s' has not been added to file '%s'\n", name, fname);
     return false;
@@ -845,7 +874,7 @@ bool Ncxx4::write_rec(BoutReal *data, const char *name, int lx, int ly, int lz)
     return false;
 
   // Try to find variable
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     output_error.write("ERROR: NetCDF BoutReal variable '%s' has not been added to file '%s'\n", name, fname);
     return false;
@@ -863,20 +892,8 @@ bool Ncxx4::write_rec(BoutReal *data, const char *name, int lx, int ly, int lz)
   output_info.write("INFO: NetCDF writing record %d of '%s' in '%s'\n",t, name, fname);
 #endif
 
-  if(lowPrecision) {
-    // An out of range value can make the conversion
-    // corrupt the whole dataset. Make sure everything
-    // is in the range of a float
-    
-    for(int i=0;i<lx*ly*lz;i++) {
-      if(data[i] > 1e20)
-	data[i] = 1e20;
-      if(data[i] < -1e20)
-	data[i] = -1e20;
-    }
-  }
-  
-  for(int i=0;i<lx*ly*lz;i++) {
+  const int size = dataSize(lx, ly, lz);
+  for(int i=0;i<size;i++) {
     if(!finite(data[i]))
       data[i] = 0.0;
   }
@@ -887,7 +904,12 @@ bool Ncxx4::write_rec(BoutReal *data, const char *name, int lx, int ly, int lz)
   counts[0] = 1; counts[1] = lx; counts[2] = ly; counts[3] = lz;
 
   // Add the record
-  var.putVar(start, counts, data);
+  if(lowPrecision) {
+    // Convert in a separate buffer, so that data is not changed
+    var.putVar(start, counts, toFloat(data, size));
+  } else {
+    var.putVar(start, counts, data);
+  }
   
   // Increment record number
   rec_nr[name] = rec_nr[name] + 1;
@@ -912,7 +934,7 @@ bool Ncxx4::write_rec_perp(BoutReal *data, const std::string& name, int lx, int
     return false;
 
   // Try to find variable
-  NcVar var = dataFile->getVar(name);
+  NcVar var = getVar(name);
   if(var.isNull()) {
     output_error.write(
         "ERROR: NetCDF BoutReal variable '%s' has not been added to file '%s'\n",
@@ -932,20 +954,8 @@ bool Ncxx4::write_rec_perp(BoutReal *data, const std::string& name, int lx, int
   output_info.write("INFO: NetCDF writing record %d of '%s' in '%s'\n",t, name, fname);
 #endif
 
-  if(lowPrecision) {
-    // An out of range value can make the conversion
-    // corrupt the whole dataset. Make sure everything
-    // is in the range of a float
-
-    for(int i=0;i<lx*lz;i++) {
-      if(data[i] > 1e20)
-        data[i] = 1e20;
-      if(data[i] < -1e20)
-        data[i] = -1e20;
-    }
-  }
-
-  for(int i=0;i<lx*lz;i++) {
+  const int size = dataSize(lx, 0, lz);
+  for(int i=0;i<size;i++) {
     if(!finite(data[i]))
       data[i] = 0.0;
   }
@@ -956,7 +966,12 @@ bool Ncxx4::write_rec_perp(BoutReal *data, const std::string& name, int lx, int
   counts[0] = 1; counts[1] = lx; counts[2] = lz;
 
   // Add the record
-  var.putVar(start, counts, data);
+  if(lowPrecision) {
+    // Convert in a separate buffer, so that data is not changed
+    var.putVar(start, counts, toFloat(data, size));
+  } else {
+    var.putVar(start, counts, data);
+  }
 
   // Increment record number
   rec_nr[name] = rec_nr[name] + 1;
@@ -1157,6 +1172,22 @@ bool Ncxx4::getAttribute(const std::string &varname, const std::string &attrname
  * Private functions
  ***************************************************************************/
 
+void Ncxx4::setStorage(NcVar& var, bool repeat) {
+  // Time-dependent variables are always chunked, others only if
+  // they are compressed
+  if ((var.getDimCount() == 0) or (not repeat and storage.deflate_level == 0))
+    return;
+
+  std::vector<std::size_t> dims;
+  for (const auto& dim : var.getDims())
+    dims.push_back(dim.getSize());
+  auto chunks = chunkShape(dims, repeat, var.getType().getSize());
+  var.setChunking(NcVar::nc_CHUNKED, chunks);
+
+  if (storage.deflate_level > 0)
+    var.setCompression(storage.shuffle, true, storage.deflate_level);
+}
+
 std::vector<NcDim> Ncxx4::getDimVec(int nd) {
   std::vector<NcDim> vec(nd);
   for(int i=0;i<nd;i++)
@@ -153,8 +153,18 @@ private:
   int x0, y0, z0, t0; ///< Data origins
 
   std::map<std::string, int> rec_nr; // Record number for each variable (bit nasty)
+
+  /// Variables which have been written or added, so they aren't
+  /// looked up by name for each write
+  std::map<std::string, netCDF::NcVar> vars;
+  /// Get the variable called \p name, which is null if there isn't one
+  netCDF::NcVar getVar(const std::string& name);
   int default_rec;  // Starting record. Useful when appending to existing file
   
+  /// Set the chunking and compression of a newly added \p var from
+  /// the storage settings
+  void setStorage(netCDF::NcVar& var, bool repeat);
+
   std::vector<netCDF::NcDim> getDimVec(int nd);
   std::vector<netCDF::NcDim> getRecDimVec(int nd);
 };
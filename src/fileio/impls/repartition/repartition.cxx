@@ -0,0 +1,341 @@
+#include "repartition.hxx"
+
+#include <bout/mesh.hxx>
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <msg_stack.hxx>
+#include <output.hxx>
+#include <utils.hxx>
+
+#include <algorithm>
+#include <exception>
+
+namespace {
+/// The processor layout of the old files, from the first file
+struct Layout {
+  /// 0 if the file is missing, 1 if it has no layout, 2 if it has
+  /// one, and -1 if reading it failed
+  int found{0};
+  int nxpe{0}, nype{0}, mxsub{0}, mysub{0}, mxg{0}, myg{0}, nx{0}, ny{0}, nz{0};
+};
+
+/// The file written by processor \p proc, with base name \p base
+std::string procFilename(const std::string& base, int proc) {
+  const auto pos = base.find_last_of('.');
+  return base.substr(0, pos) + "." + toString(proc) + "." + base.substr(pos + 1);
+}
+
+/// FieldPerps are only in the files of the processors with their Y
+/// index, so aren't read from the overlapping old files like other
+/// fields. Rather than silently leaving them as zero, stop
+[[noreturn]] void perpError(const std::string& name) {
+  throw BoutException("Can't read FieldPerp %s from files with a different processor "
+                      "layout. Restart with the original NXPE and NYPE",
+                      name.c_str());
+}
+
+/// Start and end of the points which processor \p pe of \p npe
+/// evolved, including the boundaries at the ends
+std::pair<int, int> owned(int pe, int npe, int nsub, int nguard) {
+  return {(pe == 0) ? 0 : pe * nsub + nguard,
+          (pe == npe - 1) ? npe * nsub + 2 * nguard : (pe + 1) * nsub + nguard};
+}
+} // namespace
+
+RepartitionFormat::RepartitionFormat(std::unique_ptr<DataFormat> format, Mesh* mesh_in)
+    : DataFormat(mesh_in), file(std::move(format)) {}
+
+bool RepartitionFormat::openr(const char* name) {
+  close();
+  valid = file->openr(name);
+  return valid;
+}
+
+bool RepartitionFormat::openr(const std::string& base, int mype) {
+  TRACE("RepartitionFormat::openr");
+  ASSERT1(mesh != nullptr);
+
+  close();
+
+  // Read the old layout from the first file, and tell everyone
+  Layout layout;
+  std::exception_ptr error;
+  if (BoutComm::rank() == 0) {
+    try {
+      if (file->openr(procFilename(base, 0))) {
+        const bool has_layout =
+            file->read(&layout.nxpe, "NXPE") and file->read(&layout.nype, "NYPE")
+            and file->read(&layout.mxsub, "MXSUB") and file->read(&layout.mysub, "MYSUB")
+            and file->read(&layout.mxg, "MXG") and file->read(&layout.myg, "MYG")
+            and file->read(&layout.nx, "nx") and file->read(&layout.ny, "ny")
+            and file->read(&layout.nz, "nz");
+        layout.found = has_layout ? 2 : 1;
+        file->close();
+      }
+    } catch (...) {
+      // Re-thrown once the other processors have been told
+      layout.found = -1;
+      error = std::current_exception();
+    }
+  }
+  MPI_Bcast(&layout, sizeof(layout), MPI_BYTE, 0, BoutComm::get());
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  if (layout.found < 0) {
+    throw BoutException("Couldn't read the processor layout from %s",
+                        procFilename(base, 0).c_str());
+  }
+  if (layout.found == 0) {
+    return false;
+  }
+
+  if (layout.found == 1
+      or (layout.nxpe == mesh->getNXPE() and layout.nype == mesh->getNYPE())) {
+    // Files from the same layout, or without one: just read this processor's file
+    valid = file->openr(base, mype);
+    return valid;
+  }
+
+  const int mxg = mesh->xstart, myg = mesh->ystart;
+  if (layout.nx != mesh->GlobalNx or layout.ny != mesh->GlobalNy - 2 * myg
+      or layout.nz != mesh->GlobalNz or layout.mxg != mxg or layout.myg != myg) {
+    throw BoutException("Can't read %s: written with a %d x %d x %d grid and %d x %d "
+                        "guard cells, but this grid is %d x %d x %d with %d x %d",
+                        base.c_str(), layout.nx, layout.ny, layout.nz, layout.mxg,
+                        layout.myg, mesh->GlobalNx, mesh->GlobalNy - 2 * myg,
+                        mesh->GlobalNz, mxg, myg);
+  }
+  if (layout.nxpe * layout.mxsub + 2 * mxg != layout.nx
+      or layout.nype * layout.mysub != layout.ny) {
+    throw BoutException("Can't read %s: the processor layout (%d x %d processors of "
+                        "%d x %d points) doesn't fit the grid",
+                        base.c_str(), layout.nxpe, layout.nype, layout.mxsub,
+                        layout.mysub);
+  }
+
+  output_info.write("\tReading %s from %d x %d processors onto %d x %d\n", base.c_str(),
+                    layout.nxpe, layout.nype, mesh->getNXPE(), mesh->getNYPE());
+
+  old_nx = layout.mxsub + 2 * mxg;
+  old_ny = layout.mysub + 2 * myg;
+
+  // The part of the global arrays, including guard cells, on this processor
+  const int xstart = mesh->OffsetX, xend = mesh->OffsetX + mesh->LocalNx;
+  const int ystart = mesh->OffsetY, yend = mesh->OffsetY + mesh->LocalNy;
+
+  for (int py = 0; py < layout.nype; ++py) {
+    const auto y_owned = owned(py, layout.nype, layout.mysub, myg);
+    const int y_first = std::max(ystart, y_owned.first);
+    const int y_last = std::min(yend, y_owned.second);
+    if (y_first >= y_last) {
+      continue;
+    }
+
+    for (int px = 0; px < layout.nxpe; ++px) {
+      const auto x_owned = owned(px, layout.nxpe, layout.mxsub, mxg);
+      const int x_first = std::max(xstart, x_owned.first);
+      const int x_last = std::min(xend, x_owned.second);
+      if (x_first >= x_last) {
+        continue;
+      }
+
+      const auto filename = procFilename(base, py * layout.nxpe + px);
+      Source source;
+      source.file = data_format(filename.c_str());
+      if (!source.file->openr(filename)) {
+        throw BoutException("Couldn't open %s, needed to change the processor layout",
+                            filename.c_str());
+      }
+      source.old_x = x_first - px * layout.mxsub;
+      source.old_y = y_first - py * layout.mysub;
+      source.new_x = x_first - xstart;
+      source.new_y = y_first - ystart;
+      source.nx = x_last - x_first;
+      source.ny = y_last - y_first;
+      sources.push_back(std::move(source));
+    }
+  }
+
+  repartitioned = true;
+  valid = true;
+  return true;
+}
+
+void RepartitionFormat::close() {
+  if (file->is_valid()) {
+    file->close();
+  }
+  for (auto& source : sources) {
+    source.file->close();
+  }
+  sources.clear();
+  valid = false;
+  repartitioned = false;
+}
+
+const std::vector<int> RepartitionFormat::getSize(const std::string& var) {
+  if (!valid) {
+    return {};
+  }
+
+  auto size = first().getSize(var);
+  if (repartitioned and size.size() >= 2 and size[0] == old_nx and size[1] == old_ny) {
+    // A field, which has the size of this processor's part
+    size[0] = mesh->LocalNx;
+    size[1] = mesh->LocalNy;
+  }
+  return size;
+}
+
+bool RepartitionFormat::setGlobalOrigin(int x, int y, int z) {
+  x0 = x;
+  y0 = y;
+  z0 = z;
+  return file->setGlobalOrigin(x, y, z);
+}
+
+bool RepartitionFormat::setRecord(int t) {
+  bool success = file->setRecord(t);
+  for (auto& source : sources) {
+    success = source.file->setRecord(t) and success;
+  }
+  return success;
+}
+
+bool RepartitionFormat::isField(int lx, int ly, int lz) const {
+  return x0 == 0 and y0 == 0 and z0 == 0 and lx == mesh->LocalNx
+         and ly == mesh->LocalNy and (lz == 0 or lz == mesh->LocalNz);
+}
+
+template <typename T>
+bool RepartitionFormat::readField(T* var, const std::string& name, int lz,
+                                  bool record) {
+  const int nz = std::max(lz, 1);
+  std::vector<T> buffer;
+  for (auto& source : sources) {
+    buffer.resize(source.nx * source.ny * nz);
+
+    source.file->setGlobalOrigin(source.old_x, source.old_y, 0);
+    const bool success =
+        record ? source.file->read_rec(buffer.data(), name, source.nx, source.ny, lz)
+               : source.file->read(buffer.data(), name, source.nx, source.ny, lz);
+    source.file->setGlobalOrigin();
+    if (!success) {
+      return false;
+    }
+
+    for (int i = 0; i < source.nx; ++i) {
+      for (int j = 0; j < source.ny; ++j) {
+        std::copy_n(&buffer[(i * source.ny + j) * nz], nz,
+                    &var[((source.new_x + i) * mesh->LocalNy + source.new_y + j) * nz]);
+      }
+    }
+  }
+  return true;
+}
+
+bool RepartitionFormat::read(int* var, const std::string& name, int lx, int ly, int lz) {
+  TRACE("RepartitionFormat::read(int)");
+  if (!valid) {
+    return false;
+  }
+  if (repartitioned and isField(lx, ly, lz)) {
+    return readField(var, name, lz);
+  }
+  return first().read(var, name, lx, ly, lz);
+}
+
+bool RepartitionFormat::read(BoutReal* var, const std::string& name, int lx, int ly,
+                             int lz) {
+  TRACE("RepartitionFormat::read(BoutReal)");
+  if (!valid) {
+    return false;
+  }
+  if (repartitioned and isField(lx, ly, lz)) {
+    return readField(var, name, lz);
+  }
+  return first().read(var, name, lx, ly, lz);
+}
+
+bool RepartitionFormat::read_perp(BoutReal* var, const std::string& name, int lx,
+                                  int lz) {
+  TRACE("RepartitionFormat::read_perp");
+  if (!valid) {
+    return false;
+  }
+  if (repartitioned) {
+    perpError(name);
+  }
+  return file->read_perp(var, name, lx, lz);
+}
+
+bool RepartitionFormat::read_rec(int* var, const std::string& name, int lx, int ly,
+                                 int lz) {
+  TRACE("RepartitionFormat::read_rec(int)");
+  if (!valid) {
+    return false;
+  }
+  if (repartitioned and isField(lx, ly, lz)) {
+    return readField(var, name, lz, true);
+  }
+  return first().read_rec(var, name, lx, ly, lz);
+}
+
+bool RepartitionFormat::read_rec(BoutReal* var, const std::string& name, int lx, int ly,
+                                 int lz) {
+  TRACE("RepartitionFormat::read_rec(BoutReal)");
+  if (!valid) {
+    return false;
+  }
+  if (repartitioned and isField(lx, ly, lz)) {
+    return readField(var, name, lz, true);
+  }
+  return first().read_rec(var, name, lx, ly, lz);
+}
+
+bool RepartitionFormat::read_rec_perp(BoutReal* var, const std::string& name, int lx,
+                                      int lz) {
+  TRACE("RepartitionFormat::read_rec_perp");
+  if (!valid) {
+    return false;
+  }
+  if (repartitioned) {
+    perpError(name);
+  }
+  return file->read_rec_perp(var, name, lx, lz);
+}
+
+bool RepartitionFormat::getAttribute(const std::string& varname,
+                                     const std::string& attrname, std::string& text) {
+  return valid and first().getAttribute(varname, attrname, text);
+}
+
+bool RepartitionFormat::getAttribute(const std::string& varname,
+                                     const std::string& attrname, int& value) {
+  return valid and first().getAttribute(varname, attrname, value);
+}
+
+bool RepartitionFormat::getAttribute(const std::string& varname,
+                                     const std::string& attrname, BoutReal& value) {
+  return valid and first().getAttribute(varname, attrname, value);
+}
+
+void RepartitionFormat::setAttribute(const std::string& UNUSED(varname),
+                                     const std::string& UNUSED(attrname),
+                                     const std::string& UNUSED(text)) {
+  throw BoutException("RepartitionFormat is read-only, so can't set attributes");
+}
+
+void RepartitionFormat::setAttribute(const std::string& UNUSED(varname),
+                                     const std::string& UNUSED(attrname),
+                                     int UNUSED(value)) {
+  throw BoutException("RepartitionFormat is read-only, so can't set attributes");
+}
+
+void RepartitionFormat::setAttribute(const std::string& UNUSED(varname),
+                                     const std::string& UNUSED(attrname),
+                                     BoutReal UNUSED(value)) {
+  throw BoutException("RepartitionFormat is read-only, so can't set attributes");
+}
@@ -0,0 +1,223 @@
+/*!
+ * \file repartition.hxx
+ *
+ * \brief Read per-processor files written with a different processor layout
+ *
+ * Files such as the restart files are written by each processor
+ * separately, holding that processor's part of the global arrays.
+ * When they are opened, the processor layout they were written with
+ * (NXPE, NYPE, MXSUB, MYSUB) is read from the first file. If it is
+ * the same as the current mesh, each processor just reads its own
+ * file. Otherwise, each processor opens the old files which overlap
+ * its part of the mesh, and reads just the overlapping parts of
+ * every field from them.
+ *
+ * Each point is read from the file of the processor which evolved
+ * it, and guard cells from the neighbouring processor, in the same
+ * way as boutdata.restart.redistribute. Boundary cells are read from
+ * the processor at the edge of the domain.
+ *
+ * Opening files is collective over BoutComm: all processors must call
+ * openr together. Reading is not.
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+class RepartitionFormat;
+
+#ifndef __REPARTITIONFORMAT_H__
+#define __REPARTITIONFORMAT_H__
+
+#include "dataformat.hxx"
+#include "unused.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class RepartitionFormat : public DataFormat {
+public:
+  /// Read files with the same processor layout as \p mesh_in
+  /// using \p format, and otherwise with new formats of the same type
+  RepartitionFormat(std::unique_ptr<DataFormat> format, Mesh* mesh_in = nullptr);
+
+  /// Open a single file, without changing the layout
+  bool openr(const char* name) override;
+  using DataFormat::openr;
+  /// Open the files with base name \p base for processor \p mype.
+  /// Collective over BoutComm
+  bool openr(const std::string& base, int mype) override;
+  bool openw(const char* UNUSED(name), bool UNUSED(append) = false) override {
+    return false;
+  }
+  using DataFormat::openw;
+
+  bool is_valid() override { return valid; }
+
+  void close() override;
+
+  void flush() override {}
+
+  const std::vector<int> getSize(const char* var) override {
+    return getSize(std::string(var));
+  }
+  const std::vector<int> getSize(const std::string& var) override;
+
+  bool setGlobalOrigin(int x = 0, int y = 0, int z = 0) override;
+  bool setRecord(int t) override;
+
+  // Read-only, so variables can't be added
+  bool addVarInt(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarBoutReal(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarField2D(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarField3D(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarFieldPerp(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+
+  bool read(int* var, const char* name, int lx = 1, int ly = 0, int lz = 0) override {
+    return read(var, std::string(name), lx, ly, lz);
+  }
+  bool read(int* var, const std::string& name, int lx = 1, int ly = 0,
+            int lz = 0) override;
+  bool read(BoutReal* var, const char* name, int lx = 1, int ly = 0,
+            int lz = 0) override {
+    return read(var, std::string(name), lx, ly, lz);
+  }
+  bool read(BoutReal* var, const std::string& name, int lx = 1, int ly = 0,
+            int lz = 0) override;
+  /// FieldPerps can only be read if the layout hasn't changed;
+  /// otherwise this throws
+  bool read_perp(BoutReal* var, const std::string& name, int lx = 1,
+                 int lz = 0) override;
+
+  bool write(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write(BoutReal* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                  int UNUSED(lx) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  bool read_rec(int* var, const char* name, int lx = 1, int ly = 0,
+                int lz = 0) override {
+    return read_rec(var, std::string(name), lx, ly, lz);
+  }
+  bool read_rec(int* var, const std::string& name, int lx = 1, int ly = 0,
+                int lz = 0) override;
+  bool read_rec(BoutReal* var, const char* name, int lx = 1, int ly = 0,
+                int lz = 0) override {
+    return read_rec(var, std::string(name), lx, ly, lz);
+  }
+  bool read_rec(BoutReal* var, const std::string& name, int lx = 1, int ly = 0,
+                int lz = 0) override;
+  /// FieldPerps can only be read if the layout hasn't changed;
+  /// otherwise this throws
+  bool read_rec_perp(BoutReal* var, const std::string& name, int lx = 1,
+                     int lz = 0) override;
+
+  bool write_rec(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                 int UNUSED(lx) = 0, int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                      int UNUSED(lx) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    const std::string& text) override;
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    int value) override;
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    BoutReal value) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    std::string& text) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    int& value) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    BoutReal& value) override;
+
+private:
+  /// This processor's file, when the layout hasn't changed
+  std::unique_ptr<DataFormat> file;
+  bool valid{false};
+  /// Are the files from a different processor layout?
+  bool repartitioned{false};
+
+  int x0{0}, y0{0}, z0{0};
+
+  /// Size of the arrays in each old file
+  int old_nx{0}, old_ny{0};
+
+  /// An old file, and the part of this processor's arrays it has
+  struct Source {
+    std::unique_ptr<DataFormat> file;
+    int old_x, old_y; ///< Start of the part in the old file's arrays
+    int new_x, new_y; ///< Start of the part in this processor's arrays
+    int nx, ny;       ///< Size of the part
+  };
+  std::vector<Source> sources;
+
+  /// The file for anything which isn't a whole field
+  DataFormat& first() { return repartitioned ? *sources.front().file : *file; }
+
+  /// Is reading \p lx, \p ly, \p lz from the origin a whole field?
+  bool isField(int lx, int ly, int lz) const;
+
+  /// Read the parts of field \p name, with \p lz points in Z (0 for
+  /// a Field2D), from the old files. Reads the current record if
+  /// \p record is true
+  template <typename T>
+  bool readField(T* var, const std::string& name, int lz, bool record = false);
+};
+
+#endif // __REPARTITIONFORMAT_H__
@@ -0,0 +1,311 @@
+#include "shared_read.hxx"
+
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <msg_stack.hxx>
+
+#include <algorithm>
+#include <exception>
+
+namespace {
+MPI_Datatype mpiType(const int*) { return MPI_INT; }
+MPI_Datatype mpiType(const BoutReal*) { return MPI_DOUBLE; }
+
+/// Send \p value from rank 0 to the other processors in \p comm
+void broadcast(int& value, MPI_Comm comm) { MPI_Bcast(&value, 1, MPI_INT, 0, comm); }
+
+void broadcast(BoutReal& value, MPI_Comm comm) {
+  MPI_Bcast(&value, 1, MPI_DOUBLE, 0, comm);
+}
+
+void broadcast(std::string& value, MPI_Comm comm) {
+  int length = static_cast<int>(value.size());
+  broadcast(length, comm);
+  value.resize(length);
+  MPI_Bcast(&value[0], length, MPI_CHAR, 0, comm);
+}
+
+void broadcast(std::vector<int>& value, MPI_Comm comm) {
+  int length = static_cast<int>(value.size());
+  broadcast(length, comm);
+  value.resize(length);
+  MPI_Bcast(value.data(), length, MPI_INT, 0, comm);
+}
+
+/// Number of values read by \p request, following the DataFormat
+/// convention that a length of zero is a missing dimension
+int count(const std::array<int, 7>& request) {
+  return request[3] * std::max(request[4], 1) * std::max(request[5], 1);
+}
+} // namespace
+
+SharedReadFormat::SharedReadFormat(std::unique_ptr<DataFormat> format, int group_size) {
+  MPI_Comm world = BoutComm::get();
+  int rank;
+  MPI_Comm_rank(world, &rank);
+
+  if (group_size > 0) {
+    MPI_Comm_split(world, rank / group_size, rank, &comm);
+  } else if (group_size == 0) {
+    MPI_Comm_split_type(world, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &comm);
+  } else {
+    throw BoutException("SharedReadFormat: group_size must not be negative, but is %d",
+                        group_size);
+  }
+
+  int group_rank;
+  MPI_Comm_rank(comm, &group_rank);
+  reader = (group_rank == 0);
+
+  if (reader) {
+    file = std::move(format);
+  }
+}
+
+SharedReadFormat::~SharedReadFormat() {
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    MPI_Comm_free(&comm);
+  }
+}
+
+bool SharedReadFormat::openr(const char* name) {
+  TRACE("SharedReadFormat::openr");
+
+  close();
+
+  int success = 0;
+  if (reader) {
+    success = file->openr(name);
+  }
+  broadcast(success, comm);
+  valid = (success != 0);
+
+  return valid;
+}
+
+void SharedReadFormat::close() {
+  if (reader and file->is_valid()) {
+    file->close();
+  }
+  valid = false;
+
+  cache_int.clear();
+  cache_real.clear();
+  sizes.clear();
+  attributes_string.clear();
+  attributes_int.clear();
+  attributes_real.clear();
+}
+
+const std::vector<int> SharedReadFormat::getSize(const std::string& var) {
+  if (!valid) {
+    return {};
+  }
+
+  auto found = sizes.find(var);
+  if (found == sizes.end()) {
+    std::vector<int> size;
+    if (reader) {
+      size = file->getSize(var);
+    }
+    broadcast(size, comm);
+    found = sizes.emplace(var, size).first;
+  }
+  return found->second;
+}
+
+bool SharedReadFormat::setGlobalOrigin(int x, int y, int z) {
+  x0 = x;
+  y0 = y;
+  z0 = z;
+  return true;
+}
+
+bool SharedReadFormat::read(int* var, const std::string& name, int lx, int ly, int lz) {
+  TRACE("SharedReadFormat::read(int)");
+  return readShared(var, name, {x0, y0, z0, lx, ly, lz, 0}, cache_int);
+}
+
+bool SharedReadFormat::read(BoutReal* var, const std::string& name, int lx, int ly,
+                            int lz) {
+  TRACE("SharedReadFormat::read(BoutReal)");
+  return readShared(var, name, {x0, y0, z0, lx, ly, lz, 0}, cache_real);
+}
+
+bool SharedReadFormat::read_perp(BoutReal* var, const std::string& name, int lx,
+                                 int lz) {
+  TRACE("SharedReadFormat::read_perp");
+  return readShared(var, name, {x0, y0, z0, lx, 0, lz, 1}, cache_real);
+}
+
+bool SharedReadFormat::readFile(int* var, const std::string& name,
+                                const Request& request) {
+  file->setGlobalOrigin(request[0], request[1], request[2]);
+  const bool success = file->read(var, name, request[3], request[4], request[5]);
+  file->setGlobalOrigin();
+  return success;
+}
+
+bool SharedReadFormat::readFile(BoutReal* var, const std::string& name,
+                                const Request& request) {
+  file->setGlobalOrigin(request[0], request[1], request[2]);
+  const bool success = (request[6] != 0)
+                           ? file->read_perp(var, name, request[3], request[5])
+                           : file->read(var, name, request[3], request[4], request[5]);
+  file->setGlobalOrigin();
+  return success;
+}
+
+template <typename T>
+bool SharedReadFormat::readShared(T* var, const std::string& name, Request request,
+                                  std::map<Key, std::vector<T>>& cache) {
+  if (!valid) {
+    return false;
+  }
+
+  // Still take part with bad lengths, so the other processors don't wait forever
+  const bool bad_request = (request[3] < 0) or (request[4] < 0) or (request[5] < 0);
+  if (bad_request) {
+    request[3] = request[4] = request[5] = 0;
+  }
+
+  int nprocs;
+  MPI_Comm_size(comm, &nprocs);
+
+  std::vector<Request> requests(reader ? nprocs : 0);
+  const int request_size = std::tuple_size<Request>::value;
+  MPI_Gather(request.data(), request_size, MPI_INT, requests.data(), request_size, MPI_INT,
+             0, comm);
+
+  std::vector<int> success(reader ? nprocs : 0);
+  std::vector<int> counts(reader ? nprocs : 0);
+  std::vector<int> displacements(reader ? nprocs : 0);
+  std::vector<T> data;
+  std::exception_ptr error;
+
+  if (reader) {
+    // How many processors want each part of the variable?
+    std::map<Request, int> wanted;
+    for (const auto& r : requests) {
+      ++wanted[r];
+    }
+
+    // Read each part once
+    std::map<Request, std::pair<bool, std::vector<T>>> results;
+    for (const auto& part : wanted) {
+      auto& result = results[part.first];
+
+      const auto cached = cache.find({name, part.first});
+      if (cached != cache.end()) {
+        result = {true, cached->second};
+        continue;
+      }
+
+      result.second.resize(count(part.first));
+      if (result.second.empty()) {
+        result.first = true;
+        continue;
+      }
+
+      try {
+        result.first = readFile(result.second.data(), name, part.first);
+      } catch (...) {
+        // Re-thrown once the other processors have been told
+        result.first = false;
+        error = std::current_exception();
+      }
+
+      if (result.first and part.second > 1) {
+        // Shared by several processors, so probably wanted again
+        cache[{name, part.first}] = result.second;
+      }
+    }
+
+    for (int proc = 0; proc < nprocs; ++proc) {
+      const auto& result = results[requests[proc]];
+      success[proc] = result.first;
+      counts[proc] = result.first ? result.second.size() : 0;
+      displacements[proc] = data.size();
+      if (result.first) {
+        data.insert(data.end(), result.second.begin(), result.second.end());
+      }
+    }
+  }
+
+  int ok;
+  MPI_Scatter(success.data(), 1, MPI_INT, &ok, 1, MPI_INT, 0, comm);
+  MPI_Scatterv(data.data(), counts.data(), displacements.data(), mpiType(var), var,
+               ok ? count(request) : 0, mpiType(var), 0, comm);
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  return (ok != 0) and not bad_request;
+}
+
+template <typename T>
+bool SharedReadFormat::getAttributeShared(
+    const std::string& varname, const std::string& attrname, T& value,
+    std::map<std::pair<std::string, std::string>, std::pair<bool, T>>& attributes) {
+  if (!valid) {
+    return false;
+  }
+
+  const auto key = std::make_pair(varname, attrname);
+  auto found = attributes.find(key);
+  if (found == attributes.end()) {
+    std::pair<bool, T> attribute{false, T{}};
+    if (reader) {
+      attribute.first = file->getAttribute(varname, attrname, attribute.second);
+    }
+
+    int success = attribute.first;
+    broadcast(success, comm);
+    attribute.first = (success != 0);
+    if (attribute.first) {
+      broadcast(attribute.second, comm);
+    }
+    found = attributes.emplace(key, attribute).first;
+  }
+
+  if (found->second.first) {
+    value = found->second.second;
+  }
+  return found->second.first;
+}
+
+bool SharedReadFormat::getAttribute(const std::string& varname,
+                                    const std::string& attrname, std::string& text) {
+  return getAttributeShared(varname, attrname, text, attributes_string);
+}
+
+bool SharedReadFormat::getAttribute(const std::string& varname,
+                                    const std::string& attrname, int& value) {
+  return getAttributeShared(varname, attrname, value, attributes_int);
+}
+
+bool SharedReadFormat::getAttribute(const std::string& varname,
+                                    const std::string& attrname, BoutReal& value) {
+  return getAttributeShared(varname, attrname, value, attributes_real);
+}
+
+void SharedReadFormat::setAttribute(const std::string& UNUSED(varname),
+                                    const std::string& UNUSED(attrname),
+                                    const std::string& UNUSED(text)) {
+  throw BoutException("SharedReadFormat is read-only, so can't set attributes");
+}
+
+void SharedReadFormat::setAttribute(const std::string& UNUSED(varname),
+                                    const std::string& UNUSED(attrname),
+                                    int UNUSED(value)) {
+  throw BoutException("SharedReadFormat is read-only, so can't set attributes");
+}
+
+void SharedReadFormat::setAttribute(const std::string& UNUSED(varname),
+                                    const std::string& UNUSED(attrname),
+                                    BoutReal UNUSED(value)) {
+  throw BoutException("SharedReadFormat is read-only, so can't set attributes");
+}
@@ -0,0 +1,238 @@
+/*!
+ * \file shared_read.hxx
+ *
+ * \brief Read-only data format shared between a group of processors
+ *
+ * Only one processor in each group (by default, each node) opens the
+ * file. The others send it what they want to read, and it sends them
+ * back the data. This avoids every processor opening the same file
+ * at the same time, which can be very slow on large machines.
+ *
+ * Every read and query is collective over the group: all processors
+ * in the group must make the same calls in the same order, though
+ * each can read a different part of a variable. A processor which
+ * doesn't need any of a variable still has to take part, reading
+ * zero elements. Sizes and attributes are remembered, and data which
+ * more than one processor reads (scalars, 1D profiles) is kept by
+ * the reading processor, so asking for them again is cheap.
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+class SharedReadFormat;
+
+#ifndef __SHAREDREADFORMAT_H__
+#define __SHAREDREADFORMAT_H__
+
+#include "dataformat.hxx"
+#include "unused.hxx"
+
+#include <mpi.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class SharedReadFormat : public DataFormat {
+public:
+  /// Read using \p format, on one processor in each group of
+  /// \p group_size processors. If \p group_size is 0, each group is
+  /// the processors on one node
+  SharedReadFormat(std::unique_ptr<DataFormat> format, int group_size = 0);
+  ~SharedReadFormat() override;
+
+  using DataFormat::openr;
+  bool openr(const char* name) override;
+  using DataFormat::openw;
+  bool openw(const char* UNUSED(name), bool UNUSED(append) = false) override {
+    return false;
+  }
+
+  bool isCollective() const override { return true; }
+
+  bool is_valid() override { return valid; }
+
+  void close() override;
+
+  void flush() override {}
+
+  const std::vector<int> getSize(const char* var) override {
+    return getSize(std::string(var));
+  }
+  const std::vector<int> getSize(const std::string& var) override;
+
+  bool setGlobalOrigin(int x = 0, int y = 0, int z = 0) override;
+  bool setRecord(int UNUSED(t)) override { return false; }
+
+  // Read-only, so variables can't be added
+  bool addVarInt(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarBoutReal(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarField2D(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarField3D(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+  bool addVarFieldPerp(const std::string& UNUSED(name), bool UNUSED(repeat)) override {
+    return false;
+  }
+
+  bool read(int* var, const char* name, int lx = 1, int ly = 0, int lz = 0) override {
+    return read(var, std::string(name), lx, ly, lz);
+  }
+  bool read(int* var, const std::string& name, int lx = 1, int ly = 0,
+            int lz = 0) override;
+  bool read(BoutReal* var, const char* name, int lx = 1, int ly = 0,
+            int lz = 0) override {
+    return read(var, std::string(name), lx, ly, lz);
+  }
+  bool read(BoutReal* var, const std::string& name, int lx = 1, int ly = 0,
+            int lz = 0) override;
+  bool read_perp(BoutReal* var, const std::string& name, int lx = 1,
+                 int lz = 0) override;
+
+  bool write(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write(BoutReal* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+             int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                  int UNUSED(lx) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  // Grid files have no records
+  bool read_rec(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 1,
+                int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 1,
+                int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 1,
+                int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                int UNUSED(lx) = 1, int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool read_rec_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                     int UNUSED(lx) = 1, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  bool write_rec(int* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(int* UNUSED(var), const std::string& UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(BoutReal* UNUSED(var), const char* UNUSED(name), int UNUSED(lx) = 0,
+                 int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                 int UNUSED(lx) = 0, int UNUSED(ly) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+  bool write_rec_perp(BoutReal* UNUSED(var), const std::string& UNUSED(name),
+                      int UNUSED(lx) = 0, int UNUSED(lz) = 0) override {
+    return false;
+  }
+
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    const std::string& text) override;
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    int value) override;
+  void setAttribute(const std::string& varname, const std::string& attrname,
+                    BoutReal value) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    std::string& text) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    int& value) override;
+  bool getAttribute(const std::string& varname, const std::string& attrname,
+                    BoutReal& value) override;
+
+private:
+  /// The file, only on the reading processor (rank 0 in comm)
+  std::unique_ptr<DataFormat> file;
+  /// The processors sharing this file
+  MPI_Comm comm{MPI_COMM_NULL};
+  bool reader{false};
+  bool valid{false};
+
+  int x0{0}, y0{0}, z0{0};
+
+  /// What each processor asks to read: origin, lengths, and whether
+  /// it is read_perp
+  using Request = std::array<int, 7>;
+  using Key = std::pair<std::string, Request>;
+
+  /// Data read by more than one processor, on the reading processor
+  std::map<Key, std::vector<int>> cache_int;
+  std::map<Key, std::vector<BoutReal>> cache_real;
+
+  /// Sizes and attributes, on all processors
+  std::map<std::string, std::vector<int>> sizes;
+  std::map<std::pair<std::string, std::string>, std::pair<bool, std::string>>
+      attributes_string;
+  std::map<std::pair<std::string, std::string>, std::pair<bool, int>> attributes_int;
+  std::map<std::pair<std::string, std::string>, std::pair<bool, BoutReal>>
+      attributes_real;
+
+  /// Collectively read into \p var, which has room for this
+  /// processor's part of variable \p name
+  template <typename T>
+  bool readShared(T* var, const std::string& name, Request request,
+                  std::map<Key, std::vector<T>>& cache);
+
+  /// Read \p request of \p name from the file, on the reading processor
+  bool readFile(int* var, const std::string& name, const Request& request);
+  bool readFile(BoutReal* var, const std::string& name, const Request& request);
+
+  /// Get an attribute on the reading processor, and send it to the others
+  template <typename T>
+  bool getAttributeShared(const std::string& varname, const std::string& attrname,
+                          T& value,
+                          std::map<std::pair<std::string, std::string>,
+                                   std::pair<bool, T>>& attributes);
+};
+
+#endif // __SHAREDREADFORMAT_H__
@@ -35,7 +35,10 @@
 #include <bout/openmpwrap.hxx>
 
 #include <fftw3.h>
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <tuple>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -224,7 +227,7 @@ void rfft(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length), MAYBE_UNUS
     // use a `single` block here as that requires all threads to reach the
     // block (implicit barrier) which may not be true in all cases (e.g.
     // if there are 8 threads but only 4 call the fft routine).
-    BOUT_OMP(critical(rfft))
+    BOUT_OMP(critical(fftw_planner))
     if ((size != length) || (nthreads < n_th)) {
       if(size > 0) {
         // Free all memory
@@ -299,7 +302,7 @@ void irfft(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length), MAYBE_UNU
     // use a `single` block here as that requires all threads to reach the
     // block (implicit barrier) which may not be true in all cases (e.g.
     // if there are 8 threads but only 4 call the fft routine).
-    BOUT_OMP(critical(irfft))
+    BOUT_OMP(critical(fftw_planner))
     if ((size != length) || (nthreads < n_th)) {
       if (size > 0) {
         // Free all memory
@@ -351,6 +354,158 @@ void irfft(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length), MAYBE_UNU
 }
 #endif
 
+/***********************************************************
+ * Batched real FFTs
+ ***********************************************************/
+
+#ifdef BOUT_HAS_FFTW
+namespace {
+/// Batched plans are cached, keyed on the length of each transform,
+/// the number of transforms, and whether the input and output
+/// arrays have the SIMD alignment FFTW would like. The signals are
+/// always contiguous, so the stride and distance between them are
+/// determined by the length.
+using ManyPlanKey = std::tuple<int, int, bool>;
+
+/// Are both \p in and \p out aligned like arrays from fftw_malloc?
+bool fftwAligned(const void* in, const void* out) {
+  return fftw_alignment_of(static_cast<double*>(const_cast<void*>(in))) == 0
+         and fftw_alignment_of(static_cast<double*>(const_cast<void*>(out))) == 0;
+}
+
+unsigned int manyPlanFlags(bool aligned) {
+  unsigned int flags = fft_measure ? FFTW_MEASURE : FFTW_ESTIMATE;
+  if (not aligned) {
+    flags |= FFTW_UNALIGNED;
+  }
+  return flags;
+}
+
+/// Get a plan for \p howmany real-to-complex transforms of \p length
+/// points, creating it if needed.
+///
+/// FFTW planning is not thread-safe, so this is done in the
+/// fftw_planner critical section, which every planner call in this
+/// file shares. Plans are created on scratch arrays and then executed on
+/// the user's arrays with the new-array execute functions, which
+/// are thread-safe, so a single plan can be shared between threads
+fftw_plan getManyPlanR2C(int length, int howmany, bool aligned) {
+  static std::map<ManyPlanKey, fftw_plan> plans;
+
+  fftw_plan plan;
+  BOUT_OMP(critical(fftw_planner))
+  {
+    const ManyPlanKey key{length, howmany, aligned};
+    auto found = plans.find(key);
+    if (found == plans.end()) {
+      fft_init();
+
+      const int nmodes = (length / 2) + 1;
+      auto* fin = static_cast<double*>(fftw_malloc(sizeof(double) * length * howmany));
+      auto* fout = static_cast<fftw_complex*>(
+          fftw_malloc(sizeof(fftw_complex) * nmodes * howmany));
+
+      plan = fftw_plan_many_dft_r2c(1, &length, howmany, fin, nullptr, 1, length, fout,
+                                    nullptr, 1, nmodes,
+                                    manyPlanFlags(aligned) | FFTW_PRESERVE_INPUT);
+
+      fftw_free(fin);
+      fftw_free(fout);
+
+      plans.emplace(key, plan);
+    } else {
+      plan = found->second;
+    }
+  }
+  return plan;
+}
+
+/// Get a plan for \p howmany complex-to-real transforms producing
+/// \p length points. See getManyPlanR2C
+fftw_plan getManyPlanC2R(int length, int howmany, bool aligned) {
+  static std::map<ManyPlanKey, fftw_plan> plans;
+
+  fftw_plan plan;
+  BOUT_OMP(critical(fftw_planner))
+  {
+    const ManyPlanKey key{length, howmany, aligned};
+    auto found = plans.find(key);
+    if (found == plans.end()) {
+      fft_init();
+
+      const int nmodes = (length / 2) + 1;
+      auto* fin = static_cast<fftw_complex*>(
+          fftw_malloc(sizeof(fftw_complex) * nmodes * howmany));
+      auto* fout = static_cast<double*>(fftw_malloc(sizeof(double) * length * howmany));
+
+      plan = fftw_plan_many_dft_c2r(1, &length, howmany, fin, nullptr, 1, nmodes, fout,
+                                    nullptr, 1, length, manyPlanFlags(aligned));
+
+      fftw_free(fin);
+      fftw_free(fout);
+
+      plans.emplace(key, plan);
+    } else {
+      plan = found->second;
+    }
+  }
+  return plan;
+}
+} // namespace
+#endif
+
+void rfft_many(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length),
+               MAYBE_UNUSED(int howmany), MAYBE_UNUSED(dcomplex *out)) {
+#ifndef BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  ASSERT1(length > 0);
+  ASSERT1(howmany >= 0);
+
+  if (howmany == 0) {
+    return;
+  }
+
+  const fftw_plan plan = getManyPlanR2C(length, howmany, fftwAligned(in, out));
+
+  // The input is preserved by the plan, and std::complex<double> is
+  // guaranteed to be layout-compatible with fftw_complex, so we can
+  // transform directly between the caller's arrays
+  fftw_execute_dft_r2c(plan, const_cast<BoutReal*>(in),
+                       reinterpret_cast<fftw_complex*>(out));
+
+  // Normalise
+  const BoutReal fac = 1.0 / static_cast<BoutReal>(length);
+  const int ntotal = ((length / 2) + 1) * howmany;
+  for (int i = 0; i < ntotal; i++) {
+    out[i] *= fac;
+  }
+#endif
+}
+
+void irfft_many(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length),
+                MAYBE_UNUSED(int howmany), MAYBE_UNUSED(BoutReal *out)) {
+#ifndef BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  ASSERT1(length > 0);
+  ASSERT1(howmany >= 0);
+
+  if (howmany == 0) {
+    return;
+  }
+
+  // Complex-to-real transforms overwrite their input, so work on a copy
+  const int ntotal = ((length / 2) + 1) * howmany;
+  Array<dcomplex> fin(ntotal);
+  std::copy(in, in + ntotal, fin.begin());
+
+  const fftw_plan plan = getManyPlanC2R(length, howmany, fftwAligned(fin.begin(), out));
+
+  fftw_execute_dft_c2r(plan, reinterpret_cast<fftw_complex*>(fin.begin()), out);
+#endif
+}
+
 //  Discrete sine transforms (B Shanahan)
 
 void DST(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length), MAYBE_UNUSED(dcomplex *out)) {
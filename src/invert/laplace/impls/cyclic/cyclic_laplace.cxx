@@ -41,6 +41,7 @@
 #include <bout/sys/timer.hxx>
 #include <bout/constants.hxx>
 #include <output.hxx>
+#include <algorithm>
 
 #include "cyclic_laplace.hxx"
 
@@ -388,19 +389,29 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       }
     }
   } else {
+    // Number of Z modes from the FFT, including those we filter out
+    const int nmode_fft = localmesh->LocalNz / 2 + 1;
+
+    // The Z-lines for consecutive Y at a given X are contiguous, so we
+    // FFT up to ny_batch of them together. The work is shared over X
+    // and these blocks of Y, as there may be only a few X points
+    constexpr int ny_batch = 8;
+    const int nyblocks = (ny + ny_batch - 1) / ny_batch;
+    const int nxblocks = nx * nyblocks;
+
     BOUT_OMP(parallel) {
       /// Create a local thread-scope working array
-      auto k1d = Array<dcomplex>(localmesh->LocalNz / 2 +
-                                 1); // ZFFT routine expects input of this length
+      auto k1d = Array<dcomplex>(ny_batch * nmode_fft);
 
       // Loop over X and Y indices, including boundaries but not guard cells
       // (unless periodic in x)
 
       BOUT_OMP(for)
-      for (int ind = 0; ind < nxny; ++ind) {
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
-        int iy = ys + ind % ny;
+      for (int ind = 0; ind < nxblocks; ++ind) {
+        // ind = (ix - xs)*nyblocks + (iy_first - ys) / ny_batch
+        const int ix = xs + ind / nyblocks;
+        const int iy_first = ys + (ind % nyblocks) * ny_batch;
+        const int nlines = std::min(ny_batch, ye - iy_first + 1);
 
         // Take FFT in Z direction, apply shift, and put result in k1d
 
@@ -408,14 +419,19 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
             ((localmesh->LocalNx - ix - 1 < outbndry) && (outer_boundary_flags & INVERT_SET) &&
              localmesh->lastX())) {
           // Use the values in x0 in the boundary
-          rfft(x0(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          bout::fft::rfft_many(x0(ix, iy_first), localmesh->LocalNz, nlines,
+                               std::begin(k1d));
         } else {
-          rfft(rhs(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          bout::fft::rfft_many(rhs(ix, iy_first), localmesh->LocalNz, nlines,
+                               std::begin(k1d));
         }
 
         // Copy into array, transposing so kz is first index
-        for (int kz = 0; kz < nmode; kz++)
-          bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k1d[kz];
+        for (int iy = iy_first; iy < iy_first + nlines; ++iy) {
+          for (int kz = 0; kz < nmode; kz++)
+            bcmplx3D((iy - ys) * nmode + kz, ix - xs) =
+                k1d[(iy - iy_first) * nmode_fft + kz];
+        }
       }
 
       // Get elements of the tridiagonal matrix
@@ -443,28 +459,32 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
     // FFT back to real space
     BOUT_OMP(parallel) {
       /// Create a local thread-scope working array
-      auto k1d = Array<dcomplex>((localmesh->LocalNz) / 2 +
-                                 1); // ZFFT routine expects input of this length
+      auto k1d = Array<dcomplex>(ny_batch * nmode_fft);
 
       const bool zero_DC = global_flags & INVERT_ZERO_DC;
 
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nxny; ++ind) { // Loop over X and Y
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
-        int iy = ys + ind % ny;
+      for (int ind = 0; ind < nxblocks; ++ind) { // Loop over X and blocks of Y
+        const int ix = xs + ind / nyblocks;
+        const int iy_first = ys + (ind % nyblocks) * ny_batch;
+        const int nlines = std::min(ny_batch, ye - iy_first + 1);
 
-        if (zero_DC) {
-          k1d[0] = 0.;
-        }
+        for (int iy = iy_first; iy < iy_first + nlines; ++iy) {
+          dcomplex* k1d_y = &k1d[(iy - iy_first) * nmode_fft];
 
-        for (int kz = zero_DC; kz < nmode; kz++)
-          k1d[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+          if (zero_DC) {
+            k1d_y[0] = 0.;
+          }
 
-        for (int kz = nmode; kz < localmesh->LocalNz / 2 + 1; kz++)
-          k1d[kz] = 0.0; // Filtering out all higher harmonics
+          for (int kz = zero_DC; kz < nmode; kz++)
+            k1d_y[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+
+          for (int kz = nmode; kz < nmode_fft; kz++)
+            k1d_y[kz] = 0.0; // Filtering out all higher harmonics
+        }
 
-        irfft(std::begin(k1d), localmesh->LocalNz, x(ix, iy));
+        bout::fft::irfft_many(std::begin(k1d), localmesh->LocalNz, nlines,
+                              x(ix, iy_first));
       }
     }
   }
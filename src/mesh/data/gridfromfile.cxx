@@ -17,6 +17,7 @@
 
 #include <unused.hxx>
 
+#include <algorithm>
 #include <utility>
 
 /*!
@@ -382,13 +383,20 @@ void GridFile::readField(Mesh* UNUSED(m), const std::string& name, int ys, int y
 
   var.allocate();
 
-  for(int x = xs; x < xs+nx_to_read; x++) {
-    file->setGlobalOrigin(x,ys,0);
-    if (!file->read(&var(x-xs+xd, yd), name, 1, ny_to_read) ) {
-      throw BoutException("Could not fetch data for '%s'", name.c_str());
-    }
+  // Read the whole block at once, rather than one x-index at a time
+  Array<BoutReal> data(nx_to_read * ny_to_read);
+
+  file->setGlobalOrigin(xs, ys, 0);
+  if (!file->read(std::begin(data), name, nx_to_read, ny_to_read)) {
+    throw BoutException("Could not fetch data for '%s'", name.c_str());
   }
   file->setGlobalOrigin();
+
+  for (int x = 0; x < nx_to_read; x++) {
+    for (int y = 0; y < ny_to_read; y++) {
+      var(x + xd, y + yd) = data[x * ny_to_read + y];
+    }
+  }
 }
 
 void GridFile::readField(Mesh* m, const std::string& name, int ys, int yd,
@@ -442,36 +450,41 @@ void GridFile::readField(Mesh* m, const std::string& name, int UNUSED(ys), int U
   int yindex = var.getIndex();
 
   if (yindex >= 0 and yindex <= m->LocalNy) {
-    // Only read if yindex is on this processor
-
     var.allocate();
+  } else if (file->isCollective()) {
+    // Not on this processor, but the other processors sharing the
+    // file still need this one to take part in reading it
+    nx_to_read = 0;
+  } else {
+    // Only read if yindex is on this processor
+    return;
+  }
 
-    // Check whether "nz" is defined
-    if (hasVar("nz")) {
-      // Check the array is the right size
-      if (size[2] != m->LocalNz) {
-        throw BoutException("FieldPerp variable '%s' has incorrect size %d (expecting %d)",
-            name.c_str(), size[2], m->LocalNz);
-      }
+  // Check whether "nz" is defined
+  if (hasVar("nz")) {
+    // Check the array is the right size
+    if (size[2] != m->LocalNz) {
+      throw BoutException("FieldPerp variable '%s' has incorrect size %d (expecting %d)",
+          name.c_str(), size[2], m->LocalNz);
+    }
 
-      if (!readgrid_perpvar_real(name,
-            xs,// Start reading at global x-index
-            xd,// Insert data starting from x=xd
-            nx_to_read, // Length of data in X
-            var) ) {
-        throw BoutException("\tWARNING: Could not read '%s' from grid. Setting to zero\n",
-            name.c_str());
-      }
-    } else {
-      // No Z size specified in file. Assume FFT format
-      if (!readgrid_perpvar_fft(m, name,
-            xs,// Start reading at global x-index
-            xd,// Insert data starting from x=xd
-            nx_to_read, // Length of data in X
-            var) ) {
-        throw BoutException("\tWARNING: Could not read '%s' from grid. Setting to zero\n",
-            name.c_str());
-      }
+    if (!readgrid_perpvar_real(name,
+          xs,// Start reading at global x-index
+          xd,// Insert data starting from x=xd
+          nx_to_read, // Length of data in X
+          var) ) {
+      throw BoutException("\tWARNING: Could not read '%s' from grid. Setting to zero\n",
+          name.c_str());
+    }
+  } else {
+    // No Z size specified in file. Assume FFT format
+    if (!readgrid_perpvar_fft(m, name,
+          xs,// Start reading at global x-index
+          xd,// Insert data starting from x=xd
+          nx_to_read, // Length of data in X
+          var) ) {
+      throw BoutException("\tWARNING: Could not read '%s' from grid. Setting to zero\n",
+          name.c_str());
     }
   }
 }
@@ -589,18 +602,19 @@ bool GridFile::readgrid_3dvar_fft(Mesh *m, const std::string &name,
 
   /// Data for FFT. Only positive frequencies
   Array<dcomplex> fdata(ncz / 2 + 1);
-  Array<BoutReal> zdata(size[2]);
 
-  for (int jx = xread; jx < xread+xsize; jx++) {
-    // jx is global x-index to start from
+  // Read the whole block at once, then transform each Z-line
+  Array<BoutReal> data(xsize * ysize * size[2]);
 
-    for (int jy = yread; jy < yread+ysize; jy++) {
-      // jy is global y-index to start from
+  file->setGlobalOrigin(xread, yread);
+  if (!file->read(std::begin(data), name, xsize, ysize, size[2])) {
+    return false;
+  }
+  file->setGlobalOrigin();
 
-      file->setGlobalOrigin(jx, jy);
-      if (!file->read(std::begin(zdata), name, 1, 1, size[2])) {
-        return false;
-      }
+  for (int jx = 0; jx < xsize; jx++) {
+    for (int jy = 0; jy < ysize; jy++) {
+      const BoutReal* zdata = &data[(jx * ysize + jy) * size[2]];
 
       /// Load into dcomplex array
 
@@ -616,12 +630,10 @@ bool GridFile::readgrid_3dvar_fft(Mesh *m, const std::string &name,
           fdata[i] = 0.0;
         }
       }
-      irfft(std::begin(fdata), ncz, &var(jx-xread+xdest, jy-yread+ydest, 0));
+      irfft(std::begin(fdata), ncz, &var(jx + xdest, jy + ydest, 0));
     }
   }
 
-  file->setGlobalOrigin();
-  
   return true;
 }
 
@@ -646,20 +658,22 @@ bool GridFile::readgrid_3dvar_real(const std::string &name,
     return false;
   }
   
-  for (int jx = xread; jx < xread+xsize; jx++) {
-    // jx is global x-index to start from
-
-    for (int jy = yread; jy < yread+ysize; jy++) {
-      // jy is global y-index to start from
-      
-      file->setGlobalOrigin(jx, jy);
-      if (!file->read(&var(jx-xread+xdest, jy-yread+ydest, 0), name, 1, 1, size[2])) {
-        return false;
-      }
-    }
+  // Read the whole block at once, rather than one Z-line at a time
+  Array<BoutReal> data(xsize * ysize * size[2]);
+
+  file->setGlobalOrigin(xread, yread);
+  if (!file->read(std::begin(data), name, xsize, ysize, size[2])) {
+    return false;
   }
   file->setGlobalOrigin();
-  
+
+  for (int jx = 0; jx < xsize; jx++) {
+    for (int jy = 0; jy < ysize; jy++) {
+      std::copy_n(&data[(jx * ysize + jy) * size[2]], size[2],
+                  &var(jx + xdest, jy + ydest, 0));
+    }
+  }
+
   return true;
 }
 
@@ -720,15 +734,18 @@ bool GridFile::readgrid_perpvar_fft(Mesh *m, const std::string &name,
 
   /// Data for FFT. Only positive frequencies
   Array<dcomplex> fdata(ncz / 2 + 1);
-  Array<BoutReal> zdata(size[1]);
 
-  for (int jx = xread; jx < xread+xsize; jx++) {
-    // jx is global x-index to start from
+  // Read the whole block at once, then transform each Z-line
+  Array<BoutReal> data(xsize * size[1]);
 
-    file->setGlobalOrigin(jx, 0);
-    if (!file->read_perp(std::begin(zdata), name, 1, size[1])) {
-      return false;
-    }
+  file->setGlobalOrigin(xread, 0);
+  if (!file->read_perp(std::begin(data), name, xsize, size[1])) {
+    return false;
+  }
+  file->setGlobalOrigin();
+
+  for (int jx = 0; jx < xsize; jx++) {
+    const BoutReal* zdata = &data[jx * size[1]];
 
     /// Load into dcomplex array
 
@@ -744,11 +761,9 @@ bool GridFile::readgrid_perpvar_fft(Mesh *m, const std::string &name,
         fdata[i] = 0.0;
       }
     }
-    irfft(std::begin(fdata), ncz, &var(jx-xread+xdest, 0));
+    irfft(std::begin(fdata), ncz, &var(jx + xdest, 0));
   }
 
-  file->setGlobalOrigin();
-
   return true;
 }
 
@@ -771,16 +786,19 @@ bool GridFile::readgrid_perpvar_real(const std::string &name,
     return false;
   }
 
-  for (int jx = xread; jx < xread+xsize; jx++) {
-    // jx is global x-index to start from
+  // Read the whole block at once, rather than one Z-line at a time
+  Array<BoutReal> data(xsize * size[1]);
 
-    file->setGlobalOrigin(jx, 0);
-    if (!file->read_perp(&var(jx-xread+xdest, 0), name, 1, size[1])) {
-      return false;
-    }
+  file->setGlobalOrigin(xread, 0);
+  if (!file->read_perp(std::begin(data), name, xsize, size[1])) {
+    return false;
   }
   file->setGlobalOrigin();
 
+  for (int jx = 0; jx < xsize; jx++) {
+    std::copy_n(&data[jx * size[1]], size[1], &var(jx + xdest, 0));
+  }
+
   return true;
 }
 
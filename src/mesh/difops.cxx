@@ -522,6 +522,113 @@ const Field3D b0xGrad_dot_Grad(const Field3D &phi, const Field3D &A, CELL_LOC ou
  * Terms of form b0 x Grad(f) dot Grad(g) / B = [f, g]
  *******************************************************************************/
 
+namespace {
+/// Set `out[jz] = kernel(jz, jzm, jzp) * factor` for every point
+/// `jz` of a periodic Z-line of length \p ncz, where `jzm` and `jzp`
+/// are the neighbouring points. The two ends of the line wrap around,
+/// so they are done separately, leaving a loop over the rest of the
+/// line which can be vectorised
+template <typename Kernel>
+inline void arakawaLine(BoutReal* out, int ncz, BoutReal factor, const Kernel& kernel) {
+  if (ncz == 1) {
+    out[0] = kernel(0, 0, 0) * factor;
+    return;
+  }
+
+  out[0] = kernel(0, ncz - 1, 1) * factor;
+
+  BOUT_OMP(simd)
+  for (int jz = 1; jz < ncz - 1; jz++) {
+    out[jz] = kernel(jz, jz - 1, jz + 1) * factor;
+  }
+
+  out[ncz - 1] = kernel(ncz - 1, ncz - 2, 0) * factor;
+}
+
+/// Arakawa scheme for the bracket `sign * [f, g]` of a Field3D and a
+/// Field2D, in RGN_NOBNDRY of \p result
+void arakawaBracket(const Field3D& f, const Field2D& g, const Coordinates& metric,
+                    BoutReal sign, Field3D& result) {
+  Mesh* mesh = f.getMesh();
+  const int ncz = mesh->LocalNz;
+  const BoutReal partialFactor = sign / (12 * metric.dz);
+
+  const BoutReal* f_data = &f(0, 0, 0);
+  const BoutReal* g_data = &g(0, 0);
+  BoutReal* result_data = &result(0, 0, 0);
+
+  BOUT_FOR(j2D, result.getRegion2D("RGN_NOBNDRY")) {
+    // The metric factor is the same for the whole Z-line
+    const BoutReal spacingFactor = partialFactor / metric.dx[j2D];
+
+    const BoutReal gxm = g_data[j2D.xm().ind], gc = g_data[j2D.ind],
+                   gxp = g_data[j2D.xp().ind];
+
+    // Start of the Z-lines at x-1, x and x+1
+    const BoutReal* fxm = f_data + mesh->ind2Dto3D(j2D.xm()).ind;
+    const BoutReal* fc = f_data + mesh->ind2Dto3D(j2D).ind;
+    const BoutReal* fxp = f_data + mesh->ind2Dto3D(j2D.xp()).ind;
+
+    arakawaLine(result_data + mesh->ind2Dto3D(j2D).ind, ncz, spacingFactor,
+                [&](int UNUSED(jz), int jzm, int jzp) {
+                  // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
+                  const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
+
+                  // J+x
+                  const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm])
+                                       - gxm * (fxm[jzp] - fxm[jzm])
+                                       + gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
+
+                  return Jpp + Jpx;
+                });
+  }
+}
+
+/// Arakawa scheme for the bracket `[f, g]` of two Field3Ds, in
+/// RGN_NOBNDRY of \p result
+void arakawaBracket(const Field3D& f, const Field3D& g, const Coordinates& metric,
+                    Field3D& result) {
+  Mesh* mesh = f.getMesh();
+  const int ncz = mesh->LocalNz;
+  const BoutReal partialFactor = 1.0 / (12 * metric.dz);
+
+  const BoutReal* f_data = &f(0, 0, 0);
+  const BoutReal* g_data = &g(0, 0, 0);
+  BoutReal* result_data = &result(0, 0, 0);
+
+  BOUT_FOR(j2D, result.getRegion2D("RGN_NOBNDRY")) {
+    // The metric factor is the same for the whole Z-line
+    const BoutReal spacingFactor = partialFactor / metric.dx[j2D];
+
+    // Start of the Z-lines at x-1, x and x+1
+    const int xm = mesh->ind2Dto3D(j2D.xm()).ind;
+    const int x = mesh->ind2Dto3D(j2D).ind;
+    const int xp = mesh->ind2Dto3D(j2D.xp()).ind;
+
+    const BoutReal *Fxm = f_data + xm, *Fx = f_data + x, *Fxp = f_data + xp;
+    const BoutReal *Gxm = g_data + xm, *Gx = g_data + x, *Gxp = g_data + xp;
+
+    arakawaLine(result_data + x, ncz, spacingFactor, [&](int jz, int jzm, int jzp) {
+      // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
+      const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz])
+                            - (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
+
+      // J+x
+      const BoutReal Jpx =
+          (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm])
+           - Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
+
+      // Jx+
+      const BoutReal Jxp =
+          (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm])
+           - Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
+
+      return Jpp + Jpx + Jxp;
+    });
+  }
+}
+} // namespace
+
 const Field2D bracket(const Field2D &f, const Field2D &g, BRACKET_METHOD method,
                       CELL_LOC outloc, Solver *UNUSED(solver)) {
   TRACE("bracket(Field2D, Field2D)");
@@ -602,73 +709,8 @@ const Field3D bracket(const Field3D &f, const Field2D &g, BRACKET_METHOD method,
     break;
   }
   case BRACKET_ARAKAWA: {
-    // Arakawa scheme for perpendicular flow. Here as a test
-
-    const BoutReal fac = 1.0 / (12 * metric->dz);
-    const int ncz = mesh->LocalNz;
-
-    BOUT_FOR(j2D, result.getRegion2D("RGN_NOBNDRY")) {
-      // Get constants for this iteration
-      const BoutReal spacingFactor = fac / metric->dx[j2D];
-      const int jy = j2D.y(), jx = j2D.x();
-      const int xm = jx - 1, xp = jx + 1;
-
-      // Extract relevant Field2D values
-      const BoutReal gxm = g(xm, jy), gc = g(jx, jy), gxp = g(xp, jy);
-
-      // Index Field3D as 2D to get start of z data block
-      const auto fxm = f(xm, jy), fc = f(jx, jy), fxp = f(xp, jy);
-
-      // Here we split the loop over z into three parts; the first value, the middle block
-      // and the last value
-      // this is to allow the loop used in the middle block to vectorise.
-
-      // The first value
-      {
-        const int jzp = 1;
-        const int jzm = ncz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
-
-        // J+x
-        const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm]) +
-                             gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
-
-        result(jx, jy, 0) = (Jpp + Jpx) * spacingFactor;
-      }
-
-      // The middle block
-      for (int jz = 1; jz < mesh->LocalNz - 1; jz++) {
-        const int jzp = jz + 1;
-        const int jzm = jz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
-
-        // J+x
-        const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm]) +
-                             gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
-
-        result(jx, jy, jz) = (Jpp + Jpx) * spacingFactor;
-      }
-
-      // The last value
-      {
-        const int jzp = 0;
-        const int jzm = ncz - 2;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = 2 * (fc[jzp] - fc[jzm]) * (gxp - gxm);
-
-        // J+x
-        const BoutReal Jpx = gxp * (fxp[jzp] - fxp[jzm]) - gxm * (fxm[jzp] - fxm[jzm]) +
-                             gc * (fxp[jzm] - fxp[jzp] - fxm[jzm] + fxm[jzp]);
-
-        result(jx, jy, ncz - 1) = (Jpp + Jpx) * spacingFactor;
-      }
-    }
-
+    // Arakawa scheme for perpendicular flow
+    arakawaBracket(f, g, *metric, 1.0, result);
     break;
   }
   case BRACKET_ARAKAWA_OLD: {
@@ -723,7 +765,7 @@ const Field3D bracket(const Field3D &f, const Field2D &g, BRACKET_METHOD method,
 }
 
 const Field3D bracket(const Field2D &f, const Field3D &g, BRACKET_METHOD method,
-                      CELL_LOC outloc, Solver *solver) {
+                      CELL_LOC outloc, Solver *UNUSED(solver)) {
   TRACE("bracket(Field2D, Field3D)");
 
   ASSERT1(areFieldsCompatible(f, g));
@@ -740,10 +782,12 @@ const Field3D bracket(const Field2D &f, const Field3D &g, BRACKET_METHOD method,
   case BRACKET_CTU:
     throw BoutException("Bracket method CTU is not yet implemented for [2d,3d] fields.");
     break;
-  case BRACKET_ARAKAWA: 
-    // It is symmetric, therefore we can return -[3d,2d]
-    return -bracket(g,f,method,outloc,solver);
+  case BRACKET_ARAKAWA: {
+    // It is antisymmetric, therefore we can calculate -[3d,2d]
+    result = emptyFrom(g).setLocation(outloc);
+    arakawaBracket(g, f, *f.getCoordinates(outloc), -1.0, result);
     break;
+  }
   case BRACKET_SIMPLE: {
     // Use a subset of terms for comparison to BOUT-06
     result = VDDZ(-DDX(f, outloc), g, outloc);
@@ -881,93 +925,7 @@ const Field3D bracket(const Field3D &f, const Field3D &g, BRACKET_METHOD method,
   }
   case BRACKET_ARAKAWA: {
     // Arakawa scheme for perpendicular flow
-    
-    const int ncz = mesh->LocalNz;
-    const BoutReal partialFactor = 1.0/(12 * metric->dz);
-
-    // We need to discard const qualifier in order to manipulate
-    // storage array directly
-    Field3D f_temp = f;
-    Field3D g_temp = g;
-
-    BOUT_FOR(j2D, result.getRegion2D("RGN_NOBNDRY")) {
-      const BoutReal spacingFactor = partialFactor / metric->dx[j2D];
-      const int jy = j2D.y(), jx = j2D.x();
-      const int xm = jx - 1, xp = jx + 1;
-
-      const auto Fxm = f_temp(xm, jy), Fx = f_temp(jx, jy), Fxp = f_temp(xp, jy);
-      const auto Gxm = g_temp(xm, jy), Gx = g_temp(jx, jy), Gxp = g_temp(xp, jy);
-
-      // Here we split the loop over z into three parts; the first value, the middle block
-      // and the last value
-      // this is to allow the loop used in the middle block to vectorise.
-
-      {
-        const int jz = 0;
-        const int jzp = 1;
-        const int jzm = ncz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz]) -
-                              (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
-
-        // J+x
-        const BoutReal Jpx =
-            (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm]) -
-             Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
-
-        // Jx+
-        const BoutReal Jxp =
-            (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm]) -
-             Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
-
-        result(jx, jy, jz) = (Jpp + Jpx + Jxp) * spacingFactor;
-      }
-
-      for (int jz = 1; jz < mesh->LocalNz - 1; jz++) {
-        const int jzp = jz + 1;
-        const int jzm = jz - 1;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz]) -
-                              (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
-
-        // J+x
-        const BoutReal Jpx =
-            (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm]) -
-             Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
-
-        // Jx+
-        const BoutReal Jxp =
-            (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm]) -
-             Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
-
-        result(jx, jy, jz) = (Jpp + Jpx + Jxp) * spacingFactor;
-      }
-
-      {
-        const int jz = ncz - 1;
-        const int jzp = 0;
-        const int jzm = ncz - 2;
-
-        // J++ = DDZ(f)*DDX(g) - DDX(f)*DDZ(g)
-        const BoutReal Jpp = ((Fx[jzp] - Fx[jzm]) * (Gxp[jz] - Gxm[jz]) -
-                              (Fxp[jz] - Fxm[jz]) * (Gx[jzp] - Gx[jzm]));
-
-        // J+x
-        const BoutReal Jpx =
-            (Gxp[jz] * (Fxp[jzp] - Fxp[jzm]) - Gxm[jz] * (Fxm[jzp] - Fxm[jzm]) -
-             Gx[jzp] * (Fxp[jzp] - Fxm[jzp]) + Gx[jzm] * (Fxp[jzm] - Fxm[jzm]));
-
-        // Jx+
-        const BoutReal Jxp =
-            (Gxp[jzp] * (Fx[jzp] - Fxp[jz]) - Gxm[jzm] * (Fxm[jz] - Fx[jzm]) -
-             Gxm[jzp] * (Fx[jzp] - Fxm[jz]) + Gxp[jzm] * (Fxp[jz] - Fx[jzm]));
-
-        result(jx, jy, jz) = (Jpp + Jpx + Jxp) * spacingFactor;
-      }
-    }
-
+    arakawaBracket(f, g, *metric, result);
     break;
   }
   case BRACKET_ARAKAWA_OLD: {
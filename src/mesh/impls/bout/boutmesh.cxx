@@ -36,6 +36,7 @@
 #include "boutmesh.hxx"
 
 #include <bout/constants.hxx>
+#include <bout/openmpwrap.hxx>
 #include <bout/sys/timer.hxx>
 #include <boutcomm.hxx>
 #include <boutexception.hxx>
@@ -47,6 +48,8 @@
 #include <output.hxx>
 #include <utils.hxx>
 
+#include <algorithm>
+
 /// MPI type of BoutReal for communications
 #define PVEC_REAL_MPI_TYPE MPI_DOUBLE
 
@@ -1145,8 +1148,22 @@ int BoutMesh::wait(comm_handle handle) {
   }
 
   // TWIST-SHIFT CONDITION
+  apply_twist_shift(ch->var_list);
+
+#if CHECK > 0
+  // Keeping track of whether communications have been done
+  for (const auto &var : ch->var_list)
+    var->doneComms();
+#endif
+
+  free_handle(ch);
+
+  return 0;
+}
+
+void BoutMesh::apply_twist_shift(const FieldGroup &g) {
   // Loop over 3D fields
-  for (const auto &var : ch->var_list.field3d()) {
+  for (const auto &var : g.field3d()) {
     if (var->requiresTwistShift(TwistShift)) {
 
       // Twist-shift only needed for field-aligned fields
@@ -1183,16 +1200,200 @@ int BoutMesh::wait(comm_handle handle) {
       }
     }
   }
+}
+
+/// Communication plan using persistent MPI requests
+///
+/// The messages to and from each neighbour are worked out once, when
+/// the plan is created, and the same buffers and requests are then
+/// used by every call to start()
+class BoutMesh::PersistentCommPlan : public CommunicationPlan {
+public:
+  PersistentCommPlan(BoutMesh &mesh, FieldGroup g);
+  ~PersistentCommPlan() override;
+
+  void start() override;
+  void wait() override;
+
+private:
+  /// A message to or from one neighbour
+  struct Message {
+    /// Range of the fields packed into the message
+    int xge, xlt, yge, ylt;
+    /// Processor to send to or receive from
+    int proc;
+    /// Label (tag) for the message
+    int tag;
+    /// Start of each field in the buffer
+    std::vector<int> offsets;
+    Array<BoutReal> buffer;
+  };
+
+  /// Add a message to or from \p proc, if there is one
+  void addMessage(std::vector<Message> &messages, int proc, int tag, int xge, int xlt,
+                  int yge, int ylt);
+
+  BoutMesh &mesh;
+
+  std::vector<Message> sends, receives;
+  /// Persistent requests, in the same order as sends and receives
+  std::vector<MPI_Request> send_requests, recv_requests;
+
+  bool in_progress{false};
+};
+
+BoutMesh::PersistentCommPlan::PersistentCommPlan(BoutMesh &mesh, FieldGroup g)
+    : CommunicationPlan(std::move(g)), mesh(mesh) {
+  TRACE("BoutMesh::PersistentCommPlan");
+
+  const int LocalNx = mesh.LocalNx;
+  const int MXG = mesh.MXG, MYG = mesh.MYG;
+  const int MXSUB = mesh.MXSUB, MYSUB = mesh.MYSUB;
+
+  // These must match the messages in BoutMesh::send and post_receive
+
+  // Up (y+1)
+  addMessage(sends, mesh.UDATA_INDEST, IN_SENT_UP, 0, mesh.UDATA_XSPLIT, MYSUB,
+             MYSUB + MYG);
+  addMessage(sends, mesh.UDATA_OUTDEST, OUT_SENT_UP, mesh.UDATA_XSPLIT, LocalNx, MYSUB,
+             MYSUB + MYG);
+  addMessage(receives, mesh.UDATA_INDEST, IN_SENT_DOWN, 0, mesh.UDATA_XSPLIT,
+             MYSUB + MYG, MYSUB + 2 * MYG);
+  addMessage(receives, mesh.UDATA_OUTDEST, OUT_SENT_DOWN, mesh.UDATA_XSPLIT, LocalNx,
+             MYSUB + MYG, MYSUB + 2 * MYG);
+
+  // Down (y-1)
+  addMessage(sends, mesh.DDATA_INDEST, IN_SENT_DOWN, 0, mesh.DDATA_XSPLIT, MYG, 2 * MYG);
+  addMessage(sends, mesh.DDATA_OUTDEST, OUT_SENT_DOWN, mesh.DDATA_XSPLIT, LocalNx, MYG,
+             2 * MYG);
+  addMessage(receives, mesh.DDATA_INDEST, IN_SENT_UP, 0, mesh.DDATA_XSPLIT, 0, MYG);
+  addMessage(receives, mesh.DDATA_OUTDEST, OUT_SENT_UP, mesh.DDATA_XSPLIT, LocalNx, 0,
+             MYG);
+
+  // Left (x-1)
+  addMessage(sends, mesh.IDATA_DEST, IN_SENT_OUT, MXG, 2 * MXG, MYG, MYG + MYSUB);
+  addMessage(receives, mesh.IDATA_DEST, OUT_SENT_IN, 0, MXG, MYG, MYG + MYSUB);
+
+  // Right (x+1)
+  addMessage(sends, mesh.ODATA_DEST, OUT_SENT_IN, MXSUB, MXSUB + MXG, MYG, MYG + MYSUB);
+  addMessage(receives, mesh.ODATA_DEST, IN_SENT_OUT, MXSUB + MXG, MXSUB + 2 * MXG, MYG,
+             MYG + MYSUB);
+
+  // Now the buffers won't move, create the requests
+  send_requests.resize(sends.size());
+  for (std::size_t i = 0; i < sends.size(); ++i) {
+    auto &message = sends[i];
+    MPI_Send_init(std::begin(message.buffer), message.buffer.size(), PVEC_REAL_MPI_TYPE,
+                  message.proc, message.tag, BoutComm::get(), &send_requests[i]);
+  }
+  recv_requests.resize(receives.size());
+  for (std::size_t i = 0; i < receives.size(); ++i) {
+    auto &message = receives[i];
+    MPI_Recv_init(std::begin(message.buffer), message.buffer.size(), PVEC_REAL_MPI_TYPE,
+                  message.proc, message.tag, BoutComm::get(), &recv_requests[i]);
+  }
+}
+
+BoutMesh::PersistentCommPlan::~PersistentCommPlan() {
+  int finalised;
+  MPI_Finalized(&finalised);
+  if (finalised) {
+    return;
+  }
+
+  if (in_progress) {
+    // Can't throw from a destructor, so only report the error
+    try {
+      wait();
+    } catch (const std::exception& e) {
+      output_error.write(_("Error finishing communication in ~PersistentCommPlan: %s\n"),
+                         e.what());
+    }
+  }
+  for (auto &request : send_requests) {
+    MPI_Request_free(&request);
+  }
+  for (auto &request : recv_requests) {
+    MPI_Request_free(&request);
+  }
+}
+
+void BoutMesh::PersistentCommPlan::addMessage(std::vector<Message> &messages, int proc,
+                                              int tag, int xge, int xlt, int yge,
+                                              int ylt) {
+  if (proc == -1) {
+    return;
+  }
+  auto offsets = mesh.pack_offsets(group.get(), xge, xlt, yge, ylt);
+  const int len = offsets.back();
+  messages.push_back({xge, xlt, yge, ylt, proc, tag, std::move(offsets),
+                      Array<BoutReal>(len)});
+}
+
+void BoutMesh::PersistentCommPlan::start() {
+  TRACE("BoutMesh::PersistentCommPlan::start");
+
+  if (in_progress) {
+    throw BoutException("Communication plan started again before wait() was called");
+  }
+
+  Timer timer("comms");
+
+  // Post receives first
+  if (not recv_requests.empty()) {
+    MPI_Startall(recv_requests.size(), recv_requests.data());
+  }
+
+  for (std::size_t i = 0; i < sends.size(); ++i) {
+    auto &message = sends[i];
+    mesh.pack_data(group.get(), message.offsets, message.xge, message.xlt, message.yge,
+                   message.ylt, std::begin(message.buffer));
+    MPI_Start(&send_requests[i]);
+  }
+
+  in_progress = true;
+}
+
+void BoutMesh::PersistentCommPlan::wait() {
+  TRACE("BoutMesh::PersistentCommPlan::wait");
+
+  if (not in_progress) {
+    return;
+  }
+
+  Timer timer("comms");
+
+  // Unpack messages as they arrive. Completed persistent requests
+  // become inactive, so MPI_Waitany returns MPI_UNDEFINED once
+  // everything has been received
+  int ind;
+  do {
+    MPI_Waitany(recv_requests.size(), recv_requests.data(), &ind, MPI_STATUS_IGNORE);
+    if (ind != MPI_UNDEFINED) {
+      auto &message = receives[ind];
+      mesh.unpack_data(group.get(), message.offsets, message.xge, message.xlt,
+                       message.yge, message.ylt, std::begin(message.buffer));
+    }
+  } while (ind != MPI_UNDEFINED);
+
+  // Send buffers can't be reused until the sends have finished
+  if (not send_requests.empty()) {
+    MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
+  }
+
+  in_progress = false;
+
+  mesh.apply_twist_shift(group);
 
 #if CHECK > 0
   // Keeping track of whether communications have been done
-  for (const auto &var : ch->var_list)
+  for (const auto &var : group)
     var->doneComms();
 #endif
+}
 
-  free_handle(ch);
-
-  return 0;
+std::unique_ptr<CommunicationPlan> BoutMesh::createCommunicationPlan(FieldGroup &g) {
+  return bout::utils::make_unique<PersistentCommPlan>(*this, g);
 }
 
 /***************************************************************
@@ -2000,68 +2201,112 @@ void BoutMesh::clear_handles() {
  *                   Communication utilities
  ****************************************************************/
 
+std::vector<int> BoutMesh::pack_offsets(const std::vector<FieldData *> &var_list, int xge,
+                                        int xlt, int yge, int ylt) const {
+  std::vector<int> offsets(var_list.size() + 1);
+
+  const int points = std::max(xlt - xge, 0) * std::max(ylt - yge, 0);
+
+  offsets[0] = 0;
+  for (std::size_t i = 0; i < var_list.size(); ++i) {
+    offsets[i + 1] = offsets[i] + (var_list[i]->is3D() ? points * LocalNz : points);
+  }
+  return offsets;
+}
+
 int BoutMesh::pack_data(const std::vector<FieldData *> &var_list, int xge, int xlt, int yge,
                         int ylt, BoutReal *buffer) {
+  return pack_data(var_list, pack_offsets(var_list, xge, xlt, yge, ylt), xge, xlt, yge,
+                   ylt, buffer);
+}
 
-  int len = 0;
+int BoutMesh::pack_data(const std::vector<FieldData *> &var_list,
+                        const std::vector<int> &offsets, int xge, int xlt, int yge,
+                        int ylt, BoutReal *buffer) {
+  ASSERT2(offsets.size() == var_list.size() + 1);
+
+  const int nx = xlt - xge;
+  const int ny = ylt - yge;
+  if (nx <= 0 or ny <= 0) {
+    return 0;
+  }
+
+  // Each (field, x) pair is a contiguous piece of both the field and
+  // the buffer, so can be copied in one go
+  const int nvars = var_list.size();
+  BOUT_OMP(parallel for schedule(static))
+  for (int row = 0; row < nvars * nx; ++row) {
+    const int i = row / nx;
+    const int jx = xge + row % nx;
+    FieldData *var = var_list[i];
 
-  /// Loop over variables
-  for (const auto &var : var_list) {
     if (var->is3D()) {
       // 3D variable
       ASSERT2(static_cast<Field3D *>(var)->isAllocated());
-      auto& var3d_ref = *static_cast<Field3D *>(var);
-      for (int jx = xge; jx != xlt; jx++) {
-        for (int jy = yge; jy < ylt; jy++) {
-          for (int jz = 0; jz < LocalNz; jz++, len++) {
-            buffer[len] = var3d_ref(jx, jy, jz);
-          }
-        }
-      }
+      const auto &var3d_ref = *static_cast<Field3D *>(var);
+      const BoutReal *start = var3d_ref(jx, yge);
+      std::copy(start, start + ny * LocalNz, buffer + offsets[i] + (jx - xge) * ny * LocalNz);
     } else {
       // 2D variable
       ASSERT2(static_cast<Field2D *>(var)->isAllocated());
-      auto& var2d_ref = *static_cast<Field2D *>(var);
-      for (int jx = xge; jx != xlt; jx++) {
-        for (int jy = yge; jy < ylt; jy++, len++) {
-          buffer[len] = var2d_ref(jx, jy);
-        }
-      }
+      const auto &var2d_ref = *static_cast<Field2D *>(var);
+      const BoutReal *start = &var2d_ref(jx, yge);
+      std::copy(start, start + ny, buffer + offsets[i] + (jx - xge) * ny);
     }
   }
 
-  return (len);
+  return offsets.back();
 }
 
 int BoutMesh::unpack_data(const std::vector<FieldData *> &var_list, int xge, int xlt, int yge,
                           int ylt, BoutReal *buffer) {
+  return unpack_data(var_list, pack_offsets(var_list, xge, xlt, yge, ylt), xge, xlt, yge,
+                     ylt, buffer);
+}
 
-  int len = 0;
+int BoutMesh::unpack_data(const std::vector<FieldData *> &var_list,
+                          const std::vector<int> &offsets, int xge, int xlt, int yge,
+                          int ylt, BoutReal *buffer) {
+  ASSERT2(offsets.size() == var_list.size() + 1);
+
+  const int nx = xlt - xge;
+  const int ny = ylt - yge;
+  if (nx <= 0 or ny <= 0) {
+    return 0;
+  }
+
+  // A field may be in the group more than once. Only unpack the
+  // first copy, so that threads don't write to the same place
+  const int nvars = var_list.size();
+  std::vector<int> is_duplicate(nvars, 0);
+  for (int i = 0; i < nvars; ++i) {
+    is_duplicate[i] =
+        std::find(var_list.begin(), var_list.begin() + i, var_list[i]) != var_list.begin() + i;
+  }
+
+  BOUT_OMP(parallel for schedule(static))
+  for (int row = 0; row < nvars * nx; ++row) {
+    const int i = row / nx;
+    if (is_duplicate[i]) {
+      continue;
+    }
+    const int jx = xge + row % nx;
+    FieldData *var = var_list[i];
 
-  /// Loop over variables
-  for (const auto &var : var_list) {
     if (var->is3D()) {
       // 3D variable
-      auto& var3d_ref = *static_cast<Field3D *>(var);
-      for (int jx = xge; jx != xlt; jx++) {
-        for (int jy = yge; jy < ylt; jy++) {
-          for (int jz = 0; jz < LocalNz; jz++, len++) {
-            var3d_ref(jx, jy, jz) = buffer[len];
-          }
-        }
-      }
+      auto &var3d_ref = *static_cast<Field3D *>(var);
+      const BoutReal *start = buffer + offsets[i] + (jx - xge) * ny * LocalNz;
+      std::copy(start, start + ny * LocalNz, var3d_ref(jx, yge));
     } else {
       // 2D variable
-      auto& var2d_ref = *static_cast<Field2D *>(var);
-      for (int jx = xge; jx != xlt; jx++) {
-        for (int jy = yge; jy < ylt; jy++, len++) {
-          var2d_ref(jx, jy) = buffer[len];
-        }
-      }
+      auto &var2d_ref = *static_cast<Field2D *>(var);
+      const BoutReal *start = buffer + offsets[i] + (jx - xge) * ny;
+      std::copy(start, start + ny, &var2d_ref(jx, yge));
     }
   }
 
-  return (len);
+  return offsets.back();
 }
 
 /****************************************************************
@@ -46,6 +46,19 @@ class BoutMesh : public Mesh {
   /// @param[in] handle  The handle returned by send()
   int wait(comm_handle handle) override;
 
+  /// Create a communication plan using persistent MPI requests
+  /// (MPI_Send_init/MPI_Recv_init) and fixed message buffers
+  ///
+  /// Example
+  /// -------
+  ///
+  /// // In init()
+  /// plan = mesh->createCommunicationPlan(comms);
+  /// ...
+  /// // In rhs()
+  /// mesh->communicate(*plan);
+  std::unique_ptr<CommunicationPlan> createCommunicationPlan(FieldGroup& g) override;
+
   /////////////////////////////////////////////
   // non-local communications
 
@@ -278,6 +291,8 @@ private:
   void clear_handles();
   std::list<CommHandle*> comm_list; // List of allocated communication handles
 
+  class PersistentCommPlan;
+
   //////////////////////////////////////////////////
   // X communicator
 
@@ -296,12 +311,34 @@ private:
   /// Create the MPI requests to receive data. Non-blocking call.
   void post_receive(CommHandle& ch);
 
+  /// Offsets of each field in a message containing the fields in
+  /// \p var_list over the index range [xge, xlt) x [yge, ylt). Has
+  /// one more element than \p var_list; the last one is the length
+  /// of the whole message
+  std::vector<int> pack_offsets(const std::vector<FieldData*>& var_list, int xge, int xlt,
+                                int yge, int ylt) const;
+
   /// Take data from objects and put into a buffer
+  ///
+  /// Each field's contiguous rows are copied in one go, and the
+  /// copies are shared between OpenMP threads
   int pack_data(const std::vector<FieldData*>& var_list, int xge, int xlt, int yge,
                 int ylt, BoutReal* buffer);
+  /// Take data from objects and put into a buffer, using \p offsets
+  /// previously calculated by pack_offsets
+  int pack_data(const std::vector<FieldData*>& var_list, const std::vector<int>& offsets,
+                int xge, int xlt, int yge, int ylt, BoutReal* buffer);
   /// Copy data from a buffer back into the fields
   int unpack_data(const std::vector<FieldData*>& var_list, int xge, int xlt, int yge,
                   int ylt, BoutReal* buffer);
+  /// Copy data from a buffer back into the fields, using \p offsets
+  /// previously calculated by pack_offsets
+  int unpack_data(const std::vector<FieldData*>& var_list, const std::vector<int>& offsets,
+                  int xge, int xlt, int yge, int ylt, BoutReal* buffer);
+
+  /// Apply the twist-shift condition to the Y guard cells of the
+  /// field-aligned fields in \p g, after they have been received
+  void apply_twist_shift(const FieldGroup& g);
 };
 
 #endif // __BOUTMESH_H__
@@ -439,36 +439,55 @@ public:
       kfilter = ncz / 2;
     const int kmax = ncz / 2 - kfilter; // Up to and including this wavenumber index
 
+    const auto& region2D = theMesh->getRegion2D(region);
+    const int nmodes = ncz / 2 + 1;
+
     BOUT_OMP(parallel) {
-      Array<dcomplex> cv(ncz / 2 + 1);
+      Array<dcomplex> cv;
       const BoutReal kwaveFac = TWOPI / ncz;
 
       // Note we lookup a 2D region here even though we're operating on a Field3D
-      // as we only want to loop over {x, y} and then handle z differently. The
-      // Region<Ind2D> blocks are constructed for elements contiguous assuming nz=1,
-      // as that isn't the case for Field3D (in general) this shouldn't be expected
-      // to vectorise (not that it would anyway) but it should still OpenMP parallelise
-      // ok.
-      // With this in mind we could perhaps avoid the use of the BOUT_FOR_INNER macro
-      // here,
-      // but should be ok for now.
-      BOUT_FOR_INNER(i, theMesh->getRegion2D(region)) {
-        auto i3D = theMesh->ind2Dto3D(i, 0);
-        rfft(&var[i3D], ncz, cv.begin()); // Forward FFT
-
-        for (int jz = 0; jz <= kmax; jz++) {
-          const BoutReal kwave = jz * kwaveFac; // wave number is 1/[rad]
-          cv[jz] *= dcomplex(0, kwave);
+      // as we only want to loop over {x, y} and then handle z differently. Each
+      // block of a Region<Ind2D> is a contiguous set of {x, y} points, and so a
+      // contiguous set of Z-lines of a Field3D, which we can transform with a
+      // single batched FFT
+      BOUT_OMP(for schedule(OPENMP_SCHEDULE) nowait)
+      for (auto block = region2D.getBlocks().cbegin();
+           block < region2D.getBlocks().cend(); ++block) {
+        const int nlines = block->second.ind - block->first.ind;
+        const auto i3D = theMesh->ind2Dto3D(block->first, 0);
+        if (cv.size() != nlines * nmodes) {
+          cv.reallocate(nlines * nmodes);
         }
-        for (int jz = kmax + 1; jz <= ncz / 2; jz++) {
-          cv[jz] = 0.0;
+        bout::fft::rfft_many(&var[i3D], ncz, nlines, cv.begin()); // Forward FFT
+
+        for (int line = 0; line < nlines; ++line) {
+          dcomplex* cvline = &cv[line * nmodes];
+
+          for (int jz = 0; jz <= kmax; jz++) {
+            const BoutReal kwave = jz * kwaveFac; // wave number is 1/[rad]
+            cvline[jz] *= dcomplex(0, kwave);
+          }
+          for (int jz = kmax + 1; jz <= ncz / 2; jz++) {
+            cvline[jz] = 0.0;
+          }
         }
 
-        irfft(cv.begin(), ncz, &result[i3D]); // Reverse FFT
+        bout::fft::irfft_many(cv.begin(), ncz, nlines, &result[i3D]); // Reverse FFT
       }
     }
   }
 
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standardMany(const std::vector<std::reference_wrapper<const T>>& vars,
+                    std::vector<T>& results, const std::string& region) const {
+    AUTO_TRACE();
+    // The transforms are already done a block of Z-lines at a time
+    for (std::size_t k = 0; k < vars.size(); ++k) {
+      standard<direction, stagger, nGuards>(vars[k].get(), results[k], region);
+    }
+  }
+
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
   void upwindOrFlux(const T& UNUSED(vel), const T& UNUSED(var), T& UNUSED(result),
                     const std::string& UNUSED(region)) const {
@@ -499,36 +518,55 @@ public:
     const int ncz = theMesh->getNpoints(direction);
     const int kmax = ncz / 2;
 
+    const auto& region2D = theMesh->getRegion2D(region);
+    const int nmodes = ncz / 2 + 1;
+
     BOUT_OMP(parallel) {
-      Array<dcomplex> cv(ncz / 2 + 1);
+      Array<dcomplex> cv;
       const BoutReal kwaveFac = TWOPI / ncz;
 
       // Note we lookup a 2D region here even though we're operating on a Field3D
-      // as we only want to loop over {x, y} and then handle z differently. The
-      // Region<Ind2D> blocks are constructed for elements contiguous assuming nz=1,
-      // as that isn't the case for Field3D (in general) this shouldn't be expected
-      // to vectorise (not that it would anyway) but it should still OpenMP parallelise
-      // ok.
-      // With this in mind we could perhaps avoid the use of the BOUT_FOR_INNER macro
-      // here,
-      // but should be ok for now.
-      BOUT_FOR_INNER(i, theMesh->getRegion2D(region)) {
-        auto i3D = theMesh->ind2Dto3D(i, 0);
-        rfft(&var[i3D], ncz, cv.begin()); // Forward FFT
-
-        for (int jz = 0; jz <= kmax; jz++) {
-          const BoutReal kwave = jz * kwaveFac; // wave number is 1/[rad]
-          cv[jz] *= -kwave * kwave;
+      // as we only want to loop over {x, y} and then handle z differently. Each
+      // block of a Region<Ind2D> is a contiguous set of {x, y} points, and so a
+      // contiguous set of Z-lines of a Field3D, which we can transform with a
+      // single batched FFT
+      BOUT_OMP(for schedule(OPENMP_SCHEDULE) nowait)
+      for (auto block = region2D.getBlocks().cbegin();
+           block < region2D.getBlocks().cend(); ++block) {
+        const int nlines = block->second.ind - block->first.ind;
+        const auto i3D = theMesh->ind2Dto3D(block->first, 0);
+        if (cv.size() != nlines * nmodes) {
+          cv.reallocate(nlines * nmodes);
         }
-        for (int jz = kmax + 1; jz <= ncz / 2; jz++) {
-          cv[jz] = 0.0;
+        bout::fft::rfft_many(&var[i3D], ncz, nlines, cv.begin()); // Forward FFT
+
+        for (int line = 0; line < nlines; ++line) {
+          dcomplex* cvline = &cv[line * nmodes];
+
+          for (int jz = 0; jz <= kmax; jz++) {
+            const BoutReal kwave = jz * kwaveFac; // wave number is 1/[rad]
+            cvline[jz] *= -kwave * kwave;
+          }
+          for (int jz = kmax + 1; jz <= ncz / 2; jz++) {
+            cvline[jz] = 0.0;
+          }
         }
 
-        irfft(cv.begin(), ncz, &result[i3D]); // Reverse FFT
+        bout::fft::irfft_many(cv.begin(), ncz, nlines, &result[i3D]); // Reverse FFT
       }
     }
   }
 
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standardMany(const std::vector<std::reference_wrapper<const T>>& vars,
+                    std::vector<T>& results, const std::string& region) const {
+    AUTO_TRACE();
+    // The transforms are already done a block of Z-lines at a time
+    for (std::size_t k = 0; k < vars.size(); ++k) {
+      standard<direction, stagger, nGuards>(vars[k].get(), results[k], region);
+    }
+  }
+
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
   void upwindOrFlux(const T& UNUSED(vel), const T& UNUSED(var), T& UNUSED(result),
                     const std::string& UNUSED(region)) const {
@@ -552,6 +590,13 @@ public:
     throw BoutException("The SPLIT method isn't available for standard");
   }
 
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standardMany(const std::vector<std::reference_wrapper<const T>>&, std::vector<T>&,
+                    const std::string&) const {
+    AUTO_TRACE();
+    throw BoutException("The SPLIT method isn't available for standard");
+  }
+
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
   void upwindOrFlux(const T& vel, const T& var, T& result, const std::string region) const {
     AUTO_TRACE();
@@ -261,6 +261,66 @@ void Mesh::communicate(FieldGroup &g) {
   }
 }
 
+namespace {
+/// Communication plan which just uses Mesh::send and Mesh::wait
+class SendWaitPlan : public CommunicationPlan {
+public:
+  SendWaitPlan(Mesh& mesh, FieldGroup g) : CommunicationPlan(std::move(g)), mesh(mesh) {}
+
+  void start() override { handle = mesh.send(group); }
+  void wait() override {
+    mesh.wait(handle);
+    handle = nullptr;
+  }
+
+private:
+  Mesh& mesh;
+  comm_handle handle{nullptr};
+};
+} // namespace
+
+std::unique_ptr<CommunicationPlan> Mesh::createCommunicationPlan(FieldGroup &g) {
+  return bout::utils::make_unique<SendWaitPlan>(*this, g);
+}
+
+void Mesh::communicate(CommunicationPlan &plan) {
+  TRACE("Mesh::communicate(CommunicationPlan&)");
+
+  plan.start();
+  plan.wait();
+
+  // Calculate yup and ydown fields for 3D fields
+  if (calcParallelSlices_on_communicate) {
+    for(const auto& fptr : plan.getFields().field3d()) {
+      fptr->calcParallelSlices();
+    }
+  }
+}
+
+void Mesh::communicateOverlapped(FieldGroup &g,
+                                 const std::function<void(const std::string&)>& compute) {
+  TRACE("Mesh::communicateOverlapped(FieldGroup&)");
+
+  // Start sending data
+  comm_handle h = send(g);
+
+  // Work on the points which don't need the guard cells
+  compute("RGN_INTERIOR");
+
+  // Wait for data from other processors
+  wait(h);
+
+  // Calculate yup and ydown fields for 3D fields
+  if (calcParallelSlices_on_communicate) {
+    for(const auto& fptr : g.field3d()) {
+      fptr->calcParallelSlices();
+    }
+  }
+
+  // Finish the points next to the guard cells
+  compute("RGN_INTERIOR_EDGE");
+}
+
 /// This is a bit of a hack for now to get FieldPerp communications
 /// The FieldData class needs to be changed to accomodate FieldPerp objects
 void Mesh::communicate(FieldPerp &f) {
@@ -437,6 +497,12 @@ void Mesh::addRegionPerp(const std::string &region_name, const Region<IndPerp> &
 }
 
 void Mesh::createDefaultRegions(){
+  // Depth of the guard cells on each side
+  const int xguards_inner = xstart;
+  const int xguards_outer = LocalNx - 1 - xend;
+  const int yguards_inner = ystart;
+  const int yguards_outer = LocalNy - 1 - yend;
+
   //3D regions
   addRegion3D("RGN_ALL", Region<Ind3D>(0, LocalNx - 1, 0, LocalNy - 1, 0, LocalNz - 1,
                                        LocalNy, LocalNz, maxregionblocksize));
@@ -464,6 +530,15 @@ void Mesh::createDefaultRegions(){
   addRegion3D("RGN_NOCORNERS",
       (getRegion3D("RGN_NOBNDRY") + getRegion3D("RGN_XGUARDS") +
         getRegion3D("RGN_YGUARDS") + getRegion3D("RGN_ZGUARDS")).unique());
+  // Points whose stencils don't reach into the guard cells, and the
+  // remaining strip of RGN_NOBNDRY which does. Used to overlap
+  // communications with computation, see communicateOverlapped
+  addRegion3D("RGN_INTERIOR", Region<Ind3D>(xstart + xguards_inner, xend - xguards_outer,
+                                            ystart + yguards_inner, yend - yguards_outer,
+                                            zstart, zend, LocalNy, LocalNz,
+                                            maxregionblocksize));
+  addRegion3D("RGN_INTERIOR_EDGE",
+              mask(getRegion3D("RGN_NOBNDRY"), getRegion3D("RGN_INTERIOR")));
 
   //2D regions
   addRegion2D("RGN_ALL", Region<Ind2D>(0, LocalNx - 1, 0, LocalNy - 1, 0, 0, LocalNy, 1,
@@ -492,6 +567,11 @@ void Mesh::createDefaultRegions(){
   addRegion2D("RGN_NOCORNERS",
       (getRegion2D("RGN_NOBNDRY") + getRegion2D("RGN_XGUARDS") +
         getRegion2D("RGN_YGUARDS") + getRegion2D("RGN_ZGUARDS")).unique());
+  addRegion2D("RGN_INTERIOR", Region<Ind2D>(xstart + xguards_inner, xend - xguards_outer,
+                                            ystart + yguards_inner, yend - yguards_outer,
+                                            0, 0, LocalNy, 1, maxregionblocksize));
+  addRegion2D("RGN_INTERIOR_EDGE",
+              mask(getRegion2D("RGN_NOBNDRY"), getRegion2D("RGN_INTERIOR")));
 
   // Perp regions
   addRegionPerp("RGN_ALL", Region<IndPerp>(0, LocalNx - 1, 0, 0, 0, LocalNz - 1, 1,
@@ -521,6 +601,11 @@ void Mesh::createDefaultRegions(){
   addRegionPerp("RGN_NOCORNERS",
       (getRegionPerp("RGN_NOBNDRY") + getRegionPerp("RGN_XGUARDS") +
         getRegionPerp("RGN_YGUARDS") + getRegionPerp("RGN_ZGUARDS")).unique());
+  addRegionPerp("RGN_INTERIOR", Region<IndPerp>(xstart + xguards_inner,
+                                                xend - xguards_outer, 0, 0, zstart, zend,
+                                                1, LocalNz, maxregionblocksize));
+  addRegionPerp("RGN_INTERIOR_EDGE",
+                mask(getRegionPerp("RGN_NOBNDRY"), getRegionPerp("RGN_INTERIOR")));
 
   // Construct index lookup for 3D-->2D
   indexLookup3Dto2D = Array<int>(LocalNx*LocalNy*LocalNz);
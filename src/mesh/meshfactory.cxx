@@ -7,6 +7,8 @@
 #include <dataformat.hxx>
 #include <boutexception.hxx>
 
+#include <utility>
+
 #include "impls/bout/boutmesh.hxx"
 
 MeshFactory *MeshFactory::instance = nullptr;
@@ -22,6 +24,26 @@ MeshFactory* MeshFactory::getInstance() {
   return instance;
 }
 
+namespace {
+/// Create a grid file, using specified format if given. If
+/// shared_read is set in \p options, only one processor in each
+/// group opens the file
+GridFile* createGridFile(const std::string& grid_name, const std::string& grid_ext,
+                         Options* options) {
+  auto format = data_format((grid_ext.empty()) ? grid_name.c_str() : grid_ext.c_str());
+
+  bool shared_read;
+  options->get("shared_read", shared_read, false);
+  if (shared_read) {
+    int shared_read_size;
+    options->get("shared_read_size", shared_read_size, 0);
+    format = shared_read_format(std::move(format), shared_read_size);
+  }
+
+  return new GridFile(std::move(format), grid_name);
+}
+} // namespace
+
 Mesh* MeshFactory::createMesh(GridDataSource *source, Options *options) {
   if (options == nullptr)
     options = Options::getRoot()->getSection("mesh");
@@ -38,9 +60,7 @@ Mesh* MeshFactory::createMesh(GridDataSource *source, Options *options) {
       options->get("format", grid_ext, "");
       
       /// Create a grid file
-      source = static_cast<GridDataSource *>(new GridFile(
-          data_format((grid_ext.empty()) ? grid_name.c_str() : grid_ext.c_str()),
-          grid_name.c_str()));
+      source = static_cast<GridDataSource *>(createGridFile(grid_name, grid_ext, options));
     }else if(Options::getRoot()->isSet("grid")){
       // Get the global option
       Options::getRoot()->get("grid", grid_name, "");
@@ -48,9 +68,7 @@ Mesh* MeshFactory::createMesh(GridDataSource *source, Options *options) {
       std::string grid_ext;
       Options::getRoot()->get("format", grid_ext, "");
 
-      source = static_cast<GridDataSource *>(new GridFile(
-          data_format((grid_ext.empty()) ? grid_name.c_str() : grid_ext.c_str()),
-          grid_name.c_str()));
+      source = static_cast<GridDataSource *>(createGridFile(grid_name, grid_ext, options));
     }else {
       output << "\nGetting grid data from options\n";
       source = static_cast<GridDataSource *>(new GridFromOptions(options));
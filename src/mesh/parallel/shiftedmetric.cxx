@@ -11,6 +11,7 @@
 #include "bout/paralleltransform.hxx"
 #include <fft.hxx>
 
+#include <algorithm>
 #include <cmath>
 
 #include <output.hxx>
@@ -133,6 +134,12 @@ const FieldPerp ShiftedMetric::toFieldAligned(const FieldPerp& f,
   return shiftZ(f, toAlignedPhs, YDirectionType::Aligned, region);
 }
 
+void ShiftedMetric::calcFieldAligned(const Field3D& f, BoutReal* out,
+                                     const std::string& region) {
+  ASSERT2(f.getDirectionY() == YDirectionType::Standard);
+  shiftZ(f, toAlignedPhs, out, region);
+}
+
 /*!
  * Shift back, so that X-Z is orthogonal,
  * but Y is not field aligned.
@@ -163,12 +170,32 @@ const Field3D ShiftedMetric::shiftZ(const Field3D& f, const Tensor<dcomplex>& ph
   }
 
   Field3D result{emptyFrom(f).setDirectionY(y_direction_out)};
+  shiftZ(f, phs, &result(0, 0, 0), region);
 
-  BOUT_FOR(i, mesh.getRegion2D(toString(region))) {
-    shiftZ(&f(i, 0), &phs(i.x(), i.y(), 0), &result(i, 0));
+  return result;
+}
+
+void ShiftedMetric::shiftZ(const Field3D& f, const Tensor<dcomplex>& phs, BoutReal* out,
+                           const std::string& region) const {
+  ASSERT1(f.getMesh() == &mesh);
+  ASSERT1(f.getLocation() == location);
+
+  const int nz = mesh.LocalNz;
+  if (nz == 1) {
+    // Shifting does not change the array values
+    BOUT_FOR(i, f.getRegion(region)) { out[i.ind] = f[i]; }
+    return;
   }
 
-  return result;
+  // Each block of a Region<Ind2D> is a contiguous set of Z-lines, so
+  // can be shifted with a single batched FFT
+  const auto& region2D = mesh.getRegion2D(toString(region));
+  BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+  for (auto block = region2D.getBlocks().cbegin(); block < region2D.getBlocks().cend();
+       ++block) {
+    const auto& i = block->first;
+    shiftZ(&f(i, 0), &phs(i.x(), i.y(), 0), block->second.ind - i.ind, out + i.ind * nz);
+  }
 }
 
 const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const Tensor<dcomplex>& phs,
@@ -186,30 +213,39 @@ const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const Tensor<dcomplex>
   FieldPerp result{emptyFrom(f).setDirectionY(y_direction_out)};
 
   int y = f.getIndex();
-  // Note that this loop is essentially hardcoded to be RGN_NOX
-  for (int i=mesh.xstart; i<=mesh.xend; ++i) {
-    shiftZ(&f(i, 0), &phs(i, y, 0), &result(i, 0));
+  // Note that this is essentially hardcoded to be RGN_NOX. The X-lines
+  // of a FieldPerp are contiguous, but the phases for consecutive x
+  // are not, so gather them first
+  const int nlines = mesh.xend - mesh.xstart + 1;
+  Array<dcomplex> phs_perp(nlines * nmodes);
+  for (int i = 0; i < nlines; ++i) {
+    std::copy(&phs(mesh.xstart + i, y, 0), &phs(mesh.xstart + i, y, 0) + nmodes,
+              &phs_perp[i * nmodes]);
   }
+  shiftZ(&f(mesh.xstart, 0), phs_perp.begin(), nlines, &result(mesh.xstart, 0));
 
   return result;
 }
 
 void ShiftedMetric::shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const {
-  Array<dcomplex> cmplx(nmodes);
+  shiftZ(in, phs, 1, out);
+}
 
-  // Take forward FFT
-  rfft(in, mesh.LocalNz, &cmplx[0]);
+void ShiftedMetric::shiftZ(const BoutReal* in, const dcomplex* phs, int nlines,
+                           BoutReal* out) const {
+  Array<dcomplex> cmplx(nlines * nmodes);
 
-  // Following is an algorithm approach to write a = a*b where a and b are
-  // vectors of dcomplex.
-  //  std::transform(cmplxOneOff.begin(),cmplxOneOff.end(), ptr.begin(),
-  //		 cmplxOneOff.begin(), std::multiplies<dcomplex>());
+  // Take forward FFT of all the lines at once
+  bout::fft::rfft_many(in, mesh.LocalNz, nlines, cmplx.begin());
 
-  for (int jz = 1; jz < nmodes; jz++) {
-    cmplx[jz] *= phs[jz];
+  for (int line = 0; line < nlines; ++line) {
+    const int offset = line * nmodes;
+    for (int jz = 1; jz < nmodes; jz++) {
+      cmplx[offset + jz] *= phs[offset + jz];
+    }
   }
 
-  irfft(&cmplx[0], mesh.LocalNz, out); // Reverse FFT
+  bout::fft::irfft_many(cmplx.begin(), mesh.LocalNz, nlines, out); // Reverse FFT
 }
 
 void ShiftedMetric::calcParallelSlices(Field3D& f) {
@@ -224,12 +260,17 @@ void ShiftedMetric::calcParallelSlices(Field3D& f) {
   for (const auto& phase : parallel_slice_phases) {
     auto& f_slice = f.ynext(phase.y_offset);
     f_slice.allocate();
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      const int ix = i.x();
-      const int iy = i.y();
+    // Blocks of RGN_NOY are contiguous in y at fixed x, so the offset
+    // lines are contiguous as well
+    const auto& region2D = mesh.getRegion2D("RGN_NOY");
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (auto block = region2D.getBlocks().cbegin();
+         block < region2D.getBlocks().cend(); ++block) {
+      const int ix = block->first.x();
+      const int iy = block->first.y();
       const int iy_offset = iy + phase.y_offset;
       shiftZ(&(f(ix, iy_offset, 0)), &(phase.phase_shift(ix, iy, 0)),
-             &(f_slice(ix, iy_offset, 0)));
+             block->second.ind - block->first.ind, &(f_slice(ix, iy_offset, 0)));
     }
   }
 }
@@ -243,16 +284,10 @@ ShiftedMetric::shiftZ(const Field3D& f,
 
   const int nmodes = mesh.LocalNz / 2 + 1;
 
-  // FFT in Z of input field at each (x, y) point
-  Matrix<Array<dcomplex>> f_fft(mesh.LocalNx, mesh.LocalNy);
-  f_fft = Array<dcomplex>(nmodes);
-
-  BOUT_FOR(i, mesh.getRegion2D("RGN_ALL")) {
-    int ix = i.x();
-    int iy = i.y();
-    f_fft(ix, iy).ensureUnique();
-    rfft(&f(i, 0), mesh.LocalNz, f_fft(ix, iy).begin());
-  }
+  // FFT in Z of input field at each (x, y) point, all in one batch
+  Tensor<dcomplex> f_fft(mesh.LocalNx, mesh.LocalNy, nmodes);
+  bout::fft::rfft_many(&f(0, 0, 0), mesh.LocalNz, mesh.LocalNx * mesh.LocalNy,
+                       &f_fft(0, 0, 0));
 
   std::vector<Field3D> results{};
 
@@ -264,19 +299,31 @@ ShiftedMetric::shiftZ(const Field3D& f,
     current_result.allocate();
     current_result.setLocation(f.getLocation());
 
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      // Deep copy the FFT'd field
-      int ix = i.x();
-      int iy = i.y();
-
-      Array<dcomplex> shifted_temp(f_fft(ix, iy + phase.y_offset));
-      shifted_temp.ensureUnique();
-
-      for (int jz = 1; jz < nmodes; ++jz) {
-        shifted_temp[jz] *= phase.phase_shift(ix, iy, jz);
+    // Blocks of RGN_NOY are contiguous in y at fixed x, so the offset
+    // lines are contiguous as well
+    const auto& region2D = mesh.getRegion2D("RGN_NOY");
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (auto block = region2D.getBlocks().cbegin();
+         block < region2D.getBlocks().cend(); ++block) {
+      const int ix = block->first.x();
+      const int iy = block->first.y();
+      const int nlines = block->second.ind - block->first.ind;
+
+      // Copy the FFT'd field
+      const dcomplex* f_fft_start = &f_fft(ix, iy + phase.y_offset, 0);
+      Array<dcomplex> shifted_temp(nlines * nmodes);
+      std::copy(f_fft_start, f_fft_start + nlines * nmodes, shifted_temp.begin());
+
+      const dcomplex* phs = &phase.phase_shift(ix, iy, 0);
+      for (int line = 0; line < nlines; ++line) {
+        const int offset = line * nmodes;
+        for (int jz = 1; jz < nmodes; ++jz) {
+          shifted_temp[offset + jz] *= phs[offset + jz];
+        }
       }
 
-      irfft(shifted_temp.begin(), mesh.LocalNz, &current_result(i.yp(phase.y_offset), 0));
+      bout::fft::irfft_many(shifted_temp.begin(), mesh.LocalNz, nlines,
+                            &current_result(ix, iy + phase.y_offset, 0));
     }
   }
 
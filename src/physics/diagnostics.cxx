@@ -0,0 +1,163 @@
+#include "bout/diagnostics.hxx"
+
+#include "bout/mesh.hxx"
+#include "bout/openmpwrap.hxx"
+#include "boutexception.hxx"
+#include "datafile.hxx"
+#include "dcomplex.hxx"
+#include "fft.hxx"
+#include "field3d.hxx"
+#include "globals.hxx"
+#include "options.hxx"
+#include "smoothing.hxx"
+#include "utils.hxx"
+
+#include <algorithm>
+
+namespace {
+/// Split a comma-separated list of names
+std::vector<std::string> readNames(Options& options, const std::string& name,
+                                   const std::string& doc) {
+  const std::string list = options[name].doc(doc).withDefault(std::string{});
+  std::vector<std::string> names;
+  for (const auto& item : strsplit(list, ',')) {
+    const auto trimmed = trim(item);
+    if (not trimmed.empty()) {
+      names.push_back(trimmed);
+    }
+  }
+  return names;
+}
+
+bool contains(const std::vector<std::string>& names, const std::string& name) {
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+} // namespace
+
+namespace bout {
+
+Diagnostics::Diagnostics(Options& options, Datafile& file, Mesh* mesh)
+    : file(file), mesh(mesh == nullptr ? bout::globals::mesh : mesh),
+      dc(readNames(options, "dc", "Fields to write the Z average of")),
+      average_x(readNames(options, "average_x", "Fields to write the X-Z average of")),
+      average_y(readNames(options, "average_y", "Fields to write the Y-Z average of")),
+      slice(readNames(options, "slice", "Fields to write an X-Z slice of")),
+      modes(readNames(options, "modes", "Fields to write Z Fourier mode amplitudes of")),
+      slice_y(options["slice_y"]
+                  .doc("Global Y index of slices, not including boundary cells")
+                  .withDefault(0)),
+      nmodes(options["nmodes"].doc("Number of Z Fourier modes to write").withDefault(4)) {
+
+  for (const auto* names : {&dc, &average_x, &average_y, &slice, &modes}) {
+    wanted.insert(names->begin(), names->end());
+  }
+
+  if (not modes.empty() and (nmodes < 1 or nmodes > this->mesh->LocalNz / 2)) {
+    throw BoutException("Diagnostics: nmodes must be between 1 and nz / 2 = %d, not %d",
+                        this->mesh->LocalNz / 2, nmodes);
+  }
+}
+
+Field2D& Diagnostics::addResult2D(const std::string& name) {
+  results2d.emplace_back(mesh);
+  results2d.back() = 0.0;
+  file.addRepeat(results2d.back(), name);
+  return results2d.back();
+}
+
+void Diagnostics::add(const Field3D& f, const std::string& name) {
+  if (added.count(name) != 0) {
+    throw BoutException("Diagnostics: a field called '%s' has already been added",
+                        name.c_str());
+  }
+  added.insert(name);
+
+  if (contains(dc, name)) {
+    auto& result = addResult2D(name + "_dc");
+    calculations.emplace_back([&f, &result]() { result = DC(f); });
+  }
+
+  if (contains(average_x, name)) {
+    auto& result = addResult2D(name + "_avg_x");
+    calculations.emplace_back([&f, &result]() { result = averageX(DC(f)); });
+  }
+
+  if (contains(average_y, name)) {
+    auto& result = addResult2D(name + "_avg_y");
+    calculations.emplace_back([&f, &result]() { result = averageY(DC(f)); });
+  }
+
+  if (contains(slice, name)) {
+    results_perp.emplace_back(mesh);
+    auto& result = results_perp.back();
+
+    // Only the processor containing the slice writes it
+    const int y = mesh->YLOCAL(slice_y);
+    const bool here = (y >= mesh->ystart) and (y <= mesh->yend);
+    result.setIndex(here ? y : -1);
+    result = 0.0;
+    file.addRepeat(result, name + "_slice");
+
+    if (here) {
+      calculations.emplace_back([&f, &result, y]() { result = sliceXZ(f, y); });
+    }
+  }
+
+  if (contains(modes, name)) {
+    std::vector<Field2D*> results;
+    for (int k = 1; k <= nmodes; ++k) {
+      results.push_back(&addResult2D(name + "_mode" + toString(k)));
+    }
+
+    Mesh* localmesh = mesh;
+    calculations.emplace_back([&f, results, localmesh]() {
+      const int nz = localmesh->LocalNz;
+      const int nk = nz / 2 + 1;
+
+      std::vector<BoutReal*> out;
+      for (auto* result : results) {
+        result->allocate();
+        out.push_back(&(*result)(0, 0));
+      }
+
+      // Each block of a Region<Ind2D> is a contiguous set of Z-lines,
+      // so can be transformed with a single batched FFT
+      const auto& region2D = localmesh->getRegion2D("RGN_ALL");
+      BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+      for (auto block = region2D.getBlocks().cbegin();
+           block < region2D.getBlocks().cend(); ++block) {
+        const auto& i = block->first;
+        const int nlines = block->second.ind - i.ind;
+
+        Array<dcomplex> spectrum(nlines * nk);
+        bout::fft::rfft_many(&f(i, 0), nz, nlines, spectrum.begin());
+
+        for (int line = 0; line < nlines; ++line) {
+          for (std::size_t k = 1; k <= out.size(); ++k) {
+            // The transform is normalised, so a cosine of amplitude A
+            // has coefficients A/2 at k and -k, except at Nyquist
+            const BoutReal factor = (2 * k == static_cast<std::size_t>(nz)) ? 1.0 : 2.0;
+            out[k - 1][i.ind + line] = factor * std::abs(spectrum[line * nk + k]);
+          }
+        }
+      }
+    });
+  }
+}
+
+void Diagnostics::calculate() {
+  TRACE("Diagnostics::calculate");
+
+  for (const auto& name : wanted) {
+    if (added.count(name) == 0) {
+      throw BoutException("Diagnostics: no field called '%s' has been added",
+                          name.c_str());
+    }
+  }
+
+  for (const auto& calculation : calculations) {
+    calculation();
+  }
+}
+
+} // namespace bout
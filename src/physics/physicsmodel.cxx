@@ -33,8 +33,12 @@
 #undef BOUT_NO_USING_NAMESPACE_BOUTGLOBALS
 
 #include <bout/mesh.hxx>
+#include <boutcomm.hxx>
+#include <output.hxx>
 
-PhysicsModel::PhysicsModel() : modelMonitor(this) {
+PhysicsModel::PhysicsModel()
+    : modelMonitor(this),
+      diagnostics(Options::root()["diagnostics"], bout::globals::dump) {
 
   // Set up restart file
   restart = Datafile(Options::getRoot()->getSection("restart"));
@@ -72,6 +76,29 @@ int PhysicsModel::runJacobian(BoutReal t) {
   return (*this.*userjacobian)(t);
 }
 
+void PhysicsModel::writeCheckpoint(int iter, int nout) {
+  // Every checkpoint_period outputs, and always after the last
+  if ((iter + 1) % checkpoint_period != 0 and iter != nout - 1) {
+    return;
+  }
+
+  if (checkpoint_count++ % full_checkpoint_period == 0) {
+    restart.write();
+    if (full_checkpoint_period > 1) {
+      solver->setDeltaBase();
+    }
+    return;
+  }
+
+  solver->calculateDeltas();
+  restart_deltas.write();
+
+  // Only mark the deltas complete once they have all been written, so
+  // that a partly written file is ignored when restarting
+  solver->markDeltasComplete();
+  restart_deltas.writeVar("complete_hist_hi");
+}
+
 void PhysicsModel::bout_solve(Field2D &var, const char *name) {
   // Add to solver
   solver->add(var, name);
@@ -79,6 +106,7 @@ void PhysicsModel::bout_solve(Field2D &var, const char *name) {
 
 void PhysicsModel::bout_solve(Field3D &var, const char *name) {
   solver->add(var, name);
+  diagnostics.add(var, name);
 }
 
 void PhysicsModel::bout_solve(Vector2D &var, const char *name) {
@@ -111,7 +139,40 @@ int PhysicsModel::postInit(bool restarting) {
   options->get("dump_format", dump_ext, "nc");
   options->get("restart_format", restart_ext, dump_ext);
 
+  auto& restart_options = Options::root()["restart"];
+  checkpoint_period = restart_options["checkpoint_period"]
+                          .doc("Number of outputs between writing restart files")
+                          .withDefault(1);
+  full_checkpoint_period =
+      restart_options["full_period"]
+          .doc("Number of restart checkpoints between writing the full state. In "
+               "between, only the changes to the state are written")
+          .withDefault(1);
+  if (checkpoint_period < 1 or full_checkpoint_period < 1) {
+    throw BoutException("restart:checkpoint_period and restart:full_period must be at "
+                        "least 1");
+  }
+
+  // Each processor reads the parts of the old restart files it needs
+  const bool repartition =
+      restart_options["repartition"]
+          .doc("Allow restarting on a different number of processors than the "
+               "restart files were written with")
+          .withDefault(true);
+  restart.setRepartition(repartition);
+
+  const bool use_deltas = full_checkpoint_period > 1;
+  if (use_deltas) {
+    if (restart_options["floats"].withDefault(false)) {
+      throw BoutException("Restart deltas can't be written as floats");
+    }
+    restart_deltas = Datafile(&restart_options);
+    restart_deltas.setRepartition(repartition);
+    solver->outputDeltas(restart_deltas);
+  }
+
   std::string filename = restart_dir + "/BOUT.restart."+restart_ext;
+  std::string delta_filename = restart_dir + "/BOUT.restart_delta." + restart_ext;
   if (restarting) {
     output.write("Loading restart file: %s\n", filename.c_str());
 
@@ -121,6 +182,34 @@ int PhysicsModel::postInit(bool restarting) {
     if (!restart.read())
       throw BoutException("Error: Could not read restart file %s\n", filename.c_str());
     restart.close();
+
+    if (use_deltas) {
+      // Any changes written since the restart file. These are missing
+      // or incomplete if the run stopped before they were written,
+      // and don't match if the restart file was written after them
+      bool have_deltas = false;
+      try {
+        restart_deltas.openr("%s", delta_filename.c_str());
+        have_deltas = restart_deltas.read() and solver->deltasMatchState();
+        restart_deltas.close();
+      } catch (const BoutException&) {
+        have_deltas = false;
+      }
+
+      // Either all processors use the deltas, or none
+      int local_deltas = have_deltas ? 1 : 0;
+      int all_deltas = 0;
+      MPI_Allreduce(&local_deltas, &all_deltas, 1, MPI_INT, MPI_MIN, BoutComm::get());
+
+      if (all_deltas == 1) {
+        output.write("Loaded restart deltas: %s\n", delta_filename.c_str());
+        solver->applyDeltas();
+      } else {
+        output_warn.write("No restart deltas matching %s, starting from the last full "
+                          "restart file\n",
+                          filename.c_str());
+      }
+    }
   }
 
   // Add mesh information to restart file
@@ -142,9 +231,25 @@ int PhysicsModel::postInit(bool restarting) {
     }
   }
 
-  // Add monitor to the solver which calls restart.write() and
-  // PhysicsModel::outputMonitor()
+  if (use_deltas) {
+    if (restarting) {
+      // The restart file just written is the base for the deltas
+      solver->setDeltaBase();
+      ++checkpoint_count;
+    }
+    if (!restart_deltas.openw("%s", delta_filename.c_str())) {
+      throw BoutException("Error: Could not open restart deltas for writing\n");
+    }
+  }
+
+  // Add monitor to the solver which writes the restart files and
+  // calls PhysicsModel::outputMonitor()
   solver->addMonitor(&modelMonitor);
 
+  if (diagnostics.enabled()) {
+    // Calculate the diagnostics before the output is written
+    solver->addMonitor(&diagnostics, Solver::FRONT);
+  }
+
   return 0;
 }
@@ -6,6 +6,7 @@
 #include <boutexception.hxx>
 #include <msg_stack.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/solver_kernels.hxx>
 
 #include <cmath>
 
@@ -138,7 +139,6 @@ void EulerSolver::take_step(BoutReal curtime, BoutReal dt, Array<BoutReal> &star
   run_rhs(curtime);
   save_derivs(std::begin(result));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    result[i] = start[i] + dt*result[i];
+  bout::solver::multiAxpy(nlocal, std::begin(start), {dt}, {std::begin(result)},
+                          std::begin(result));
 }
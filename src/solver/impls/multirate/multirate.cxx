@@ -0,0 +1,189 @@
+#include "multirate.hxx"
+
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <msg_stack.hxx>
+#include <output.hxx>
+#include <bout/openmpwrap.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Sets a flag to true when destroyed, including when an exception
+/// is thrown
+struct SlowDerivsNeeded {
+  bool& needed;
+  ~SlowDerivsNeeded() { needed = true; }
+};
+} // namespace
+
+int MultirateSolver::init(int nout, BoutReal tstep) {
+  AUTO_TRACE();
+
+  /// Call the generic initialisation first
+  if (Solver::init(nout, tstep))
+    return 1;
+
+  output.write(_("\n\tMultirate Runge-Kutta solver\n"));
+
+  nsteps = nout; // Save number of output steps
+  out_timestep = tstep;
+  max_dt = tstep;
+
+  // Calculate number of variables
+  nlocal = getLocalN();
+
+  // Get total problem size
+  if (MPI_Allreduce(&nlocal, &neq, 1, MPI_INT, MPI_SUM, BoutComm::get())) {
+    throw BoutException("MPI_Allreduce failed!");
+  }
+
+  // Allocate memory
+  state.reallocate(nlocal);
+  slow.reallocate(nlocal);
+  dydt0.reallocate(nlocal);
+  dydt1.reallocate(nlocal);
+  dydt2.reallocate(nlocal);
+  current.reallocate(nlocal);
+  predicted.reallocate(nlocal);
+
+  // Put starting values into state
+  save_vars(std::begin(state));
+  set_slow(std::begin(slow));
+
+  // Count the slow variables on all processors
+  int local_nslow = std::count(std::begin(slow), std::end(slow), 1.0);
+  int nslow;
+  if (MPI_Allreduce(&local_nslow, &nslow, 1, MPI_INT, MPI_SUM, BoutComm::get())) {
+    throw BoutException("MPI_Allreduce failed!");
+  }
+  have_slow = nslow > 0;
+
+  output.write(_("\t3d fields = %d, 2d fields = %d neq=%d, local_N=%d, slow=%d\n"),
+               n3Dvars(), n2Dvars(), neq, nlocal, nslow);
+
+  auto& opt = *options;
+  timestep = opt["timestep"]
+                 .doc("Slow timestep. This may be rounded down.")
+                 .withDefault(out_timestep);
+  substeps = opt["substeps"]
+                 .doc("Number of fast timesteps in each slow timestep")
+                 .withDefault(substeps);
+  if (substeps < 1) {
+    throw BoutException(_("multirate:substeps must be at least 1, but is %d"), substeps);
+  }
+
+  const int ninternal_steps = static_cast<int>(std::ceil(out_timestep / timestep));
+  ASSERT0(ninternal_steps > 0);
+
+  timestep = out_timestep / ninternal_steps;
+  output.write(_("\tUsing a slow timestep %e, and fast timestep %e\n"), timestep,
+               timestep / substeps);
+
+  return 0;
+}
+
+int MultirateSolver::run() {
+  AUTO_TRACE();
+
+  for (int step = 0; step < nsteps; step++) {
+    // Take an output step
+
+    const BoutReal target = simtime + out_timestep;
+
+    bool running = true; // Changed to false to break out of inner loop
+    do {
+      // Take a single slow time step
+      BoutReal dt = timestep;
+      if ((simtime + dt) >= target) {
+        dt = target - simtime; // Make sure the last timestep is on the output
+        running = false;
+      }
+
+      take_step(simtime, dt);
+
+      simtime += dt;
+
+      call_timestep_monitors(simtime, dt);
+    } while (running);
+
+    load_vars(std::begin(state)); // Put result into variables
+    // Call rhs function to get extra variables at this time
+    run_rhs(simtime);
+
+    iteration++; // Advance iteration number
+
+    /// Call the monitor function
+    if (call_monitors(simtime, step, nsteps)) {
+      // User signalled to quit
+      break;
+    }
+  }
+
+  return 0;
+}
+
+void MultirateSolver::take_step(BoutReal curtime, BoutReal dt) {
+  const BoutReal h = dt / substeps; // Fast timestep
+
+  // Derivatives of all variables at the start
+  load_vars(std::begin(state));
+  run_rhs(curtime);
+  save_derivs(std::begin(dydt0));
+
+  std::copy(std::begin(state), std::end(state), std::begin(current));
+
+  // Fast steps. Only the fast variables' derivatives are needed. The
+  // flag is set back to true afterwards, or by restore if the RHS throws
+  slow_derivs_needed = false;
+  const SlowDerivsNeeded restore{slow_derivs_needed};
+  for (int i = 0; i < substeps; i++) {
+    const BoutReal t = curtime + i * h;
+
+    if (i > 0) {
+      load_vars(std::begin(current));
+      run_rhs(t);
+      save_derivs(std::begin(dydt1));
+    }
+    // The derivatives at the start of this fast step
+    const auto& start = (i == 0) ? dydt0 : dydt1;
+
+    // Slow variables interpolated to the end of the fast step
+    const BoutReal slow_dt = t + h - curtime;
+
+    BOUT_OMP(parallel for)
+    for (int j = 0; j < nlocal; j++) {
+      predicted[j] = (slow[j] != 0.0) ? state[j] + slow_dt * dydt0[j]
+                                      : current[j] + h * start[j];
+    }
+
+    load_vars(std::begin(predicted));
+    run_rhs(t + h);
+    save_derivs(std::begin(dydt2));
+
+    BOUT_OMP(parallel for)
+    for (int j = 0; j < nlocal; j++) {
+      current[j] = (slow[j] != 0.0) ? predicted[j]
+                                    : current[j] + 0.5 * h * (start[j] + dydt2[j]);
+    }
+  }
+  slow_derivs_needed = true;
+
+  if (!have_slow) {
+    swap(state, current);
+    return;
+  }
+
+  // Derivatives of the slow variables at the end of the step, with
+  // their predicted values
+  load_vars(std::begin(current));
+  run_rhs(curtime + dt);
+  save_derivs(std::begin(dydt1));
+
+  BOUT_OMP(parallel for)
+  for (int j = 0; j < nlocal; j++) {
+    state[j] = (slow[j] != 0.0) ? state[j] + 0.5 * dt * (dydt0[j] + dydt1[j])
+                                : current[j];
+  }
+}
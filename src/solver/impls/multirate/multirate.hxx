@@ -0,0 +1,95 @@
+/**************************************************************************
+ * Multirate explicit solver
+ *
+ * Variables are either fast or slow: a variable is slow if the
+ * "slow" option in its section is true. Each slow timestep is split
+ * into a number of fast timesteps:
+ *
+ * - The derivatives of all variables are calculated at the start of
+ *   the slow step
+ * - The fast variables are advanced with the fast timestep, using
+ *   Heun's method (2nd-order Runge-Kutta). In the meantime, the slow
+ *   variables are interpolated linearly in time, using their
+ *   derivatives at the start of the step
+ * - The slow variables are then advanced over the slow step with
+ *   Heun's method, using their derivatives at the start and at the
+ *   end of the step
+ *
+ * The derivatives of the slow variables are therefore only needed
+ * twice in each slow step. During the fast steps,
+ * Solver::slowDerivsNeeded() is false, so the RHS function can skip
+ * calculating them.
+ *
+ * Always available, since doesn't depend on external library
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+class MultirateSolver;
+
+#pragma once
+
+#ifndef MULTIRATE_HXX
+#define MULTIRATE_HXX
+
+#include <bout_types.hxx>
+#include <bout/solver.hxx>
+
+#include <bout/solverfactory.hxx>
+namespace {
+RegisterSolver<MultirateSolver> registersolvermultirate("multirate");
+}
+
+class MultirateSolver : public Solver {
+public:
+  explicit MultirateSolver(Options* opt = nullptr) : Solver(opt) {}
+  ~MultirateSolver() = default;
+
+  BoutReal getCurrentTimestep() override { return timestep; }
+
+  int init(int nout, BoutReal tstep) override;
+
+  int run() override;
+
+private:
+  BoutReal out_timestep{0.0}; ///< The output timestep
+  int nsteps{0};              ///< Number of output steps
+
+  BoutReal timestep{0.0}; ///< The slow timestep
+  int substeps{4};        ///< Number of fast timesteps in each slow timestep
+
+  int nlocal{0}, neq{0}; ///< Number of variables on local processor and in total
+  bool have_slow{false}; ///< Are any variables slow, on any processor?
+
+  /// System state
+  Array<BoutReal> state;
+  /// 1 for the slow variables, 0 for the fast
+  Array<BoutReal> slow;
+
+  /// Derivatives at the start of the slow step, and at the start and
+  /// end of a fast step
+  Array<BoutReal> dydt0, dydt1, dydt2;
+  /// State during the fast steps, and the predicted state at the end
+  /// of a fast step
+  Array<BoutReal> current, predicted;
+
+  /// Take a slow step of size \p dt, updating state
+  void take_step(BoutReal curtime, BoutReal dt);
+};
+
+#endif // MULTIRATE_HXX
@@ -0,0 +1,232 @@
+#include "parareal.hxx"
+
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <msg_stack.hxx>
+#include <output.hxx>
+#include <bout/solver_kernels.hxx>
+
+#include <algorithm>
+
+int PararealSolver::init(int nout, BoutReal tstep) {
+  AUTO_TRACE();
+
+  /// Call the generic initialisation first
+  if (Solver::init(nout, tstep))
+    return 1;
+
+  output.write(_("\n\tParareal solver\n"));
+
+  nsteps = nout; // Save number of output steps
+  out_timestep = tstep;
+  max_dt = tstep;
+
+  // Calculate number of variables
+  nlocal = getLocalN();
+
+  // Get total problem size
+  if (MPI_Allreduce(&nlocal, &neq, 1, MPI_INT, MPI_SUM, BoutComm::get())) {
+    throw BoutException("MPI_Allreduce failed!");
+  }
+
+  output.write(_("\t3d fields = %d, 2d fields = %d neq=%d, local_N=%d\n"), n3Dvars(),
+               n2Dvars(), neq, nlocal);
+
+  // Each group of processors solves one time slice
+  time_comm = BoutComm::getTime();
+  slice = BoutComm::timeRank();
+  nslices = BoutComm::timeSize();
+
+  output.write(_("\tSolving time slice %d of %d\n"), slice + 1, nslices);
+
+  // Allocate memory
+  state.reallocate(nlocal);
+  start.reallocate(nlocal);
+  coarse.reallocate(nlocal);
+  fine.reallocate(nlocal);
+  coarse_new.reallocate(nlocal);
+  next.reallocate(nlocal);
+  u1.reallocate(nlocal);
+  u2.reallocate(nlocal);
+  k1.reallocate(nlocal);
+  k2.reallocate(nlocal);
+  k3.reallocate(nlocal);
+  k4.reallocate(nlocal);
+
+  // Put starting values into state
+  save_vars(std::begin(state));
+
+  auto& opt = *options;
+  coarse_steps = opt["coarse_steps"]
+                     .doc("Number of coarse timesteps in each time slice")
+                     .withDefault(coarse_steps);
+  fine_steps = opt["fine_steps"]
+                   .doc("Number of fine timesteps in each time slice")
+                   .withDefault(fine_steps);
+  max_iterations = opt["max_iterations"]
+                       .doc("Maximum number of parareal iterations. After time_slices "
+                            "iterations the solution is the fine solution")
+                       .withDefault(nslices);
+  atol = opt["atol"].doc("Absolute tolerance").withDefault(atol);
+  rtol = opt["rtol"]
+             .doc("Relative tolerance for the change between iterations")
+             .withDefault(rtol);
+  diagnose = opt["diagnose"]
+                 .doc("Print the number of iterations for each output")
+                 .withDefault(diagnose);
+
+  if ((coarse_steps < 1) or (fine_steps < 1) or (max_iterations < 1)) {
+    throw BoutException(_("parareal: coarse_steps, fine_steps and max_iterations must "
+                          "be at least 1"));
+  }
+
+  return 0;
+}
+
+int PararealSolver::run() {
+  AUTO_TRACE();
+
+  const BoutReal slice_dt = out_timestep / nslices;
+
+  for (int step = 0; step < nsteps; step++) {
+    // Take an output step
+
+    const BoutReal start_time = simtime;
+    const BoutReal slice_time = start_time + slice * slice_dt;
+
+    // First guess from the coarse solution. Each group repeats the
+    // slices before its own, rather than waiting for the others
+    std::copy(std::begin(state), std::end(state), std::begin(start));
+    for (int i = 0; i < slice; i++) {
+      coarse_solve(start_time + i * slice_dt, slice_dt, start);
+    }
+    std::copy(std::begin(start), std::end(start), std::begin(coarse));
+    coarse_solve(slice_time, slice_dt, coarse);
+    std::copy(std::begin(coarse), std::end(coarse), std::begin(next));
+
+    int iterations = 0;
+    BoutReal max_change;
+    do {
+      // Slices before this iteration have been converged since the
+      // last, so their fine solution has not changed
+      if ((iterations == 0) or (slice >= iterations)) {
+        std::copy(std::begin(start), std::end(start), std::begin(fine));
+        fine_solve(slice_time, slice_dt, fine);
+      }
+
+      // Correct each slice in turn, starting from the corrected end
+      // of the previous slice
+      if (slice > 0) {
+        if (MPI_Recv(std::begin(start), nlocal, MPI_DOUBLE, slice - 1, iterations,
+                     time_comm, MPI_STATUS_IGNORE)) {
+          throw BoutException("MPI_Recv failed!");
+        }
+      }
+      std::copy(std::begin(start), std::end(start), std::begin(coarse_new));
+      coarse_solve(slice_time, slice_dt, coarse_new);
+
+      bout::solver::linearCombination(
+          nlocal, {1., 1., -1.},
+          {std::begin(coarse_new), std::begin(fine), std::begin(coarse)}, std::begin(u1));
+      const BoutReal change = bout::solver::meanRelativeError(
+          nlocal, std::begin(u1), std::begin(next), atol, neq);
+      swap(next, u1);
+      swap(coarse, coarse_new);
+
+      if (slice < nslices - 1) {
+        if (MPI_Send(std::begin(next), nlocal, MPI_DOUBLE, slice + 1, iterations,
+                     time_comm)) {
+          throw BoutException("MPI_Send failed!");
+        }
+      }
+
+      // Converged if no slice changed by much
+      if (MPI_Allreduce(&change, &max_change, 1, MPI_DOUBLE, MPI_MAX, time_comm)) {
+        throw BoutException("MPI_Allreduce failed!");
+      }
+      iterations++;
+    } while ((iterations < max_iterations) and (max_change >= rtol));
+
+    if (diagnose) {
+      output.write(_("\tParareal: %d iterations, last change %e\n"), iterations,
+                   max_change);
+    }
+
+    // The last slice finishes at the output time
+    if (MPI_Bcast(std::begin(next), nlocal, MPI_DOUBLE, nslices - 1, time_comm)) {
+      throw BoutException("MPI_Bcast failed!");
+    }
+    swap(state, next);
+    simtime = start_time + out_timestep;
+
+    load_vars(std::begin(state)); // Put result into variables
+    // Call rhs function to get extra variables at this time
+    run_rhs(simtime);
+
+    iteration++; // Advance iteration number
+
+    /// Call the monitor function
+    if (call_monitors(simtime, step, nsteps)) {
+      // User signalled to quit
+      break;
+    }
+  }
+
+  return 0;
+}
+
+void PararealSolver::coarse_solve(BoutReal curtime, BoutReal dt,
+                                  Array<BoutReal>& result) {
+  // RK3-SSP
+  const BoutReal h = dt / coarse_steps;
+  for (int i = 0; i < coarse_steps; i++) {
+    const BoutReal t = curtime + i * h;
+
+    derivs(t, result, k1);
+    bout::solver::multiAxpy(nlocal, std::begin(result), {h}, {std::begin(k1)},
+                            std::begin(u1));
+
+    derivs(t + h, u1, k1);
+    bout::solver::linearCombination(nlocal, {0.75, 0.25, 0.25 * h},
+                                    {std::begin(result), std::begin(u1), std::begin(k1)},
+                                    std::begin(u2));
+
+    derivs(t + 0.5 * h, u2, k1);
+    bout::solver::linearCombination(nlocal, {1. / 3., 2. / 3., 2. / 3. * h},
+                                    {std::begin(result), std::begin(u2), std::begin(k1)},
+                                    std::begin(result));
+  }
+}
+
+void PararealSolver::fine_solve(BoutReal curtime, BoutReal dt, Array<BoutReal>& result) {
+  // Classical 4th-order Runge-Kutta
+  const BoutReal h = dt / fine_steps;
+  for (int i = 0; i < fine_steps; i++) {
+    const BoutReal t = curtime + i * h;
+
+    derivs(t, result, k1);
+    bout::solver::multiAxpy(nlocal, std::begin(result), {0.5 * h}, {std::begin(k1)},
+                            std::begin(u1));
+
+    derivs(t + 0.5 * h, u1, k2);
+    bout::solver::multiAxpy(nlocal, std::begin(result), {0.5 * h}, {std::begin(k2)},
+                            std::begin(u1));
+
+    derivs(t + 0.5 * h, u1, k3);
+    bout::solver::multiAxpy(nlocal, std::begin(result), {h}, {std::begin(k3)},
+                            std::begin(u1));
+
+    derivs(t + h, u1, k4);
+    bout::solver::multiAxpy(
+        nlocal, std::begin(result), {h / 6., h / 3., h / 3., h / 6.},
+        {std::begin(k1), std::begin(k2), std::begin(k3), std::begin(k4)},
+        std::begin(result));
+  }
+}
+
+void PararealSolver::derivs(BoutReal curtime, Array<BoutReal>& f,
+                            Array<BoutReal>& result) {
+  load_vars(std::begin(f));
+  run_rhs(curtime);
+  save_derivs(std::begin(result));
+}
@@ -0,0 +1,111 @@
+/**************************************************************************
+ * Parareal parallel-in-time solver
+ *
+ * The processors are split into groups with `solver:time_slices`,
+ * each of which has a copy of the whole spatial domain. Each output
+ * timestep is divided into one slice per group. Starting from a guess
+ * for the state at the start of every slice, found with a cheap
+ * coarse integrator, each iteration
+ *
+ * - integrates every slice accurately with the fine integrator. The
+ *   groups do this at the same time
+ * - corrects the state at the start of each slice in turn, passing it
+ *   from each group to the next:
+ *
+ *       U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old)
+ *
+ *   where G is the coarse and F the fine integrator
+ *
+ * This is repeated until the correction is smaller than the tolerance.
+ * After k iterations the first k slices are the same as the fine
+ * solution, so the speed-up is at most time_slices / k.
+ *
+ * The coarse integrator is RK3-SSP, and the fine integrator is the
+ * classical 4th-order Runge-Kutta method, both with fixed timesteps.
+ *
+ * Always available, since doesn't depend on external library
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+class PararealSolver;
+
+#pragma once
+
+#ifndef PARAREAL_HXX
+#define PARAREAL_HXX
+
+#include <bout_types.hxx>
+#include <bout/solver.hxx>
+
+#include <bout/solverfactory.hxx>
+namespace {
+RegisterSolver<PararealSolver> registersolverparareal("parareal");
+}
+
+class PararealSolver : public Solver {
+public:
+  explicit PararealSolver(Options* opt = nullptr) : Solver(opt) {}
+  ~PararealSolver() = default;
+
+  BoutReal getCurrentTimestep() override { return out_timestep / nslices / fine_steps; }
+
+  int init(int nout, BoutReal tstep) override;
+
+  int run() override;
+
+private:
+  BoutReal out_timestep{0.0}; ///< The output timestep
+  int nsteps{0};              ///< Number of output steps
+
+  int nlocal{0}, neq{0}; ///< Number of variables on local processor and in total
+
+  MPI_Comm time_comm{MPI_COMM_SELF}; ///< Between time slices
+  int slice{0};                      ///< The time slice solved by this processor
+  int nslices{1};                    ///< Number of time slices
+
+  int coarse_steps{1};  ///< Coarse timesteps in each time slice
+  int fine_steps{100};  ///< Fine timesteps in each time slice
+  int max_iterations{1}; ///< Maximum number of parareal iterations
+  BoutReal atol{1e-10}, rtol{1e-5}; ///< Tolerances for convergence
+  bool diagnose{false}; ///< Print the number of iterations?
+
+  /// System state
+  Array<BoutReal> state;
+  /// State at the start of this time slice
+  Array<BoutReal> start;
+  /// Coarse and fine solutions at the end of this slice
+  Array<BoutReal> coarse, fine;
+  /// Updated coarse solution, and the corrected state at the end of
+  /// this slice
+  Array<BoutReal> coarse_new, next;
+  /// Temporary storage for taking a step
+  Array<BoutReal> u1, u2, k1, k2, k3, k4;
+
+  /// Integrate \p result from \p curtime to \p curtime + \p dt with the
+  /// coarse integrator
+  void coarse_solve(BoutReal curtime, BoutReal dt, Array<BoutReal>& result);
+  /// Integrate \p result from \p curtime to \p curtime + \p dt with the
+  /// fine integrator
+  void fine_solve(BoutReal curtime, BoutReal dt, Array<BoutReal>& result);
+
+  /// Time derivatives of \p f at \p curtime, stored in \p result
+  void derivs(BoutReal curtime, Array<BoutReal>& f, Array<BoutReal>& result);
+};
+
+#endif // PARAREAL_HXX
@@ -380,6 +380,11 @@ int PetscSolver::init(int NOUT, BoutReal TIMESTEP) {
     ierr = PetscViewerDestroy(&fd);CHKERRQ(ierr);
   } else { // create Jacobian matrix
 
+    if (field_major) {
+      throw BoutException("The Jacobian blocks assume interleaved variables, so can't "
+                          "be used with solver:field_major = true");
+    }
+
     /* number of degrees (variables) at each grid point */
     PetscInt dof = n3Dvars();
 
@@ -6,6 +6,7 @@
 #include <boutexception.hxx>
 #include <msg_stack.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/solver_kernels.hxx>
 #include <cmath>
 
 #include <output.hxx>
@@ -116,23 +117,22 @@ void RK3SSP::take_step(BoutReal curtime, BoutReal dt, Array<BoutReal> &start,
   run_rhs(curtime);
   save_derivs(std::begin(L));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    u1[i] = start[i] + dt*L[i];
+  bout::solver::multiAxpy(nlocal, std::begin(start), {dt}, {std::begin(L)},
+                          std::begin(u1));
 
   load_vars(std::begin(u1));
   run_rhs(curtime + dt);
   save_derivs(std::begin(L));
 
-  BOUT_OMP(parallel for )
-  for(int i=0;i<nlocal;i++)
-    u2[i] = 0.75*start[i] + 0.25*u1[i] + 0.25*dt*L[i];
+  bout::solver::linearCombination(nlocal, {0.75, 0.25, 0.25 * dt},
+                                  {std::begin(start), std::begin(u1), std::begin(L)},
+                                  std::begin(u2));
 
   load_vars(std::begin(u2));
   run_rhs(curtime + 0.5*dt);
   save_derivs(std::begin(L));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    result[i] = (1./3)*start[i] + (2./3.)*(u2[i] + dt*L[i]);
+  bout::solver::linearCombination(nlocal, {1. / 3., 2. / 3., 2. / 3. * dt},
+                                  {std::begin(start), std::begin(u2), std::begin(L)},
+                                  std::begin(result));
 }
@@ -6,6 +6,7 @@
 #include <boutexception.hxx>
 #include <msg_stack.hxx>
 #include <bout/openmpwrap.hxx>
+#include <bout/solver_kernels.hxx>
 
 #include <cmath>
 
@@ -101,20 +102,9 @@ int RK4Solver::run() {
           // Take a full step
           take_step(simtime, dt, f0, f1);
           
-          // Check accuracy
-          BoutReal local_err = 0.;
-          BOUT_OMP(parallel for reduction(+: local_err)   )
-          for(int i=0;i<nlocal;i++) {
-            local_err += fabs(f2[i] - f1[i]) / ( fabs(f1[i]) + fabs(f2[i]) + atol );
-          }
-        
-          // Average over all processors
-          BoutReal err;
-          if(MPI_Allreduce(&local_err, &err, 1, MPI_DOUBLE, MPI_SUM, BoutComm::get())) {
-            throw BoutException("MPI_Allreduce failed");
-          }
-
-          err /= static_cast<BoutReal>(neq);
+          // Check accuracy, averaged over all processors
+          const BoutReal err = bout::solver::meanRelativeError(
+              nlocal, std::begin(f2), std::begin(f1), atol, neq);
 
           internal_steps++;
           if(internal_steps > mxstep)
@@ -177,31 +167,29 @@ void RK4Solver::take_step(BoutReal curtime, BoutReal dt, Array<BoutReal> &start,
   run_rhs(curtime);
   save_derivs(std::begin(k1));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    k5[i] = start[i] + 0.5*dt*k1[i];
+  bout::solver::multiAxpy(nlocal, std::begin(start), {0.5 * dt}, {std::begin(k1)},
+                          std::begin(k5));
 
   load_vars(std::begin(k5));
   run_rhs(curtime + 0.5*dt);
   save_derivs(std::begin(k2));
 
-  BOUT_OMP(parallel for )
-  for(int i=0;i<nlocal;i++)
-    k5[i] = start[i] + 0.5*dt*k2[i];
+  bout::solver::multiAxpy(nlocal, std::begin(start), {0.5 * dt}, {std::begin(k2)},
+                          std::begin(k5));
 
   load_vars(std::begin(k5));
   run_rhs(curtime + 0.5*dt);
   save_derivs(std::begin(k3));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    k5[i] = start[i] + dt*k3[i];
+  bout::solver::multiAxpy(nlocal, std::begin(start), {dt}, {std::begin(k3)},
+                          std::begin(k5));
 
   load_vars(std::begin(k5));
   run_rhs(curtime + dt);
   save_derivs(std::begin(k4));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    result[i] = start[i] + (1./6.)*dt*(k1[i] + 2.*k2[i] + 2.*k3[i] + k4[i]);
+  bout::solver::multiAxpy(nlocal, std::begin(start),
+                          {dt / 6., dt / 3., dt / 3., dt / 6.},
+                          {std::begin(k1), std::begin(k2), std::begin(k3), std::begin(k4)},
+                          std::begin(result));
 }
@@ -10,8 +10,6 @@ class RK4SIMPLEScheme;
 class RK4SIMPLEScheme : public RKScheme{
 public:
   RK4SIMPLEScheme(Options *options);
-
-  BoutReal setOutputStates(const Array<BoutReal> &start,BoutReal dt, Array<BoutReal> &resultFollow);
 };
 
 #endif // __RK4SIMPLE_SCHEME_H__
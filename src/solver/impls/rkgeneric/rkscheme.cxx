@@ -1,6 +1,7 @@
 #include "rkschemefactory.hxx"
 #include "unused.hxx"
 #include <bout/rkscheme.hxx>
+#include <bout/solver_kernels.hxx>
 #include <boutcomm.hxx>
 #include <cmath>
 #include <output.hxx>
@@ -56,26 +57,18 @@ BoutReal RKScheme::setCurTime(const BoutReal timeIn, const BoutReal dt, const in
 void RKScheme::setCurState(const Array<BoutReal> &start, Array<BoutReal> &out,
                            const int curStage, const BoutReal dt) {
 
-  //Set the initial stage
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++){
-    out[i] = start[i];
-  }
-
-  //If on the first stage we don't need to modify the state
-  if(curStage==0) return;//Don't realy need this as below loop won't execute
-  
-  //Construct the current state from previous results -- This is expensive
+  //Construct the current state from previous results in a single pass
+  std::vector<BoutReal> coefficients;
+  std::vector<const BoutReal*> vectors;
   for(int j=0;j<curStage;j++){
     if (std::abs(stageCoeffs(curStage, j)) < atol)
       continue;
-    BoutReal fac = stageCoeffs(curStage, j) * dt;
-
-    BOUT_OMP(parallel for)
-    for(int i=0;i<nlocal;i++){
-      out[i] = out[i] + fac * steps(j, i);
-    }
+    coefficients.push_back(stageCoeffs(curStage, j) * dt);
+    vectors.push_back(&steps(j, 0));
   }
+
+  bout::solver::multiAxpy(nlocal, std::begin(start), coefficients, vectors,
+                          std::begin(out));
 }
 
 //Construct the system state at the next time
@@ -131,70 +124,34 @@ BoutReal RKScheme::getErr(Array<BoutReal> &solA, Array<BoutReal> &solB) {
   //If not adaptive don't care about the error
   if(!adaptive){return err;}
 
-  //Get local part of relative error
-  BoutReal local_err = 0.;
-
-  // Note because the order of operation is not deterministic
-  // we expect slightly different round-off error each time this
-  // is called and hence the nrhs may no longer be exactly
-  // repeatable with this parallelisation.
-  BOUT_OMP(parallel for reduction(+:local_err))
-  for(int i=0;i<nlocal;i++) {
-    local_err +=
-        std::abs(solA[i] - solB[i]) / (std::abs(solA[i]) + std::abs(solB[i]) + atol);
-  }
-  //Reduce over procs
-  if(MPI_Allreduce(&local_err, &err, 1, MPI_DOUBLE, MPI_SUM, BoutComm::get())) {
-    throw BoutException("MPI_Allreduce failed");
-  }
-  //Normalise by number of values
-  err /= static_cast<BoutReal>(neq);
+  //Relative error, averaged over all processors
+  err = bout::solver::meanRelativeError(nlocal, std::begin(solA), std::begin(solB), atol,
+                                        neq);
 
   return err;
 }
 
 void RKScheme::constructOutput(const Array<BoutReal> &start, const BoutReal dt,
                                const int index, Array<BoutReal> &sol) {
-  //Initialise the return data
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++){
-    sol[i]=start[i];
-  }
-
-  //Construct the solution
+  //Construct the solution in a single pass
+  std::vector<BoutReal> coefficients;
+  std::vector<const BoutReal*> vectors;
   for(int curStage=0;curStage<getStageCount();curStage++){
     if (resultCoeffs(curStage, index) == 0.)
       continue; // Real comparison not great
-    BoutReal fac = dt * resultCoeffs(curStage, index);
-    BOUT_OMP(parallel for)
-    for(int i=0;i<nlocal;i++){
-      sol[i] = sol[i] + fac * steps(curStage, i);
-    }
+    coefficients.push_back(dt * resultCoeffs(curStage, index));
+    vectors.push_back(&steps(curStage, 0));
   }
-  
+
+  bout::solver::multiAxpy(nlocal, std::begin(start), coefficients, vectors,
+                          std::begin(sol));
 }
 
 void RKScheme::constructOutputs(const Array<BoutReal> &start, const BoutReal dt,
                                 const int indexFollow, const int indexAlt,
                                 Array<BoutReal> &solFollow, Array<BoutReal> &solAlt) {
-  //Initialise the return data
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++){
-    solFollow[i]=start[i];
-    solAlt[i]=start[i];
-  }
-
-  //Construct the solution
-  for(int curStage=0;curStage<getStageCount();curStage++){
-    BoutReal facFol = dt * resultCoeffs(curStage, indexFollow);
-    BoutReal facAlt = dt * resultCoeffs(curStage, indexAlt);
-    BOUT_OMP(parallel for)
-    for(int i=0;i<nlocal;i++){
-      solFollow[i] = solFollow[i] + facFol * steps(curStage, i);
-      solAlt[i] = solAlt[i] + facAlt * steps(curStage, i);
-    }
-  }
-  
+  constructOutput(start, dt, indexFollow, solFollow);
+  constructOutput(start, dt, indexAlt, solAlt);
 }
 
 //Check that the coefficients are consistent
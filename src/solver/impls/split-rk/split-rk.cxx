@@ -1,5 +1,7 @@
 #include "split-rk.hxx"
 
+#include <bout/solver_kernels.hxx>
+
 int SplitRK::init(int nout, BoutReal tstep) {
   AUTO_TRACE();
 
@@ -114,20 +116,9 @@ int SplitRK::run() {
           // Take a full step
           take_step(simtime, dt, state, state1);
 
-          // Check accuracy
-          BoutReal local_err = 0.;
-          BOUT_OMP(parallel for reduction(+: local_err)   )
-          for (int i = 0; i < nlocal; i++) {
-            local_err += fabs(state2[i] - state1[i]) / (fabs(state1[i]) + fabs(state2[i]) + atol);
-          }
-          
-          // Average over all processors
-          BoutReal err;
-          if (MPI_Allreduce(&local_err, &err, 1, MPI_DOUBLE, MPI_SUM, BoutComm::get())) {
-            throw BoutException("MPI_Allreduce failed");
-          }
-
-          err /= static_cast<BoutReal>(neq);
+          // Check accuracy, averaged over all processors
+          const BoutReal err = bout::solver::meanRelativeError(
+              nlocal, std::begin(state2), std::begin(state1), atol, neq);
           
           internal_steps++;
           if (internal_steps > mxstep) {
@@ -224,10 +215,8 @@ void SplitRK::take_diffusion_step(BoutReal curtime, BoutReal dt, Array<BoutReal>
   // Stage j = 1
   // y_m2 = y0 + weight/3.0 * f(y0)  -> u2
 
-  BOUT_OMP(parallel for)
-  for (int i = 0; i < dydt.size(); i++) {
-    u2[i] = start[i] + (weight/3.0) * dydt[i];
-  }
+  bout::solver::multiAxpy(dydt.size(), std::begin(start), {weight / 3.0},
+                          {std::begin(dydt)}, std::begin(u2));
   
   // Stage j = 2
   // mu = 1.5, nu terms cancel
@@ -235,10 +224,10 @@ void SplitRK::take_diffusion_step(BoutReal curtime, BoutReal dt, Array<BoutReal>
   run_diffusive(curtime + (weight/3.0) * dt);
   save_derivs(std::begin(u3)); // f(y_m2) -> u3
   
-  BOUT_OMP(parallel for)
-  for (int i = 0; i < u3.size(); i++) {
-    u1[i] = 1.5 * (u2[i] + weight * u3[i]) - 0.5 * start[i] - weight * dydt[i];
-  }
+  bout::solver::linearCombination(
+      u3.size(), {1.5, 1.5 * weight, -0.5, -weight},
+      {std::begin(u2), std::begin(u3), std::begin(start), std::begin(dydt)},
+      std::begin(u1));
   
   BoutReal b_jm2 = 1. / 3; // b_{j - 2}
   BoutReal b_jm1 = 1. / 3; // b_{j - 1}
@@ -255,12 +244,13 @@ void SplitRK::take_diffusion_step(BoutReal curtime, BoutReal dt, Array<BoutReal>
     run_diffusive(curtime);
     save_derivs(std::begin(u3)); // f(y_m1) -> u3
     
-    BOUT_OMP(parallel for)
-    for (int i = 0; i < u3.size(); i++) {
-      // Next stage result in u3
-      u3[i] = mu * (u1[i] + weight * (u3[i] - a_jm1 * dydt[i])) + nu * u2[i]
-              + (1. - mu - nu) * start[i];
-    }
+    // Next stage result in u3
+    bout::solver::linearCombination(u3.size(),
+                                    {mu, mu * weight, -mu * weight * a_jm1, nu,
+                                     1. - mu - nu},
+                                    {std::begin(u1), std::begin(u3), std::begin(dydt),
+                                     std::begin(u2), std::begin(start)},
+                                    std::begin(u3));
 
     // Cycle values
     b_jm2 = b_jm1;
@@ -284,23 +274,22 @@ void SplitRK::take_advection_step(BoutReal curtime, BoutReal dt, Array<BoutReal>
   run_convective(curtime);
   save_derivs(std::begin(dydt));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    u1[i] = start[i] + dt*dydt[i];
+  bout::solver::multiAxpy(nlocal, std::begin(start), {dt}, {std::begin(dydt)},
+                          std::begin(u1));
 
   load_vars(std::begin(u1));
   run_convective(curtime + dt);
   save_derivs(std::begin(dydt));
 
-  BOUT_OMP(parallel for )
-  for(int i=0;i<nlocal;i++)
-    u2[i] = 0.75*start[i] + 0.25*u1[i] + 0.25*dt*dydt[i];
+  bout::solver::linearCombination(nlocal, {0.75, 0.25, 0.25 * dt},
+                                  {std::begin(start), std::begin(u1), std::begin(dydt)},
+                                  std::begin(u2));
 
   load_vars(std::begin(u2));
   run_convective(curtime + 0.5*dt);
   save_derivs(std::begin(dydt));
 
-  BOUT_OMP(parallel for)
-  for(int i=0;i<nlocal;i++)
-    result[i] = (1./3)*start[i] + (2./3.)*(u2[i] + dt*dydt[i]);
+  bout::solver::linearCombination(nlocal, {1. / 3., 2. / 3., 2. / 3. * dt},
+                                  {std::begin(start), std::begin(u2), std::begin(dydt)},
+                                  std::begin(result));
 }
@@ -34,7 +34,9 @@
 #include "bout/solverfactory.hxx"
 #include "bout/sys/timer.hxx"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <numeric>
@@ -51,6 +53,10 @@ char ***Solver::pargv = nullptr;
 Solver::Solver(Options* opts)
     : options(opts == nullptr ? &Options::root()["solver"] : opts),
       monitor_timestep((*options)["monitor_timestep"].withDefault(false)),
+      field_major((*options)["field_major"]
+                      .doc("Store each variable contiguously in the state vector, "
+                           "rather than interleaving the variables at each point?")
+                      .withDefault(false)),
       is_nonsplit_model_diffusive(
           (*options)["is_nonsplit_model_diffusive"]
               .doc("If not a split operator, treat RHS as diffusive?")
@@ -134,6 +140,10 @@ void Solver::add(Field2D& v, const std::string& name) {
   d.evolve_bndry = Options::root()["all"]["evolve_bndry"].withDefault(false);
   d.evolve_bndry = Options::root()[name]["evolve_bndry"].withDefault(d.evolve_bndry);
 
+  d.slow = Options::root()[name]["slow"]
+               .doc("Evolve with the slow timestep in multirate solvers?")
+               .withDefault(false);
+
   v.applyBoundary(true);
 
   f2d.emplace_back(std::move(d));
@@ -192,6 +202,10 @@ void Solver::add(Field3D& v, const std::string& name) {
   d.evolve_bndry = Options::root()["all"]["evolve_bndry"].withDefault(false);
   d.evolve_bndry = Options::root()[name]["evolve_bndry"].withDefault(d.evolve_bndry);
 
+  d.slow = Options::root()[name]["slow"]
+               .doc("Evolve with the slow timestep in multirate solvers?")
+               .withDefault(false);
+
   v.applyBoundary(true); // Make sure initial profile obeys boundary conditions
   v.setLocation(d.location); // Restore location if changed
   
@@ -217,6 +231,10 @@ void Solver::add(Vector2D& v, const std::string& name) {
   d.F_var = &ddt(v);
   d.covariant = v.covariant;
   d.name = name;
+  d.slow = Options::root()[name]["slow"]
+               .doc("Evolve all the components with the slow timestep in multirate "
+                    "solvers?")
+               .withDefault(false);
 
   /// NOTE: No initial_profile call, because this will be done for each
   ///       component individually.
@@ -232,6 +250,13 @@ void Solver::add(Vector2D& v, const std::string& name) {
     add(v.z, d.name + "z");
   }
 
+  // A component is also slow if its own "slow" option is set
+  if (d.slow) {
+    for (auto it = f2d.end() - 3; it != f2d.end(); ++it) {
+      it->slow = true;
+    }
+  }
+
   /// Make sure initial profile obeys boundary conditions
   v.applyBoundary(true);
   v2d.emplace_back(std::move(d));
@@ -256,6 +281,10 @@ void Solver::add(Vector3D& v, const std::string& name) {
   d.F_var = &ddt(v);
   d.covariant = v.covariant;
   d.name = name;
+  d.slow = Options::root()[name]["slow"]
+               .doc("Evolve all the components with the slow timestep in multirate "
+                    "solvers?")
+               .withDefault(false);
 
   // Add suffix, depending on co- /contravariance
   if (v.covariant) {
@@ -268,6 +297,13 @@ void Solver::add(Vector3D& v, const std::string& name) {
     add(v.z, d.name + "z");
   }
 
+  // A component is also slow if its own "slow" option is set
+  if (d.slow) {
+    for (auto it = f3d.end() - 3; it != f3d.end(); ++it) {
+      it->slow = true;
+    }
+  }
+
   v.applyBoundary(true);
   v3d.emplace_back(std::move(d));
 }
@@ -539,6 +575,15 @@ void Solver::outputVars(Datafile &outputfile, bool save_repeat) {
   outputfile.addOnce(simtime,  "tt");
   outputfile.addOnce(iteration, "hist_hi");
 
+  // Only reduced diagnostics may be wanted in the output, but the
+  // full fields are always needed for restarting
+  if (save_repeat
+      and not Options::root()["diagnostics"]["save_fields"]
+                  .doc("Write the evolving fields to the output file?")
+                  .withDefault(true)) {
+    return;
+  }
+
   // Add 2D and 3D evolving fields to output file
   for(const auto& f : f2d) {
     // Add to dump file (appending)
@@ -555,6 +600,108 @@ void Solver::outputVars(Datafile &outputfile, bool save_repeat) {
   }
 }
 
+namespace {
+/// The bitwise XOR of the values of \p a and \p b. This is its own
+/// inverse, so is a lossless difference between fields
+template <class T>
+T xorBits(const T& a, const T& b) {
+  static_assert(sizeof(BoutReal) == sizeof(std::uint64_t),
+                "xorBits assumes BoutReal is 64 bits");
+  T result{emptyFrom(a)};
+  BOUT_FOR(i, result.getRegion("RGN_ALL")) {
+    std::uint64_t bits_a, bits_b;
+    std::memcpy(&bits_a, &a[i], sizeof(bits_a));
+    std::memcpy(&bits_b, &b[i], sizeof(bits_b));
+    bits_a ^= bits_b;
+    std::memcpy(&result[i], &bits_a, sizeof(bits_a));
+  }
+  return result;
+}
+} // namespace
+
+void Solver::outputDeltas(Datafile& outputfile) {
+  outputfile.addOnce(delta_simtime, "tt");
+  outputfile.addOnce(delta_iteration, "hist_hi");
+  outputfile.addOnce(delta_base_iteration, "base_hist_hi");
+  outputfile.addOnce(delta_complete_iteration, "complete_hist_hi");
+
+  // Sized before adding, as the file keeps pointers to the fields
+  delta2d.resize(f2d.size());
+  delta3d.resize(f3d.size());
+  for (std::size_t i = 0; i < f2d.size(); ++i) {
+    outputfile.addOnce(delta2d[i], f2d[i].name);
+  }
+  for (std::size_t i = 0; i < f3d.size(); ++i) {
+    outputfile.addOnce(delta3d[i], f3d[i].name);
+  }
+}
+
+void Solver::setDeltaBase() {
+  TRACE("Solver::setDeltaBase");
+
+  base2d.clear();
+  base3d.clear();
+  for (const auto& f : f2d) {
+    base2d.push_back(copy(*f.var));
+  }
+  for (const auto& f : f3d) {
+    base3d.push_back(copy(*f.var));
+  }
+  base_iteration = iteration;
+}
+
+void Solver::calculateDeltas() {
+  TRACE("Solver::calculateDeltas");
+
+  if (base2d.size() != f2d.size() or base3d.size() != f3d.size()
+      or delta2d.size() != f2d.size() or delta3d.size() != f3d.size()) {
+    throw BoutException("Solver::calculateDeltas: outputDeltas and setDeltaBase must "
+                        "be called first");
+  }
+
+  for (std::size_t i = 0; i < f2d.size(); ++i) {
+    delta2d[i] = xorBits(*f2d[i].var, base2d[i]);
+  }
+  for (std::size_t i = 0; i < f3d.size(); ++i) {
+    delta3d[i] = xorBits(*f3d[i].var, base3d[i]);
+  }
+  delta_simtime = simtime;
+  delta_iteration = iteration;
+  delta_base_iteration = base_iteration;
+  delta_complete_iteration = -1;
+}
+
+void Solver::markDeltasComplete() { delta_complete_iteration = delta_iteration; }
+
+bool Solver::deltasMatchState() const {
+  return delta_complete_iteration == delta_iteration
+         and delta_base_iteration == iteration;
+}
+
+void Solver::applyDeltas() {
+  TRACE("Solver::applyDeltas");
+
+  if (delta_complete_iteration != delta_iteration) {
+    throw BoutException("Solver::applyDeltas: deltas for iteration %d were not "
+                        "completely written",
+                        delta_iteration);
+  }
+  if (delta_base_iteration != iteration) {
+    throw BoutException("Solver::applyDeltas: deltas are from iteration %d, but the "
+                        "state is from iteration %d",
+                        delta_base_iteration, iteration);
+  }
+
+  for (std::size_t i = 0; i < f2d.size(); ++i) {
+    *f2d[i].var = xorBits(*f2d[i].var, delta2d[i]);
+  }
+  for (std::size_t i = 0; i < f3d.size(); ++i) {
+    *f3d[i].var = xorBits(*f3d[i].var, delta3d[i]);
+  }
+  simtime = delta_simtime;
+  iteration = delta_iteration;
+}
+
 /////////////////////////////////////////////////////
 
 BoutReal Solver::adjustMonitorPeriods(Monitor* new_monitor) {
@@ -792,144 +939,163 @@ Solver* Solver::create(const SolverType& type, Options* opts) {
 /**************************************************************************
  * Looping over variables
  *
- * NOTE: This part is very inefficient, and should be replaced ASAP
- * Is the interleaving of variables needed or helpful to the solver?
+ * By default the variables are interleaved: at each point, the 2D
+ * variables and then the 3D variables at each z in turn. Every
+ * boundary point, and every bulk point, holds the same number of
+ * values, so the offset of each point in the state vector is known
+ * without counting through the points before it, and the points can
+ * be copied in parallel.
+ *
+ * With solver:field_major = true, each variable is instead stored
+ * contiguously in the state vector, so it is copied in blocks.
+ * Band preconditioners and Jacobian colourings which assume
+ * interleaved variables can't be used with this layout.
  **************************************************************************/
 
-/// Perform an operation at a given Ind2D (jx,jy) location, moving data between BOUT++ and CVODE
-void Solver::loop_vars_op(Ind2D i2d, BoutReal *udata, int &p, SOLVER_VAR_OP op, bool bndry) {
+namespace {
+/// Copy the \p nz values of a Z-line into \p udata, which has a
+/// stride of \p stride between them
+void gatherLine(const BoutReal* line, BoutReal* udata, int nz, int stride) {
+  BOUT_OMP(simd)
+  for (int jz = 0; jz < nz; ++jz) {
+    udata[jz * stride] = line[jz];
+  }
+}
+
+/// Copy \p nz values, with a stride of \p stride, from \p udata into
+/// a Z-line
+void scatterLine(const BoutReal* udata, BoutReal* line, int nz, int stride) {
+  BOUT_OMP(simd)
+  for (int jz = 0; jz < nz; ++jz) {
+    line[jz] = udata[jz * stride];
+  }
+}
+} // namespace
+
+/// Perform an operation at a given Ind2D (jx,jy) location, moving data
+/// between BOUT++ and the solver. \p p is the offset of this point in
+/// \p udata, and \p n3d the number of 3D variables at this point
+void Solver::loop_vars_op(Ind2D i2d, BoutReal* udata, int p, int n3d, SOLVER_VAR_OP op,
+                          bool bndry) {
   // Use global mesh: FIX THIS!
   Mesh* mesh = bout::globals::mesh;
 
-  int nz = mesh->LocalNz;
-  
-  switch(op) {
-    case SOLVER_VAR_OP::LOAD_VARS: {
-    /// Load variables from IDA into BOUT++
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      (*f.var)[i2d] = udata[p];
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        (*f.var)[f.var->getMesh()->ind2Dto3D(i2d, jz)] = udata[p];
-        p++;
-      }  
+  const int nz = mesh->LocalNz;
+
+  // Loop over 2D variables
+  for (const auto& f : f2d) {
+    if (bndry && !f.evolve_bndry) {
+      continue;
     }
-    break;
-  }
-  case SOLVER_VAR_OP::LOAD_DERIVS: {
-    /// Load derivatives from IDA into BOUT++
-    /// Used for preconditioner
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
+    switch (op) {
+    case SOLVER_VAR_OP::LOAD_VARS:
+      (*f.var)[i2d] = udata[p];
+      break;
+    case SOLVER_VAR_OP::LOAD_DERIVS:
       (*f.F_var)[i2d] = udata[p];
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        (*f.F_var)[f.F_var->getMesh()->ind2Dto3D(i2d, jz)] = udata[p];
-        p++;
-      }  
+      break;
+    case SOLVER_VAR_OP::SET_ID:
+      udata[p] = f.constraint ? 0 : 1;
+      break;
+    case SOLVER_VAR_OP::SAVE_VARS:
+      udata[p] = (*f.var)[i2d];
+      break;
+    case SOLVER_VAR_OP::SAVE_DERIVS:
+      udata[p] = (*f.F_var)[i2d];
+      break;
+    case SOLVER_VAR_OP::SET_SLOW:
+      udata[p] = f.slow ? 1 : 0;
+      break;
     }
-    
-    break;
+    p++;
   }
-  case SOLVER_VAR_OP::SET_ID: {
-    /// Set the type of equation (Differential or Algebraic)
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-	continue;
-      if(f.constraint) {
-	udata[p] = 0;
-      }else {
-	udata[p] = 1;
-      }
-      p++;
+
+  // Loop over 3D variables. Each Z-line is contiguous in the field,
+  // and interleaved with the other variables in udata
+  BoutReal* u = udata + p;
+  for (const auto& f : f3d) {
+    if (bndry && !f.evolve_bndry) {
+      continue;
     }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-	  continue;
-	if(f.constraint) {
-	  udata[p] = 0;
-	}else {
-	  udata[p] = 1;
-	}
-	p++;
+    const auto i3d = f.var->getMesh()->ind2Dto3D(i2d, 0);
+    switch (op) {
+    case SOLVER_VAR_OP::LOAD_VARS:
+      scatterLine(u, &(*f.var)[i3d], nz, n3d);
+      break;
+    case SOLVER_VAR_OP::LOAD_DERIVS:
+      scatterLine(u, &(*f.F_var)[i3d], nz, n3d);
+      break;
+    case SOLVER_VAR_OP::SET_ID:
+      for (int jz = 0; jz < nz; jz++) {
+        u[jz * n3d] = f.constraint ? 0 : 1;
       }
+      break;
+    case SOLVER_VAR_OP::SAVE_VARS:
+      gatherLine(&(*f.var)[i3d], u, nz, n3d);
+      break;
+    case SOLVER_VAR_OP::SAVE_DERIVS:
+      gatherLine(&(*f.F_var)[i3d], u, nz, n3d);
+      break;
+    case SOLVER_VAR_OP::SET_SLOW:
+      for (int jz = 0; jz < nz; jz++) {
+        u[jz * n3d] = f.slow ? 1 : 0;
+      }
+      break;
     }
-    
-    break;
-  }
-  case SOLVER_VAR_OP::SAVE_VARS: {
-    /// Save variables from BOUT++ into IDA (only used at start of simulation)
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      udata[p] = (*f.var)[i2d];
-      p++;
-    }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        udata[p] = (*f.var)[f.var->getMesh()->ind2Dto3D(i2d, jz)];
-        p++;
-      }  
-    }
-    break;
+    u++;
   }
-    /// Save time-derivatives from BOUT++ into CVODE (returning RHS result)
-  case SOLVER_VAR_OP::SAVE_DERIVS: {
-    
-    // Loop over 2D variables
-    for(const auto& f : f2d) {
-      if(bndry && !f.evolve_bndry)
-        continue;
-      udata[p] = (*f.F_var)[i2d];
-      p++;
+}
+
+/// Copy the points in one variable between BOUT++ and the solver, for
+/// the field-major layout. The points are in the same order as the
+/// field's own data, so each contiguous block is a single copy
+template <class T>
+void Solver::loop_vars_field(VarStr<T>& f, BoutReal* udata, int& p, SOLVER_VAR_OP op) {
+  // Boundary points first, if evolving, then the bulk
+  std::vector<const Region<typename T::ind_type>*> regions;
+  if (f.evolve_bndry) {
+    regions.push_back(&f.var->getRegion("RGN_BNDRY"));
+  }
+  regions.push_back(&f.var->getRegion("RGN_NOBNDRY"));
+
+  for (const auto* region : regions) {
+    const auto& blocks = region->getBlocks();
+    const int nblocks = blocks.size();
+
+    // Offset of each block in udata, so the blocks can be copied in parallel
+    std::vector<int> offsets(nblocks + 1, p);
+    for (int b = 0; b < nblocks; ++b) {
+      offsets[b + 1] = offsets[b] + blocks[b].second.ind - blocks[b].first.ind;
     }
-    
-    for (int jz=0; jz < nz; jz++) {
-      
-      // Loop over 3D variables
-      for(const auto& f : f3d) {
-        if(bndry && !f.evolve_bndry)
-          continue;
-        udata[p] = (*f.F_var)[f.F_var->getMesh()->ind2Dto3D(i2d, jz)];
-        p++;
+
+    BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+    for (int b = 0; b < nblocks; ++b) {
+      const auto& first = blocks[b].first;
+      BoutReal* u = udata + offsets[b];
+      const int length = offsets[b + 1] - offsets[b];
+
+      switch (op) {
+      case SOLVER_VAR_OP::LOAD_VARS:
+        std::copy_n(u, length, &(*f.var)[first]);
+        break;
+      case SOLVER_VAR_OP::LOAD_DERIVS:
+        std::copy_n(u, length, &(*f.F_var)[first]);
+        break;
+      case SOLVER_VAR_OP::SET_ID:
+        std::fill_n(u, length, f.constraint ? 0 : 1);
+        break;
+      case SOLVER_VAR_OP::SAVE_VARS:
+        std::copy_n(&(*f.var)[first], length, u);
+        break;
+      case SOLVER_VAR_OP::SAVE_DERIVS:
+        std::copy_n(&(*f.F_var)[first], length, u);
+        break;
+      case SOLVER_VAR_OP::SET_SLOW:
+        std::fill_n(u, length, f.slow ? 1 : 0);
+        break;
       }
     }
-    break;
-  }
+    p = offsets[nblocks];
   }
 }
 
@@ -938,16 +1104,48 @@ void Solver::loop_vars(BoutReal *udata, SOLVER_VAR_OP op) {
   // Use global mesh: FIX THIS!
   Mesh* mesh = bout::globals::mesh;
 
-  int p = 0; // Counter for location in udata array
-  
+  if (field_major) {
+    int p = 0; // Counter for location in udata array
+
+    // Each variable in turn, 2D then 3D
+    for (auto& f : f2d) {
+      loop_vars_field(f, udata, p, op);
+    }
+    for (auto& f : f3d) {
+      loop_vars_field(f, udata, p, op);
+    }
+    return;
+  }
+
+  const int nz = mesh->LocalNz;
+
+  // Number of variables evolving in the boundaries
+  const auto evolve_bndry = [](const VarStr<Field2D>& f) { return f.evolve_bndry; };
+  const int n2dbndry = std::count_if(begin(f2d), end(f2d), evolve_bndry);
+  const int n3dbndry = std::count_if(begin(f3d), end(f3d), [](const VarStr<Field3D>& f) {
+    return f.evolve_bndry;
+  });
+  const int n3d = f3d.size();
+
+  // Number of values at each boundary and bulk point
+  const int bndry_size = n2dbndry + nz * n3dbndry;
+  const int bulk_size = static_cast<int>(f2d.size()) + nz * n3d;
+
   // All boundaries
-  for(const auto &i2d : mesh->getRegion2D("RGN_BNDRY")) {
-    loop_vars_op(i2d, udata, p, op, true);
+  const auto& bndry = mesh->getRegion2D("RGN_BNDRY").getIndices();
+  const int nbndry = bndry.size();
+  BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+  for (int i = 0; i < nbndry; ++i) {
+    loop_vars_op(bndry[i], udata, i * bndry_size, n3dbndry, op, true);
   }
-  
+
   // Bulk of points
-  for(const auto &i2d : mesh->getRegion2D("RGN_NOBNDRY")) {
-    loop_vars_op(i2d, udata, p, op, false);
+  const auto& bulk = mesh->getRegion2D("RGN_NOBNDRY").getIndices();
+  const int nbulk = bulk.size();
+  const int bulk_start = nbndry * bndry_size;
+  BOUT_OMP(parallel for schedule(OPENMP_SCHEDULE))
+  for (int i = 0; i < nbulk; ++i) {
+    loop_vars_op(bulk[i], udata, bulk_start + i * bulk_size, n3d, op, false);
   }
 }
 
@@ -1048,10 +1246,19 @@ void Solver::set_id(BoutReal *udata) {
   loop_vars(udata, SOLVER_VAR_OP::SET_ID);
 }
 
+void Solver::set_slow(BoutReal* udata) {
+  loop_vars(udata, SOLVER_VAR_OP::SET_SLOW);
+}
+
 Field3D Solver::globalIndex(int localStart) {
   // Use global mesh: FIX THIS!
   Mesh* mesh = bout::globals::mesh;
 
+  if (field_major) {
+    throw BoutException(_("The global indices assume interleaved variables, so can't "
+                          "be used with solver:field_major = true"));
+  }
+
   Field3D index(-1, mesh); // Set to -1, indicating out of domain
 
   int n2d = f2d.size();
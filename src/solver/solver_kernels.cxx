@@ -0,0 +1,88 @@
+#include "bout/solver_kernels.hxx"
+#include "boutexception.hxx"
+#include "bout/assert.hxx"
+#include "bout/openmpwrap.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Number of values in each block. A block of each vector, and the
+/// sum, should fit in the L1 cache together
+constexpr int block_size = 256;
+} // namespace
+
+namespace bout {
+namespace solver {
+
+void linearCombination(int n, const std::vector<BoutReal>& coefficients,
+                       const std::vector<const BoutReal*>& vectors, BoutReal* result) {
+  ASSERT1(coefficients.size() == vectors.size());
+
+  const int nvectors = vectors.size();
+  if (nvectors == 0) {
+    std::fill_n(result, n, 0.0);
+    return;
+  }
+
+  BOUT_OMP(parallel for schedule(static))
+  for (int start = 0; start < n; start += block_size) {
+    const int length = std::min(block_size, n - start);
+
+    // Sum into a separate block, so that result can be one of the vectors
+    BoutReal sum[block_size];
+    {
+      const BoutReal a = coefficients[0];
+      const BoutReal* v = vectors[0] + start;
+      BOUT_OMP(simd)
+      for (int i = 0; i < length; ++i) {
+        sum[i] = a * v[i];
+      }
+    }
+    for (int j = 1; j < nvectors; ++j) {
+      const BoutReal a = coefficients[j];
+      const BoutReal* v = vectors[j] + start;
+      BOUT_OMP(simd)
+      for (int i = 0; i < length; ++i) {
+        sum[i] += a * v[i];
+      }
+    }
+    std::copy_n(sum, length, result + start);
+  }
+}
+
+void multiAxpy(int n, const BoutReal* x, const std::vector<BoutReal>& coefficients,
+               const std::vector<const BoutReal*>& vectors, BoutReal* result) {
+  ASSERT1(coefficients.size() == vectors.size());
+
+  std::vector<BoutReal> all_coefficients{1.0};
+  all_coefficients.insert(all_coefficients.end(), coefficients.begin(),
+                          coefficients.end());
+  std::vector<const BoutReal*> all_vectors{x};
+  all_vectors.insert(all_vectors.end(), vectors.begin(), vectors.end());
+
+  linearCombination(n, all_coefficients, all_vectors, result);
+}
+
+BoutReal meanRelativeError(int n, const BoutReal* a, const BoutReal* b, BoutReal atol,
+                           int neq, MPI_Comm comm) {
+  // Note because the order of operation is not deterministic
+  // we expect slightly different round-off error each time this
+  // is called
+  BoutReal local_err = 0.;
+  BOUT_OMP(parallel for simd reduction(+: local_err) schedule(static))
+  for (int i = 0; i < n; ++i) {
+    local_err += std::abs(a[i] - b[i]) / (std::abs(a[i]) + std::abs(b[i]) + atol);
+  }
+
+  // Sum over all processors
+  BoutReal err;
+  if (MPI_Allreduce(&local_err, &err, 1, MPI_DOUBLE, MPI_SUM, comm)) {
+    throw BoutException("MPI_Allreduce failed");
+  }
+
+  return err / static_cast<BoutReal>(neq);
+}
+
+} // namespace solver
+} // namespace bout
@@ -0,0 +1,259 @@
+#include "bout/sys/array_allocator.hxx"
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace bout {
+
+namespace {
+/// Free blocks, indexed by size class
+using FreeLists = std::map<std::size_t, std::vector<void*>>;
+
+/// State shared between all threads
+struct SharedPool {
+  std::mutex mutex;
+  FreeLists blocks;
+
+  std::atomic<bool> enabled{true};
+  std::atomic<bool> use_huge_pages{false};
+  std::atomic<std::size_t> max_bytes_held{static_cast<std::size_t>(-1)};
+
+  std::atomic<std::size_t> hits{0};
+  std::atomic<std::size_t> misses{0};
+  std::atomic<std::size_t> discards{0};
+  std::atomic<std::size_t> bytes_held{0};
+  std::atomic<std::size_t> bytes_in_use{0};
+  std::atomic<std::size_t> peak_bytes_in_use{0};
+};
+
+/// Note: this is never deleted, so that Arrays with static storage
+/// duration can still be freed after main() has returned
+SharedPool& sharedPool() {
+  static auto* pool = new SharedPool;
+  return *pool;
+}
+
+void* systemAllocate(std::size_t bytes) {
+  auto& pool = sharedPool();
+
+  const bool huge = pool.use_huge_pages and bytes >= ArrayAllocator::huge_page_size;
+
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr,
+                     huge ? ArrayAllocator::huge_page_size : ArrayAllocator::alignment,
+                     bytes)
+      != 0) {
+    throw std::bad_alloc();
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (huge) {
+    // Only a hint, so ignore any errors
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+  }
+#endif
+  return ptr;
+}
+
+void systemFree(void* ptr) { std::free(ptr); }
+
+/// Return all the blocks in \p lists to the system
+void freeAll(FreeLists& lists) {
+  auto& pool = sharedPool();
+  for (auto& size_blocks : lists) {
+    for (void* ptr : size_blocks.second) {
+      systemFree(ptr);
+      pool.bytes_held -= size_blocks.first;
+    }
+  }
+  lists.clear();
+}
+
+/// Free blocks belonging to one thread. When the thread exits they
+/// are moved to the shared pool
+struct ThreadCache {
+  FreeLists blocks;
+
+  ~ThreadCache() {
+    auto& pool = sharedPool();
+    if (not pool.enabled) {
+      freeAll(blocks);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    for (auto& size_blocks : blocks) {
+      auto& shared = pool.blocks[size_blocks.first];
+      shared.insert(shared.end(), size_blocks.second.begin(), size_blocks.second.end());
+    }
+  }
+};
+
+thread_local ThreadCache* thread_cache_ptr = nullptr;
+
+/// Get this thread's cache, or nullptr if the thread is exiting and
+/// the cache has already been destroyed
+ThreadCache* threadCache() {
+  struct Owner {
+    ThreadCache cache;
+    Owner() { thread_cache_ptr = &cache; }
+    ~Owner() { thread_cache_ptr = nullptr; }
+  };
+  thread_local Owner owner;
+  return thread_cache_ptr;
+}
+
+/// Take a free block of size class \p size_class from \p lists, or
+/// return nullptr if there isn't one
+void* takeFrom(FreeLists& lists, std::size_t size_class) {
+  auto it = lists.find(size_class);
+  if (it == lists.end() or it->second.empty()) {
+    return nullptr;
+  }
+  void* ptr = it->second.back();
+  it->second.pop_back();
+  return ptr;
+}
+} // namespace
+
+std::size_t ArrayAllocator::sizeClass(std::size_t bytes) {
+  if (bytes <= 1024) {
+    return ((bytes + alignment - 1) / alignment) * alignment;
+  }
+  // Four classes between each power of two
+  std::size_t power = 1024;
+  while (power * 2 < bytes) {
+    power *= 2;
+  }
+  const std::size_t step = power / 4;
+  return ((bytes + step - 1) / step) * step;
+}
+
+void* ArrayAllocator::allocate(std::size_t bytes) {
+  if (bytes == 0) {
+    return nullptr;
+  }
+
+  auto& pool = sharedPool();
+  const std::size_t size_class = sizeClass(bytes);
+
+  void* ptr = nullptr;
+  if (pool.enabled) {
+    // Try this thread's blocks first, then the shared pool
+    auto* cache = threadCache();
+    if (cache != nullptr) {
+      ptr = takeFrom(cache->blocks, size_class);
+    }
+    if (ptr == nullptr) {
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      ptr = takeFrom(pool.blocks, size_class);
+    }
+  }
+
+  if (ptr != nullptr) {
+    ++pool.hits;
+    pool.bytes_held -= size_class;
+  } else {
+    ++pool.misses;
+    ptr = systemAllocate(size_class);
+  }
+
+  const std::size_t in_use = (pool.bytes_in_use += size_class);
+  std::size_t peak = pool.peak_bytes_in_use;
+  while (in_use > peak and not pool.peak_bytes_in_use.compare_exchange_weak(peak, in_use)) {
+  }
+
+  return ptr;
+}
+
+void ArrayAllocator::deallocate(void* ptr, std::size_t bytes) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto& pool = sharedPool();
+  const std::size_t size_class = sizeClass(bytes);
+  pool.bytes_in_use -= size_class;
+
+  // Check that there's room to keep this block
+  const bool enabled = pool.enabled;
+  if (not enabled or (pool.bytes_held += size_class) > pool.max_bytes_held) {
+    if (enabled) {
+      pool.bytes_held -= size_class;
+    }
+    ++pool.discards;
+    systemFree(ptr);
+    return;
+  }
+
+  try {
+    auto* cache = threadCache();
+    if (cache != nullptr) {
+      auto& blocks = cache->blocks[size_class];
+      if (blocks.size() < thread_cache_blocks) {
+        blocks.push_back(ptr);
+        return;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.blocks[size_class].push_back(ptr);
+  } catch (...) {
+    // Couldn't make room in the free lists, so just give up the block
+    pool.bytes_held -= size_class;
+    ++pool.discards;
+    systemFree(ptr);
+  }
+}
+
+ArrayAllocator::Statistics ArrayAllocator::getStatistics() {
+  const auto& pool = sharedPool();
+
+  Statistics stats;
+  stats.hits = pool.hits;
+  stats.misses = pool.misses;
+  stats.discards = pool.discards;
+  stats.bytes_held = pool.bytes_held;
+  stats.bytes_in_use = pool.bytes_in_use;
+  stats.peak_bytes_in_use = pool.peak_bytes_in_use;
+  return stats;
+}
+
+void ArrayAllocator::resetStatistics() {
+  auto& pool = sharedPool();
+  pool.hits = 0;
+  pool.misses = 0;
+  pool.discards = 0;
+  pool.peak_bytes_in_use = pool.bytes_in_use.load();
+}
+
+void ArrayAllocator::setMaxBytesHeld(std::size_t max_bytes) {
+  sharedPool().max_bytes_held = max_bytes;
+}
+
+void ArrayAllocator::setUseHugePages(bool use_huge_pages) {
+  sharedPool().use_huge_pages = use_huge_pages;
+}
+
+bool ArrayAllocator::isEnabled() { return sharedPool().enabled; }
+
+void ArrayAllocator::cleanup() {
+  auto& pool = sharedPool();
+  pool.enabled = false;
+
+  auto* cache = threadCache();
+  if (cache != nullptr) {
+    freeAll(cache->blocks);
+  }
+
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  freeAll(pool.blocks);
+}
+
+} // namespace bout
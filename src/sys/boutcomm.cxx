@@ -1,11 +1,15 @@
 #include <boutcomm.hxx>
 #include <bout_types.hxx>
+#include <boutexception.hxx>
 
 BoutComm* BoutComm::instance = nullptr;
 
-BoutComm::BoutComm() : comm(MPI_COMM_NULL) {}
+BoutComm::BoutComm() : comm(MPI_COMM_NULL), time_comm(MPI_COMM_NULL) {}
 
 BoutComm::~BoutComm() {
+  if(time_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&time_comm);
+
   if(comm != MPI_COMM_NULL)
     MPI_Comm_free(&comm);
   
@@ -34,6 +38,42 @@ MPI_Comm BoutComm::getComm() {
   return comm;
 }
 
+void BoutComm::splitTime(int nslices) {
+  if (time_comm != MPI_COMM_NULL) {
+    throw BoutException("BoutComm: processors have already been split in time");
+  }
+
+  MPI_Comm all = getComm();
+  int rank, nproc;
+  MPI_Comm_rank(all, &rank);
+  MPI_Comm_size(all, &nproc);
+
+  if ((nslices < 1) or (nproc % nslices != 0)) {
+    throw BoutException("BoutComm: can't split %d processors into %d time slices",
+                        nproc, nslices);
+  }
+  const int nspace = nproc / nslices;
+
+  // Each group of neighbouring processors solves one time slice
+  MPI_Comm space;
+  MPI_Comm_split(all, rank / nspace, rank, &space);
+
+  // Processors in the same place in each group exchange the state
+  MPI_Comm_split(all, rank % nspace, rank, &time_comm);
+
+  MPI_Comm_free(&comm);
+  comm = space;
+}
+
+MPI_Comm BoutComm::getTimeComm() {
+  if(time_comm == MPI_COMM_NULL) {
+    // Not split, so make sure MPI is initialised
+    getComm();
+    return MPI_COMM_SELF;
+  }
+  return time_comm;
+}
+
 bool BoutComm::isSet() {
   return hasBeenSet;
 }
@@ -60,6 +100,22 @@ int BoutComm::size() {
   return NPES;
 }
 
+MPI_Comm BoutComm::getTime() {
+  return getInstance()->getTimeComm();
+}
+
+int BoutComm::timeRank() {
+  int rank;
+  MPI_Comm_rank(getTime(), &rank);
+  return rank;
+}
+
+int BoutComm::timeSize() {
+  int nslices;
+  MPI_Comm_size(getTime(), &nslices);
+  return nslices;
+}
+
 BoutComm* BoutComm::getInstance() {
   if(instance == nullptr) {
     // Create the singleton object
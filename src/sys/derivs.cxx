@@ -47,6 +47,7 @@
 #include <bout/constants.hxx>
 #include <msg_stack.hxx>
 
+#include <algorithm>
 #include <cmath>
 
 #include <output.hxx>
@@ -56,6 +57,61 @@
  * First central derivatives
  *******************************************************************************/
 
+namespace {
+/// Divide each of \p fields by \p metric in \p region. Each value
+/// of the metric is loaded once, and used for the Z-line of every
+/// field while that is still in cache
+void divideByMetric(std::vector<Field3D>& fields, const Field2D& metric,
+                    const std::string& region) {
+  if (fields.empty()) {
+    return;
+  }
+  std::vector<BoutReal*> data;
+  for (auto& f : fields) {
+    data.push_back(&f(0, 0, 0));
+  }
+  const BoutReal* metric_data = &metric(0, 0);
+  const int nz = fields.front().getNz();
+
+  BOUT_FOR_BLOCKS(first, last, fields.front().getRegion(region)) {
+    // Split the block into pieces in a single Z-line
+    for (int line_first = first; line_first < last;) {
+      const int line_last = std::min(last, (line_first / nz + 1) * nz);
+      const BoutReal inv_metric = 1.0 / metric_data[line_first / nz];
+      for (auto* f : data) {
+        BOUT_OMP(simd)
+        for (int i = line_first; i < line_last; ++i) {
+          f[i] *= inv_metric;
+        }
+      }
+      line_first = line_last;
+    }
+  }
+}
+
+/// Divide each of \p fields by the constant \p metric in \p region
+void divideByMetric(std::vector<Field3D>& fields, BoutReal metric,
+                    const std::string& region) {
+  if (fields.empty()) {
+    return;
+  }
+  std::vector<BoutReal*> data;
+  for (auto& f : fields) {
+    data.push_back(&f(0, 0, 0));
+  }
+  const BoutReal inv_metric = 1.0 / metric;
+
+  BOUT_FOR_BLOCKS(first, last, fields.front().getRegion(region)) {
+    for (auto* f : data) {
+      BOUT_OMP(simd)
+      for (int i = first; i < last; ++i) {
+        f[i] *= inv_metric;
+      }
+    }
+  }
+}
+} // namespace
+
 ////////////// X DERIVATIVE /////////////////
 
 Field3D DDX(const Field3D &f, CELL_LOC outloc, const std::string &method,
@@ -80,6 +136,26 @@ Field2D DDX(const Field2D &f, CELL_LOC outloc, const std::string &method,
   return f.getCoordinates(outloc)->DDX(f, outloc, method, region);
 }
 
+std::vector<Field3D> DDX(const std::vector<std::reference_wrapper<const Field3D>>& fs,
+    CELL_LOC outloc, const std::string& method, const std::string& region) {
+  auto result = bout::derivatives::index::DDX(fs, outloc, method, region);
+  if (result.empty()) {
+    return result;
+  }
+  Coordinates *coords = fs.front().get().getCoordinates(outloc);
+  divideByMetric(result, coords->dx, region);
+
+  if (fs.front().get().getMesh()->IncIntShear) {
+    // Using BOUT-06 style shifting
+    const auto ddz = DDZ(fs, outloc, method, region);
+    for (std::size_t k = 0; k < result.size(); ++k) {
+      result[k] += coords->IntShiftTorsion * ddz[k];
+    }
+  }
+
+  return result;
+}
+
 ////////////// Y DERIVATIVE /////////////////
 
 Field3D DDY(const Field3D &f, CELL_LOC outloc, const std::string &method,
@@ -93,6 +169,15 @@ Field2D DDY(const Field2D &f, CELL_LOC outloc, const std::string &method,
   return f.getCoordinates(outloc)->DDY(f, outloc, method, region);
 }
 
+std::vector<Field3D> DDY(const std::vector<std::reference_wrapper<const Field3D>>& fs,
+    CELL_LOC outloc, const std::string& method, const std::string& region) {
+  auto result = bout::derivatives::index::DDY(fs, outloc, method, region);
+  if (not result.empty()) {
+    divideByMetric(result, fs.front().get().getCoordinates(outloc)->dy, region);
+  }
+  return result;
+}
+
 ////////////// Z DERIVATIVE /////////////////
 
 Field3D DDZ(const Field3D &f, CELL_LOC outloc, const std::string &method,
@@ -108,6 +193,15 @@ Field2D DDZ(const Field2D &f, CELL_LOC UNUSED(outloc), const std::string
   return tmp;
 }
 
+std::vector<Field3D> DDZ(const std::vector<std::reference_wrapper<const Field3D>>& fs,
+    CELL_LOC outloc, const std::string& method, const std::string& region) {
+  auto result = bout::derivatives::index::DDZ(fs, outloc, method, region);
+  if (not result.empty()) {
+    divideByMetric(result, fs.front().get().getCoordinates(outloc)->dz, region);
+  }
+  return result;
+}
+
 Vector3D DDZ(const Vector3D &v, CELL_LOC outloc, const std::string &method,
     const std::string& region) {
   Vector3D result(v.x.getMesh());
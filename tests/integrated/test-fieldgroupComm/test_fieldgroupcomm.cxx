@@ -8,11 +8,14 @@ protected:
     solver->add(fld1,"fld1");
     solver->add(fld2,"fld2");
     solver->add(fld3,"fld3");
+    solver->add(fld4,"fld4");
 
     //Create different communicators
     comm1.add(fld1);
     comm2.add(fld2,fld2);
     comm3.add(fld3);
+    comm4.add(fld4);
+    plan4 = mesh->createCommunicationPlan(comm4);
 
     return 0;
   }
@@ -26,16 +29,20 @@ protected:
     //3. Twice with single entry
     mesh->communicate(comm3);
     mesh->communicate(comm3);
+    //4. Persistent communication plan
+    mesh->communicate(*plan4);
 
     ddt(fld1) = Grad_par(fld1);
     ddt(fld2) = Grad_par(fld2);
     ddt(fld3) = Grad_par(fld3);
+    ddt(fld4) = Grad_par(fld4);
     return 0;
   }
 
 private:
-  Field3D fld1, fld2, fld3;
-  FieldGroup comm1, comm2, comm3;
+  Field3D fld1, fld2, fld3, fld4;
+  FieldGroup comm1, comm2, comm3, comm4;
+  std::unique_ptr<CommunicationPlan> plan4;
 };
 
 BOUTMAIN(TestFieldGroupComm);
@@ -0,0 +1,143 @@
+#include "bout/physicsmodel.hxx"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Coupled fast and slow variables, with exact solution
+//   fast = sin(t), slow = cos(t)
+class TestMultirate : public PhysicsModel {
+public:
+  Field3D fast, slow;
+
+  /// Throw from the first call which doesn't need the slow derivatives
+  bool throw_when_fast{false};
+
+  int init(bool UNUSED(restarting)) override {
+    solver->add(fast, "fast");
+    solver->add(slow, "slow");
+    fast = 0.0;
+    slow = 1.0;
+    return 0;
+  }
+
+  int rhs(BoutReal UNUSED(time)) override {
+    ddt(fast) = slow;
+    if (solver->slowDerivsNeeded()) {
+      ddt(slow) = -fast;
+    } else if (throw_when_fast) {
+      throw BoutException("Fast step failed");
+    }
+    return 0;
+  }
+};
+
+int main(int argc, char** argv) {
+
+  // Expected order of accuracy, and how far the measured order can be
+  // below it
+  constexpr BoutReal expected_order = 2.0;
+  constexpr BoutReal order_tolerance = 0.1;
+
+  // Our own output to stdout, as main library will only be writing to log files
+  Output output_test;
+
+  auto& root = Options::root();
+
+  root["mesh"]["MXG"] = 1;
+  root["mesh"]["MYG"] = 1;
+  root["mesh"]["nx"] = 3;
+  root["mesh"]["ny"] = 1;
+  root["mesh"]["nz"] = 1;
+
+  root["output"]["enabled"] = false;
+  root["restart"]["enabled"] = false;
+
+  root["slow"]["slow"] = true;
+
+  constexpr BoutReal end = 1.0;
+  root["NOUT"] = 1;
+  root["TIMESTEP"] = end;
+
+  // Set the command-line arguments
+  Solver::setArgs(argc, argv);
+  BoutComm::setArgs(argc, argv);
+
+  // Turn off writing to stdout for the main library
+  Output::getInstance()->disable();
+
+  bout::globals::mesh = Mesh::create();
+  bout::globals::mesh->load();
+
+  bout::globals::dump =
+      bout::experimental::setupDumpFile(Options::root(), *bout::globals::mesh, ".");
+
+  int failures = 0;
+
+  // Error in both variables with a slow timestep of end / nsteps
+  std::vector<BoutReal> errors;
+  for (const int nsteps : {10, 20, 40, 80}) {
+    Options options;
+    options["timestep"] = end / nsteps;
+    options["substeps"] = 4;
+    auto solver = std::unique_ptr<Solver>{Solver::create("multirate", &options)};
+
+    TestMultirate model{};
+    solver->setModel(&model);
+
+    BoutMonitor bout_monitor{};
+    solver->addMonitor(&bout_monitor, Solver::BACK);
+
+    solver->solve();
+
+    errors.push_back(std::max(std::abs(model.fast(1, 1, 0) - std::sin(end)),
+                              std::abs(model.slow(1, 1, 0) - std::cos(end))));
+    output_test << "Slow timestep " << end / nsteps << ": error " << errors.back()
+                << "\n";
+  }
+
+  for (std::size_t i = 1; i < errors.size(); ++i) {
+    const BoutReal order = std::log2(errors[i - 1] / errors[i]);
+    output_test << "Order of accuracy: " << order;
+    if (order < expected_order - order_tolerance) {
+      output_test << " FAILED\n";
+      ++failures;
+    } else {
+      output_test << " PASSED\n";
+    }
+  }
+
+  // The slow derivatives are needed again after the RHS throws
+  {
+    Options options;
+    auto solver = std::unique_ptr<Solver>{Solver::create("multirate", &options)};
+
+    TestMultirate model{};
+    model.throw_when_fast = true;
+    solver->setModel(&model);
+
+    output_test << "Slow derivatives needed after the RHS throws:";
+    try {
+      solver->solve();
+      output_test << " FAILED (didn't throw)\n";
+      ++failures;
+    } catch (BoutException&) {
+      if (solver->slowDerivsNeeded()) {
+        output_test << " PASSED\n";
+      } else {
+        output_test << " FAILED\n";
+        ++failures;
+      }
+    }
+  }
+
+  BoutFinalise(false);
+
+  if (failures > 0) {
+    output_test << "\n => Some failed tests\n";
+  } else {
+    output_test << "\n => All tests passed\n";
+  }
+
+  return failures;
+}
@@ -0,0 +1,113 @@
+#include "bout/physicsmodel.hxx"
+
+#include <cmath>
+#include <memory>
+
+// Oscillates quickly, with exact solution exp(sin(30 t))
+class TestParareal : public PhysicsModel {
+public:
+  Field3D field;
+
+  int init(bool UNUSED(restarting)) override {
+    solver->add(field, "field");
+    field = 1.0;
+    return 0;
+  }
+
+  int rhs(BoutReal time) override {
+    ddt(field) = 30. * std::cos(30. * time) * field;
+    return 0;
+  }
+};
+
+/// Error at the end of a parareal run with \p max_iterations
+BoutReal runParareal(int max_iterations, BoutReal end) {
+  Options options;
+  options["fine_steps"] = 50;
+  options["max_iterations"] = max_iterations;
+  // Always take max_iterations
+  options["rtol"] = 0.0;
+  auto solver = std::unique_ptr<Solver>{Solver::create("parareal", &options)};
+
+  TestParareal model{};
+  solver->setModel(&model);
+
+  BoutMonitor bout_monitor{};
+  solver->addMonitor(&bout_monitor, Solver::BACK);
+
+  solver->solve();
+
+  return std::abs(model.field(1, 1, 0) - std::exp(std::sin(30. * end)));
+}
+
+int main(int argc, char** argv) {
+
+  // Absolute tolerance for the converged solution, which is the same
+  // as the fine integrator alone
+  constexpr BoutReal tolerance = 1.e-6;
+
+  // Our own output to stdout, as main library will only be writing to log files
+  Output output_test;
+
+  auto& root = Options::root();
+
+  root["mesh"]["MXG"] = 1;
+  root["mesh"]["MYG"] = 1;
+  root["mesh"]["nx"] = 3;
+  root["mesh"]["ny"] = 1;
+  root["mesh"]["nz"] = 1;
+
+  root["output"]["enabled"] = false;
+  root["restart"]["enabled"] = false;
+
+  constexpr int NOUT = 2;
+  constexpr BoutReal TIMESTEP = 0.1;
+  root["NOUT"] = NOUT;
+  root["TIMESTEP"] = TIMESTEP;
+
+  root["solver"]["type"] = "parareal";
+  root["solver"]["time_slices"] = 2;
+
+  // Set the command-line arguments
+  Solver::setArgs(argc, argv);
+  BoutComm::setArgs(argc, argv);
+
+  // Turn off writing to stdout for the main library
+  Output::getInstance()->disable();
+
+  bout::experimental::setupTimeSlices(root);
+
+  bout::globals::mesh = Mesh::create();
+  bout::globals::mesh->load();
+
+  bout::globals::dump =
+      bout::experimental::setupDumpFile(Options::root(), *bout::globals::mesh, ".");
+
+  int failures = 0;
+
+  // After one iteration the second slice starts from the coarse guess.
+  // After two it starts from the end of the fine solution of the
+  // first, passed between the time slices, and the first slice's fine
+  // solution isn't repeated
+  const BoutReal coarse_error = runParareal(1, NOUT * TIMESTEP);
+  const BoutReal fine_error = runParareal(2, NOUT * TIMESTEP);
+
+  output_test << "Time slice " << BoutComm::timeRank() << ": error after 1 iteration "
+              << coarse_error << ", after 2 iterations " << fine_error;
+  if ((fine_error > tolerance) or (coarse_error < 10 * fine_error)) {
+    output_test << " FAILED\n";
+    ++failures;
+  } else {
+    output_test << " PASSED\n";
+  }
+
+  BoutFinalise(false);
+
+  if (failures > 0) {
+    output_test << "\n => Some failed tests\n";
+  } else {
+    output_test << "\n => All tests passed\n";
+  }
+
+  return failures;
+}
@@ -0,0 +1,270 @@
+// Test the native binary data format
+
+#include "gtest/gtest.h"
+
+#include "bout/mesh.hxx"
+#include "boutexception.hxx"
+#include "datafile.hxx"
+#include "dataformat.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "options.hxx"
+#include "test_extras.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class BinFormatTest : public FakeMeshFixture {
+public:
+  BinFormatTest() : FakeMeshFixture() {}
+  ~BinFormatTest() override {
+    for (const auto& name : filenames) {
+      std::remove(name.c_str());
+    }
+  }
+
+  /// Get a temporary filename
+  std::string newFilename() {
+    filenames.push_back(std::string(std::tmpnam(nullptr)) + ".bin");
+    return filenames.back();
+  }
+
+  /// Write an int, a BoutReal and a Field3D to a new file
+  std::string writeFile() {
+    const auto filename = newFilename();
+
+    auto file = data_format(filename.c_str());
+    EXPECT_TRUE(file->openw(filename));
+    EXPECT_TRUE(file->addVarInt("i", false));
+    EXPECT_TRUE(file->addVarBoutReal("r", false));
+    EXPECT_TRUE(file->addVarField3D("f", false));
+
+    int i = 42;
+    BoutReal r = 3.5;
+    EXPECT_TRUE(file->write(&i, "i"));
+    EXPECT_TRUE(file->write(&r, "r"));
+    auto f = makeField<Field3D>([](Ind3D& ind) { return ind.ind; });
+    EXPECT_TRUE(file->write(&f(0, 0, 0), "f", nx, ny, nz));
+    file->setAttribute("f", "units", "m");
+    file->setAttribute("", "iteration", 3);
+    file->close();
+
+    return filename;
+  }
+
+  /// Change the byte \p offset bytes from the end of \p filename
+  void corrupt(const std::string& filename, long offset) {
+    std::fstream file{filename, std::ios::in | std::ios::out | std::ios::binary};
+    file.seekg(-offset, std::ios::end);
+    const char byte = static_cast<char>(file.get() ^ 0x1);
+    file.seekp(-offset, std::ios::end);
+    file.put(byte);
+  }
+
+  /// Bytes from the end of the file to somewhere in the data of the
+  /// last variable, which is before the index
+  static constexpr long data_offset = 1000;
+
+protected:
+  /// Removed at the end of the test
+  std::vector<std::string> filenames;
+};
+
+constexpr long BinFormatTest::data_offset;
+
+TEST_F(BinFormatTest, WriteRead) {
+  const auto filename = writeFile();
+
+  auto file = data_format(filename.c_str());
+  ASSERT_TRUE(file->openr(filename));
+
+  EXPECT_EQ(file->getSize("i"), std::vector<int>{1});
+  EXPECT_EQ(file->getSize("f"), (std::vector<int>{nx, ny, nz}));
+  EXPECT_TRUE(file->getSize("missing").empty());
+
+  int i = 0;
+  BoutReal r = 0.0;
+  EXPECT_TRUE(file->read(&i, "i"));
+  EXPECT_TRUE(file->read(&r, "r"));
+  EXPECT_EQ(i, 42);
+  EXPECT_EQ(r, 3.5);
+
+  Field3D f{0.0};
+  EXPECT_TRUE(file->read(&f(0, 0, 0), "f", nx, ny, nz));
+  EXPECT_TRUE(IsFieldEqual(f, makeField<Field3D>([](Ind3D& ind) { return ind.ind; })));
+
+  std::string units;
+  int iteration = 0;
+  EXPECT_TRUE(file->getAttribute("f", "units", units));
+  EXPECT_TRUE(file->getAttribute("", "iteration", iteration));
+  EXPECT_EQ(units, "m");
+  EXPECT_EQ(iteration, 3);
+
+  EXPECT_FALSE(file->read(&i, "missing"));
+}
+
+TEST_F(BinFormatTest, ReadPart) {
+  const auto filename = writeFile();
+
+  auto file = data_format(filename.c_str());
+  ASSERT_TRUE(file->openr(filename));
+
+  // A single Z-line, and an int read as a BoutReal
+  std::vector<BoutReal> line(nz);
+  file->setGlobalOrigin(1, 2, 0);
+  EXPECT_TRUE(file->read(line.data(), "f", 1, 1, nz));
+  for (int k = 0; k < nz; ++k) {
+    EXPECT_EQ(line[k], (1 * ny + 2) * nz + k);
+  }
+
+  file->setGlobalOrigin(0, 0, 0);
+  BoutReal i = 0.0;
+  EXPECT_TRUE(file->read(&i, "i"));
+  EXPECT_EQ(i, 42.0);
+
+  // Outside the variable
+  file->setGlobalOrigin(nx, 0, 0);
+  EXPECT_FALSE(file->read(line.data(), "f", 1, 1, nz));
+}
+
+TEST_F(BinFormatTest, Datafile) {
+  const auto filename = newFilename();
+  // Datafile adds the processor number
+  const auto written = filename.substr(0, filename.size() - 4) + ".0.bin";
+  filenames.push_back(written);
+
+  Options options;
+  int i = 7;
+  BoutReal r = 0.25;
+  auto f2d = makeField<Field2D>([](Ind2D& ind) { return 2. * ind.ind; });
+  auto f3d = makeField<Field3D>([](Ind3D& ind) { return -ind.ind; });
+  {
+    Datafile datafile{&options, mesh};
+    datafile.addOnce(i, "i");
+    datafile.addOnce(r, "r");
+    datafile.addOnce(f2d, "f2d");
+    datafile.addOnce(f3d, "f3d");
+    ASSERT_TRUE(datafile.openw("%s", filename.c_str()));
+    EXPECT_TRUE(datafile.write());
+    datafile.close();
+  }
+
+  int i_in = 0;
+  BoutReal r_in = 0.0;
+  Field2D f2d_in{0.0};
+  Field3D f3d_in{0.0};
+  Datafile datafile{&options, mesh};
+  datafile.addOnce(i_in, "i");
+  datafile.addOnce(r_in, "r");
+  datafile.addOnce(f2d_in, "f2d");
+  datafile.addOnce(f3d_in, "f3d");
+  ASSERT_TRUE(datafile.openr("%s", filename.c_str()));
+  EXPECT_TRUE(datafile.read());
+  datafile.close();
+
+  EXPECT_EQ(i_in, i);
+  EXPECT_EQ(r_in, r);
+  EXPECT_TRUE(IsFieldEqual(f2d_in, f2d));
+  EXPECT_TRUE(IsFieldEqual(f3d_in, f3d));
+}
+
+TEST_F(BinFormatTest, Append) {
+  const auto filename = writeFile();
+
+  // Only change one variable
+  auto file = data_format(filename.c_str());
+  ASSERT_TRUE(file->openw(filename, true));
+  BoutReal r = -1.0;
+  EXPECT_TRUE(file->write(&r, "r"));
+  file->close();
+
+  ASSERT_TRUE(file->openr(filename));
+  int i = 0;
+  r = 0.0;
+  EXPECT_TRUE(file->read(&i, "i"));
+  EXPECT_TRUE(file->read(&r, "r"));
+  EXPECT_EQ(i, 42);
+  EXPECT_EQ(r, -1.0);
+
+  Field3D f{0.0};
+  EXPECT_TRUE(file->read(&f(0, 0, 0), "f", nx, ny, nz));
+  EXPECT_TRUE(IsFieldEqual(f, makeField<Field3D>([](Ind3D& ind) { return ind.ind; })));
+
+  std::string units;
+  EXPECT_TRUE(file->getAttribute("f", "units", units));
+  EXPECT_EQ(units, "m");
+}
+
+TEST_F(BinFormatTest, NoRecords) {
+  const auto filename = newFilename();
+  auto file = data_format(filename.c_str());
+  ASSERT_TRUE(file->openw(filename));
+  EXPECT_FALSE(file->addVarBoutReal("t", true));
+  BoutReal t = 1.0;
+  EXPECT_FALSE(file->write_rec(&t, "t"));
+}
+
+TEST_F(BinFormatTest, WrongShape) {
+  const auto filename = newFilename();
+  auto file = data_format(filename.c_str());
+  ASSERT_TRUE(file->openw(filename));
+  EXPECT_TRUE(file->addVarField3D("f", false));
+  EXPECT_TRUE(file->addVarField3D("f", false));
+  EXPECT_FALSE(file->addVarField2D("f", false));
+
+  std::vector<BoutReal> data((nx + 1) * ny * nz);
+  EXPECT_FALSE(file->write(data.data(), "f", nx + 1, ny, nz));
+}
+
+TEST_F(BinFormatTest, MissingFile) {
+  const auto filename = newFilename();
+  auto file = data_format(filename.c_str());
+  EXPECT_FALSE(file->openr(filename));
+  EXPECT_FALSE(file->is_valid());
+}
+
+TEST_F(BinFormatTest, CorruptedData) {
+  const auto filename = writeFile();
+  corrupt(filename, data_offset);
+
+  // The variables are only checked when they are read
+  auto file = data_format(filename.c_str());
+  ASSERT_TRUE(file->openr(filename));
+
+  int i = 0;
+  EXPECT_TRUE(file->read(&i, "i"));
+  Field3D f{0.0};
+  EXPECT_THROW(file->read(&f(0, 0, 0), "f", nx, ny, nz), BoutException);
+}
+
+TEST_F(BinFormatTest, CorruptedIndex) {
+  const auto filename = writeFile();
+  corrupt(filename, 1);
+
+  auto file = data_format(filename.c_str());
+  EXPECT_THROW(file->openr(filename), BoutException);
+}
+
+TEST_F(BinFormatTest, NotBinary) {
+  const auto filename = newFilename();
+  {
+    std::ofstream file{filename};
+    file << "This is not a binary file, but it is quite long so that it has room "
+            "for a header\n";
+  }
+
+  auto file = data_format(filename.c_str());
+  EXPECT_THROW(file->openr(filename), BoutException);
+}
@@ -0,0 +1,274 @@
+// Test writing output with Datafile
+
+#if defined(NCDF4) || defined(NCDF) || defined(HDF5)
+
+#include "gtest/gtest.h"
+
+#include "bout/mesh.hxx"
+#include "boutexception.hxx"
+#include "datafile.hxx"
+#include "dataformat.hxx"
+#include "field3d.hxx"
+#include "options.hxx"
+#include "test_extras.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class DatafileTest : public FakeMeshFixture {
+public:
+  DatafileTest() : FakeMeshFixture() {}
+  ~DatafileTest() override {
+    for (const auto& name : filenames) {
+      std::remove((name + ".0" + extension).c_str());
+    }
+  }
+
+#if defined(NCDF4) || defined(NCDF)
+  const std::string extension{".nc"};
+#else
+  const std::string extension{".h5"};
+#endif
+
+  /// Get a temporary filename, to which Datafile adds the processor
+  /// number
+  std::string newFilename() {
+    filenames.push_back(std::tmpnam(nullptr));
+    return filenames.back() + extension;
+  }
+
+  /// Write \p nout records of an int, a BoutReal and a Field3D to a
+  /// new file, using \p options. The Field3D depends on the record
+  std::string writeRecords(Options& options, int nout) {
+    const auto filename = newFilename();
+
+    int iteration = 0;
+    BoutReal time = 0.0;
+    Field3D f{0.0};
+
+    Datafile datafile{&options, mesh};
+    datafile.addRepeat(iteration, "iteration");
+    datafile.addRepeat(time, "time");
+    datafile.addRepeat(f, "f");
+    datafile.openw("%s", filename.c_str());
+
+    for (iteration = 0; iteration < nout; ++iteration) {
+      time = 0.5 * iteration;
+      f = makeField<Field3D>([&](Ind3D& i) { return i.ind + 1000. * iteration; });
+      EXPECT_TRUE(datafile.write());
+    }
+    // Changing the variables must not affect what has been written
+    f = -1.0;
+    datafile.close();
+
+    return filename;
+  }
+
+  /// Check that each record of the Field3D in the file written by
+  /// writeRecords has the expected values, to within a relative
+  /// tolerance \p rtol
+  void checkRecords(const std::string& filename, int nout, BoutReal rtol = 0.0) {
+    auto file = data_format(filename.c_str());
+    file->setGlobalOrigin(0, 0, 0);
+    ASSERT_TRUE(file->openr(filename, 0));
+
+    std::vector<BoutReal> f(nx * ny * nz);
+    for (int t = 0; t < nout; ++t) {
+      file->setRecord(t);
+      EXPECT_TRUE(file->read_rec(f.data(), "f", nx, ny, nz));
+      for (int i = 0; i < nx * ny * nz; ++i) {
+        const BoutReal expected = i + 1000. * t;
+        if (rtol > 0.0) {
+          EXPECT_NEAR(f[i], expected, rtol * std::abs(expected));
+        } else {
+          EXPECT_DOUBLE_EQ(f[i], expected);
+        }
+      }
+    }
+    file->close();
+  }
+
+private:
+  std::vector<std::string> filenames;
+};
+
+TEST_F(DatafileTest, WriteSync) {
+  Options options;
+  options["async"] = false;
+
+  checkRecords(writeRecords(options, 3), 3);
+}
+
+TEST_F(DatafileTest, WriteAsync) {
+  Options options;
+  options["async"] = true;
+
+  checkRecords(writeRecords(options, 4), 4);
+}
+
+TEST_F(DatafileTest, WriteAsyncKeepOpen) {
+  Options options;
+  options["async"] = true;
+  options["openclose"] = false;
+
+  checkRecords(writeRecords(options, 4), 4);
+}
+
+TEST_F(DatafileTest, WriteKeepOpen) {
+  Options options;
+  options["openclose"] = false;
+  options["flushFrequency"] = 2;
+
+  checkRecords(writeRecords(options, 5), 5);
+}
+
+TEST_F(DatafileTest, WriteReopenEvery) {
+  Options options;
+  options["flushFrequency"] = 2;
+
+  checkRecords(writeRecords(options, 5), 5);
+}
+
+TEST_F(DatafileTest, WriteAsyncKeepOpenFlush) {
+  Options options;
+  options["async"] = true;
+  options["openclose"] = false;
+  options["flushFrequency"] = 3;
+
+  checkRecords(writeRecords(options, 4), 4);
+}
+
+TEST_F(DatafileTest, WriteVar) {
+  for (const bool openclose : {true, false}) {
+    Options options;
+    options["openclose"] = openclose;
+    const auto filename = newFilename();
+
+    int marker = -1;
+    BoutReal time = 1.5;
+
+    Datafile datafile{&options, mesh};
+    datafile.addOnce(marker, "marker");
+    datafile.addOnce(time, "time");
+    datafile.openw("%s", filename.c_str());
+    EXPECT_TRUE(datafile.write());
+
+    // Only the marker is written
+    marker = 4;
+    time = 2.5;
+    EXPECT_TRUE(datafile.writeVar("marker"));
+    EXPECT_THROW(datafile.writeVar("missing"), BoutException);
+    datafile.close();
+
+    auto file = data_format(filename.c_str());
+    ASSERT_TRUE(file->openr(filename, 0));
+    int read_marker = 0;
+    BoutReal read_time = 0.0;
+    EXPECT_TRUE(file->read(&read_marker, "marker"));
+    EXPECT_TRUE(file->read(&read_time, "time"));
+    EXPECT_EQ(read_marker, 4);
+    EXPECT_EQ(read_time, 1.5);
+    file->close();
+  }
+}
+
+TEST_F(DatafileTest, WriteShifted) {
+  // The identity transform leaves the values unchanged
+  Options options;
+  options["shiftoutput"] = true;
+
+  checkRecords(writeRecords(options, 2), 2);
+}
+
+TEST_F(DatafileTest, WriteAsyncShifted) {
+  Options options;
+  options["async"] = true;
+  options["shiftoutput"] = true;
+
+  checkRecords(writeRecords(options, 3), 3);
+}
+
+TEST_F(DatafileTest, WriteCompressed) {
+  Options options;
+  options["deflate"] = 4;
+  options["chunk_records"] = 2;
+
+  checkRecords(writeRecords(options, 3), 3);
+}
+
+TEST_F(DatafileTest, WriteFloats) {
+  Options options;
+  options["floats"] = true;
+
+  checkRecords(writeRecords(options, 2), 2, 1e-7);
+}
+
+TEST_F(DatafileTest, WriteFloatsRounded) {
+  Options options;
+  options["floats"] = true;
+  options["significant_digits"] = 3;
+  options["deflate"] = 1;
+
+  checkRecords(writeRecords(options, 2), 2, 1e-3);
+}
+
+TEST_F(DatafileTest, WriteFloatsUnchanged) {
+  // Converting to floats must not change the field being written
+  Options options;
+  options["floats"] = true;
+
+  Field3D f{1e30};
+  Datafile datafile{&options, mesh};
+  datafile.addRepeat(f, "f");
+  datafile.openw("%s", newFilename().c_str());
+  EXPECT_TRUE(datafile.write());
+  datafile.close();
+
+  EXPECT_TRUE(IsFieldEqual(f, 1e30));
+}
+
+TEST_F(DatafileTest, BadStorageSettings) {
+  Options options;
+  options["deflate"] = 10;
+  EXPECT_THROW(Datafile(&options, mesh), BoutException);
+
+  Options options_digits;
+  options_digits["significant_digits"] = -1;
+  EXPECT_THROW(Datafile(&options_digits, mesh), BoutException);
+
+  Options options_flush;
+  options_flush["flushFrequency"] = 0;
+  EXPECT_THROW(Datafile(&options_flush, mesh), BoutException);
+}
+
+TEST_F(DatafileTest, AsyncParallel) {
+  Options options;
+  options["async"] = true;
+  options["parallel"] = true;
+
+  EXPECT_THROW(Datafile(&options, mesh), BoutException);
+}
+
+#ifndef PHDF5
+TEST_F(DatafileTest, ParallelNotAvailable) {
+  Options options;
+  options["parallel"] = true;
+
+  Datafile datafile{&options, mesh};
+  EXPECT_THROW(datafile.openw("%s", newFilename().c_str()), BoutException);
+}
+#endif
+
+#endif // NCDF4 || NCDF || HDF5
@@ -0,0 +1,56 @@
+// Test the choice of chunk shapes by DataFormat
+
+#if defined(NCDF4) || defined(NCDF) || defined(HDF5)
+
+#include "gtest/gtest.h"
+
+#include "dataformat.hxx"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class DataFormatChunkTest : public ::testing::Test {
+public:
+#if defined(NCDF4) || defined(NCDF)
+  std::unique_ptr<DataFormat> format{data_format("test.nc")};
+#else
+  std::unique_ptr<DataFormat> format{data_format("test.h5")};
+#endif
+
+  using Shape = std::vector<std::size_t>;
+};
+
+TEST_F(DataFormatChunkTest, NotRepeated) {
+  EXPECT_EQ(format->chunkShape({10, 20, 30}, false, 8), (Shape{10, 20, 30}));
+}
+
+TEST_F(DataFormatChunkTest, RecordsFillChunk) {
+  // 48000 bytes per record, so 21 fit in 1 MiB
+  EXPECT_EQ(format->chunkShape({0, 10, 20, 30}, true, 8), (Shape{21, 10, 20, 30}));
+}
+
+TEST_F(DataFormatChunkTest, ScalarTimeSeries) {
+  EXPECT_EQ(format->chunkShape({0}, true, 8), (Shape{128}));
+}
+
+TEST_F(DataFormatChunkTest, LargeRecordSplitInX) {
+  // 8 MiB per record is split in X until it fits in 1 MiB
+  EXPECT_EQ(format->chunkShape({0, 128, 128, 64}, true, 8), (Shape{1, 16, 128, 64}));
+}
+
+TEST_F(DataFormatChunkTest, ZLinesKeptWhole) {
+  EXPECT_EQ(format->chunkShape({0, 1, 1, 200000}, true, 8), (Shape{1, 1, 1, 200000}));
+}
+
+TEST_F(DataFormatChunkTest, Settings) {
+  DataFormat::StorageSettings settings;
+  settings.chunk_records = 5;
+  settings.chunk_bytes = 1000;
+  format->setStorageSettings(settings);
+
+  // 8000 bytes per record, so X is halved until the record fits
+  EXPECT_EQ(format->chunkShape({0, 10, 20, 5}, true, 8), (Shape{5, 1, 20, 5}));
+}
+
+#endif // NCDF4 || NCDF || HDF5
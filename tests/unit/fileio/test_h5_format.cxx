@@ -0,0 +1,100 @@
+// Test the HDF5 data format
+
+#ifdef HDF5
+
+#include "gtest/gtest.h"
+
+#include "../src/fileio/impls/hdf5/h5_format.hxx"
+#include "bout/mesh.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "fieldperp.hxx"
+#include "test_extras.hxx"
+
+#include <cstdio>
+#include <string>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class H5FormatTest : public FakeMeshFixture {
+public:
+  H5FormatTest() : FakeMeshFixture() {}
+  ~H5FormatTest() override { std::remove(filename.c_str()); }
+
+  // A temporary filename
+  std::string filename{std::string(std::tmpnam(nullptr)) + ".h5"};
+  WithQuietOutput quiet{output_info};
+};
+
+TEST_F(H5FormatTest, ReadWithoutGuardCells) {
+  // The interior sizes, as used by Datafile for parallel files
+  const int lx = mesh->LocalNx - 2 * mesh->xstart;
+  const int ly = mesh->LocalNy - 2 * mesh->ystart;
+  const int lz = mesh->LocalNz;
+
+  auto field3d = makeField<Field3D>([](Ind3D& i) { return i.ind; });
+  auto field2d = makeField<Field2D>([](Ind2D& i) { return i.ind; });
+  FieldPerp fieldperp{mesh};
+  fieldperp.allocate();
+  for (int x = 0; x < mesh->LocalNx; ++x) {
+    for (int z = 0; z < mesh->LocalNz; ++z) {
+      fieldperp(x, z) = x * mesh->LocalNz + z;
+    }
+  }
+
+  {
+    H5Format file{false, mesh};
+    ASSERT_TRUE(file.openw(filename.c_str()));
+    ASSERT_TRUE(file.addVarField3D("f3d", false));
+    ASSERT_TRUE(file.addVarField2D("f2d", false));
+    ASSERT_TRUE(file.addVarFieldPerp("fperp", false));
+
+    ASSERT_TRUE(file.setLocalOrigin(0, 0, 0, mesh->xstart, mesh->ystart, 0));
+    EXPECT_TRUE(file.write(&field3d(0, 0, 0), "f3d", lx, ly, lz));
+    EXPECT_TRUE(file.write(&field2d(0, 0), "f2d", lx, ly, 0));
+    EXPECT_TRUE(file.write_perp(&fieldperp(0, 0), "fperp", lx, lz));
+    file.close();
+  }
+
+  // The guard cells aren't read, so keep their values
+  constexpr BoutReal guard = -1.0;
+  Field3D result3d{guard};
+  Field2D result2d{guard};
+  FieldPerp resultperp{mesh};
+  resultperp = guard;
+
+  H5Format file{false, mesh};
+  ASSERT_TRUE(file.openr(filename.c_str()));
+  ASSERT_TRUE(file.setLocalOrigin(0, 0, 0, mesh->xstart, mesh->ystart, 0));
+  EXPECT_TRUE(file.read(&result3d(0, 0, 0), "f3d", lx, ly, lz));
+  EXPECT_TRUE(file.read(&result2d(0, 0), "f2d", lx, ly, 0));
+  EXPECT_TRUE(file.read_perp(&resultperp(0, 0), "fperp", lx, lz));
+  file.close();
+
+  const auto interior = [](int x, int y) {
+    return x >= mesh->xstart and x <= mesh->xend and y >= mesh->ystart
+           and y <= mesh->yend;
+  };
+  for (int x = 0; x < mesh->LocalNx; ++x) {
+    for (int y = 0; y < mesh->LocalNy; ++y) {
+      EXPECT_EQ(result2d(x, y), interior(x, y) ? field2d(x, y) : guard);
+      for (int z = 0; z < mesh->LocalNz; ++z) {
+        EXPECT_EQ(result3d(x, y, z), interior(x, y) ? field3d(x, y, z) : guard);
+      }
+    }
+    for (int z = 0; z < mesh->LocalNz; ++z) {
+      EXPECT_EQ(resultperp(x, z),
+                interior(x, mesh->ystart) ? fieldperp(x, z) : guard);
+    }
+  }
+}
+
+#endif // HDF5
@@ -0,0 +1,86 @@
+// Test the NetCDF-4 data format
+
+#ifdef NCDF4
+
+#include "gtest/gtest.h"
+
+#include "../src/fileio/impls/netcdf4/ncxx4.hxx"
+#include "bout/mesh.hxx"
+#include "field2d.hxx"
+#include "test_extras.hxx"
+
+#include <cstdio>
+#include <string>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class Ncxx4Test : public FakeMeshFixture {
+public:
+  Ncxx4Test() : FakeMeshFixture() {}
+  ~Ncxx4Test() override { std::remove(filename.c_str()); }
+
+  // A temporary filename
+  std::string filename{std::string(std::tmpnam(nullptr)) + ".nc"};
+  WithQuietOutput quiet{output_info};
+};
+
+TEST_F(Ncxx4Test, WriteLowPrecision) {
+  // Small integers, so that they are exact as floats
+  const BoutReal scalar = 3.0;
+  const auto field = makeField<Field2D>([](Ind2D& i) { return 1.0 + i.ind; });
+
+  {
+    Ncxx4 file{mesh};
+    file.setLowPrecision();
+    ASSERT_TRUE(file.openw(filename.c_str()));
+
+    ASSERT_TRUE(file.addVarBoutReal("scalar", false));
+    ASSERT_TRUE(file.addVarField2D("field", false));
+    ASSERT_TRUE(file.addVarBoutReal("scalar_t", true));
+    ASSERT_TRUE(file.addVarField2D("field_t", true));
+
+    // Datafile writes scalars with all lengths zero, and Field2Ds with lz = 0
+    BoutReal value = scalar;
+    Field2D values = field;
+    EXPECT_TRUE(file.write(&value, "scalar", 0, 0, 0));
+    EXPECT_TRUE(file.write(&values(0, 0), "field", nx, ny, 0));
+    EXPECT_TRUE(file.write_rec(&value, "scalar_t", 0, 0, 0));
+    EXPECT_TRUE(file.write_rec(&values(0, 0), "field_t", nx, ny, 0));
+    file.close();
+
+    // Not changed by the conversion
+    EXPECT_EQ(value, scalar);
+    EXPECT_TRUE(IsFieldEqual(values, field));
+  }
+
+  Ncxx4 file{mesh};
+  ASSERT_TRUE(file.openr(filename.c_str()));
+
+  BoutReal value = 0.0;
+  EXPECT_TRUE(file.read(&value, "scalar"));
+  EXPECT_EQ(value, scalar);
+
+  value = 0.0;
+  EXPECT_TRUE(file.read_rec(&value, "scalar_t"));
+  EXPECT_EQ(value, scalar);
+
+  Field2D result{0.0};
+  EXPECT_TRUE(file.read(&result(0, 0), "field", nx, ny));
+  EXPECT_TRUE(IsFieldEqual(result, field));
+
+  result = 0.0;
+  EXPECT_TRUE(file.read_rec(&result(0, 0), "field_t", nx, ny));
+  EXPECT_TRUE(IsFieldEqual(result, field));
+
+  file.close();
+}
+
+#endif // NCDF4
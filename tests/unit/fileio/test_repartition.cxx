@@ -0,0 +1,195 @@
+// Test reading files written with a different processor layout
+
+#include "gtest/gtest.h"
+
+#include "bout/mesh.hxx"
+#include "boutexception.hxx"
+#include "datafile.hxx"
+#include "dataformat.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "fieldperp.hxx"
+#include "options.hxx"
+#include "test_extras.hxx"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class RepartitionTest : public FakeMeshFixture {
+public:
+  RepartitionTest() : FakeMeshFixture() {
+    // Binary files are always available
+    base = std::string(std::tmpnam(nullptr)) + ".bin";
+  }
+  ~RepartitionTest() override {
+    for (int proc = 0; proc < nfiles; ++proc) {
+      std::remove(filename(proc).c_str());
+    }
+  }
+
+  std::string base;
+
+  /// The file written by processor \p proc
+  std::string filename(int proc) const {
+    return base.substr(0, base.size() - 4) + "." + std::to_string(proc) + ".bin";
+  }
+
+  /// The values of the variables, by global index including guard cells
+  static BoutReal value3D(int x, int y, int z) { return 100. * x + 10. * y + z; }
+  static BoutReal value2D(int x, int y) { return -10. * x - y; }
+
+  /// Write files as if from \p nype processors in Y, each with
+  /// \p mysub points and one guard cell. Points each processor
+  /// didn't evolve are set to -1, so they mustn't be read
+  void writeFiles(int nype, int mysub, bool layout = true) {
+    nfiles = nype;
+    const int local_ny = mysub + 2;
+    for (int py = 0; py < nype; ++py) {
+      auto file = data_format(base.c_str());
+      ASSERT_TRUE(file->openw(base, py));
+
+      if (layout) {
+        int one = 1, nxpe = 1, mxsub = nx - 2;
+        int nx_global = nx, ny_global = nype * mysub, nz_global = nz;
+        file->write(&nxpe, "NXPE");
+        file->write(&nype, "NYPE");
+        file->write(&mxsub, "MXSUB");
+        file->write(&mysub, "MYSUB");
+        file->write(&one, "MXG");
+        file->write(&one, "MYG");
+        file->write(&nx_global, "nx");
+        file->write(&ny_global, "ny");
+        file->write(&nz_global, "nz");
+      }
+
+      BoutReal t = 2.5;
+      file->write(&t, "t");
+
+      const int first = (py == 0) ? 0 : py * mysub + 1;
+      const int last = (py == nype - 1) ? (py + 1) * mysub + 2 : (py + 1) * mysub + 1;
+
+      std::vector<BoutReal> f3d(nx * local_ny * nz), f2d(nx * local_ny);
+      for (int x = 0; x < nx; ++x) {
+        for (int j = 0; j < local_ny; ++j) {
+          const int y = py * mysub + j;
+          const bool owned = (y >= first) and (y < last);
+          f2d[x * local_ny + j] = owned ? value2D(x, y) : -1.0;
+          for (int z = 0; z < nz; ++z) {
+            f3d[(x * local_ny + j) * nz + z] = owned ? value3D(x, y, z) : -1.0;
+          }
+        }
+      }
+      file->write(f3d.data(), "f3d", nx, local_ny, nz);
+      file->write(f2d.data(), "f2d", nx, local_ny);
+
+      std::vector<BoutReal> fperp(nx * nz, 1.0);
+      file->write_perp(fperp.data(), "fperp", nx, nz);
+      file->close();
+    }
+  }
+
+  /// Read the variables with a Datafile, and check they have the
+  /// global values
+  void readAndCheck() {
+    BoutReal t = 0.0;
+    Field3D f3d{0.0};
+    Field2D f2d{0.0};
+
+    Options options;
+    Datafile datafile{&options, mesh};
+    datafile.setRepartition();
+    datafile.addOnce(t, "t");
+    datafile.addOnce(f3d, "f3d");
+    datafile.addOnce(f2d, "f2d");
+    ASSERT_TRUE(datafile.openr("%s", base.c_str()));
+    ASSERT_TRUE(datafile.read());
+    datafile.close();
+
+    EXPECT_EQ(t, 2.5);
+    EXPECT_TRUE(IsFieldEqual(f3d, makeField<Field3D>([](Ind3D& i) {
+                  return value3D(i.x(), i.y(), i.z());
+                })));
+    EXPECT_TRUE(IsFieldEqual(
+        f2d, makeField<Field2D>([](Ind2D& i) { return value2D(i.x(), i.y()); })));
+  }
+
+private:
+  int nfiles{0};
+};
+
+TEST_F(RepartitionTest, SameLayout) {
+  writeFiles(1, ny - 2);
+  readAndCheck();
+}
+
+TEST_F(RepartitionTest, FromMoreProcessors) {
+  writeFiles(ny - 2, 1);
+  readAndCheck();
+}
+
+TEST_F(RepartitionTest, NoLayout) {
+  writeFiles(1, ny - 2, false);
+  readAndCheck();
+}
+
+TEST_F(RepartitionTest, DifferentGrid) {
+  writeFiles(2, 2);
+
+  Field3D f3d{0.0};
+  Options options;
+  Datafile datafile{&options, mesh};
+  datafile.setRepartition();
+  datafile.addOnce(f3d, "f3d");
+  ASSERT_TRUE(datafile.openr("%s", base.c_str()));
+  EXPECT_THROW(datafile.read(), BoutException);
+}
+
+TEST_F(RepartitionTest, MissingFiles) {
+  Field3D f3d{0.0};
+  Options options;
+  Datafile datafile{&options, mesh};
+  datafile.setRepartition();
+  datafile.addOnce(f3d, "f3d");
+  ASSERT_TRUE(datafile.openr("%s", base.c_str()));
+  EXPECT_THROW(datafile.read(), BoutException);
+}
+
+TEST_F(RepartitionTest, FieldPerp) {
+  writeFiles(1, ny - 2);
+
+  FieldPerp fperp{mesh};
+  fperp = 0.0;
+  fperp.setIndex(1);
+  Options options;
+  Datafile datafile{&options, mesh};
+  datafile.setRepartition();
+  datafile.addOnce(fperp, "fperp");
+  ASSERT_TRUE(datafile.openr("%s", base.c_str()));
+  EXPECT_TRUE(datafile.read());
+  EXPECT_TRUE(IsFieldEqual(fperp, 1.0));
+}
+
+TEST_F(RepartitionTest, FieldPerpFromMoreProcessors) {
+  writeFiles(ny - 2, 1);
+
+  FieldPerp fperp{mesh};
+  fperp = 0.0;
+  fperp.setIndex(1);
+  Options options;
+  Datafile datafile{&options, mesh};
+  datafile.setRepartition();
+  datafile.addOnce(fperp, "fperp");
+  ASSERT_TRUE(datafile.openr("%s", base.c_str()));
+  EXPECT_THROW(datafile.read(), BoutException);
+}
@@ -11,6 +11,7 @@
 using FieldType = std::vector<BoutReal>;
 
 using standardType = DerivativeStore<FieldType>::standardFunc;
+using standardManyType = DerivativeStore<FieldType>::standardManyFunc;
 using flowType = DerivativeStore<FieldType>::upwindFunc;
 
 void standardReturnTenSetToOne(const FieldType& UNUSED(inp), FieldType& out,
@@ -286,6 +287,73 @@ TEST_F(DerivativeStoreTest, RegisterFlowAndGetBack) {
   EXPECT_EQ(outOrig, outRet);
 }
 
+TEST_F(DerivativeStoreTest, RegisterStandardManyAndGetBack) {
+  const DERIV type = DERIV::Standard;
+  const DIRECTION dir = DIRECTION::X;
+  const std::string firstName = "FIRSTSTANDARD";
+
+  store.registerDerivativeMany(
+      [](const DerivativeStore<FieldType>::fieldRefs& inp, std::vector<FieldType>& out,
+         const std::string&) {
+        for (std::size_t k = 0; k < inp.size(); ++k) {
+          out[k].resize(4, 3.0);
+        }
+      },
+      type, dir, STAGGER::None, firstName);
+
+  const auto returned = store.getStandardDerivativeMany(firstName, dir);
+
+  const FieldType inp;
+  std::vector<FieldType> out(2);
+  returned({inp, inp}, out, "RGN_ALL");
+
+  EXPECT_EQ(out[0], FieldType(4, 3.0));
+  EXPECT_EQ(out[1], FieldType(4, 3.0));
+}
+
+TEST_F(DerivativeStoreTest, RegisterStandardManyTwice) {
+  const DERIV type = DERIV::Standard;
+  const DIRECTION dir = DIRECTION::X;
+
+  store.registerDerivativeMany(standardManyType{}, type, dir, STAGGER::None, "FIRST");
+  EXPECT_THROW(
+      store.registerDerivativeMany(standardManyType{}, type, dir, STAGGER::None, "FIRST"),
+      BoutException);
+}
+
+TEST_F(DerivativeStoreTest, RegisterUpwindAsStandardMany) {
+  EXPECT_THROW(store.registerDerivativeMany(standardManyType{}, DERIV::Upwind,
+                                            DIRECTION::X, STAGGER::None, "FIRST"),
+               BoutException);
+}
+
+TEST_F(DerivativeStoreTest, GetStandardManyFallback) {
+  // Without a batched version, the standard derivative is applied to
+  // each field in turn
+  const DERIV type = DERIV::Standard;
+  const DIRECTION dir = DIRECTION::X;
+  const std::string firstName = "FIRSTSTANDARD";
+
+  store.registerDerivative(standardReturnTenSetToOne, type, dir, STAGGER::None,
+                           firstName);
+
+  const auto returned = store.getStandardDerivativeMany(firstName, dir);
+
+  const FieldType inp;
+  std::vector<FieldType> out(3);
+  returned({inp, inp, inp}, out, "RGN_ALL");
+
+  for (const auto& result : out) {
+    EXPECT_EQ(result, FieldType(10, 1.0));
+  }
+}
+
+TEST_F(DerivativeStoreTest, GetUnknownDerivativeFromStandardMany) {
+  store.registerDerivative(standardType{}, DERIV::Standard, DIRECTION::X, STAGGER::None,
+                           "something");
+  EXPECT_THROW(store.getStandardDerivativeMany("unknown", DIRECTION::X), BoutException);
+}
+
 TEST_F(DerivativeStoreTest, GetUnknownDerivativeFromStandard) {
   // Register something we're not just throwing because the store is empty
   store.registerDerivative(standardType{}, DERIV::Standard, DIRECTION::X, STAGGER::None,
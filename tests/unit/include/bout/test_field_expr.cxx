@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+
+#include "bout/field_expr.hxx"
+#include "bout/mesh.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "test_extras.hxx"
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+using bout::expr::lazy;
+
+class FieldExprTest : public FakeMeshFixture {
+public:
+  FieldExprTest()
+      : FakeMeshFixture(),
+        a(makeField<Field3D>([](Ind3D& i) { return 1.0 + i.x() + 0.5 * i.z(); })),
+        b(makeField<Field3D>([](Ind3D& i) { return 2.0 - i.y() + 0.1 * i.z(); })),
+        c(makeField<Field3D>([](Ind3D& i) { return 3.0 + i.ind; })),
+        d(makeField<Field2D>([](Ind2D& i) { return 4.0 + i.x() * i.y(); })) {}
+
+  Field3D a, b, c;
+  Field2D d;
+};
+
+TEST_F(FieldExprTest, IsExpr) {
+  EXPECT_FALSE(bout::expr::is_expr<Field3D>::value);
+  EXPECT_FALSE(bout::expr::is_expr<BoutReal>::value);
+  EXPECT_TRUE(bout::expr::is_expr<bout::expr::Field3DLeaf>::value);
+  EXPECT_TRUE(bout::expr::is_expr<decltype(lazy(a) * b)>::value);
+  EXPECT_TRUE(bout::expr::is_expr<decltype(-lazy(a))>::value);
+}
+
+TEST_F(FieldExprTest, EagerOperatorsUnchanged) {
+  // Operations between plain fields must not become lazy
+  EXPECT_TRUE((std::is_same<decltype(a * b), Field3D>::value));
+  EXPECT_TRUE((std::is_same<decltype(a * d), Field3D>::value));
+  EXPECT_TRUE((std::is_same<decltype(2.0 * a), Field3D>::value));
+}
+
+TEST_F(FieldExprTest, Lazy) {
+  const Field3D result = bout::expr::evaluate(lazy(a));
+
+  EXPECT_TRUE(IsFieldEqual(result, a));
+  EXPECT_TRUE(areFieldsCompatible(result, a));
+}
+
+TEST_F(FieldExprTest, Field3DOperators) {
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) + b), a + b));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) - b), a - b));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) * b), a * b));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) / b), a / b));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(a / lazy(b)), a / b));
+}
+
+TEST_F(FieldExprTest, Field2DOperators) {
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) + d), a + d));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(d - lazy(a)), d - a));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(d) * a), d * a));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) / d), a / d));
+}
+
+TEST_F(FieldExprTest, BoutRealOperators) {
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) + 2.0), a + 2.0));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(2.0 - lazy(a)), 2.0 - a));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(3 * lazy(a)), 3 * a));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(lazy(a) / 4.0), a / 4.0));
+}
+
+TEST_F(FieldExprTest, Negate) {
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(-lazy(a)), -a));
+  EXPECT_TRUE(IsFieldEqual(bout::expr::evaluate(-(lazy(a) * b)), -(a * b)));
+}
+
+TEST_F(FieldExprTest, Compound) {
+  const Field3D expected = a * b + c / d - a;
+  const Field3D result = bout::expr::evaluate(lazy(a) * b + lazy(c) / d - a);
+
+  EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_ALL", 1e-14));
+}
+
+TEST_F(FieldExprTest, Field2DFirst) {
+  // The result should take its metadata from the Field3D operand
+  const Field3D result = bout::expr::evaluate(lazy(d) * 2.0 + a);
+
+  EXPECT_TRUE(IsFieldEqual(result, d * 2.0 + a));
+  EXPECT_TRUE(areFieldsCompatible(result, a));
+}
+
+TEST_F(FieldExprTest, AssignRegion) {
+  Field3D result{-1.0};
+
+  bout::expr::assign(result, lazy(a) * b, "RGN_NOBNDRY");
+
+  EXPECT_TRUE(IsFieldEqual(result, a * b, "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(result, -1.0, "RGN_XGUARDS"));
+}
+
+TEST_F(FieldExprTest, AssignUnallocated) {
+  Field3D result;
+
+  bout::expr::assign(result, lazy(a) - c);
+
+  EXPECT_TRUE(IsFieldEqual(result, a - c));
+}
+
+TEST_F(FieldExprTest, AssignAliased) {
+  const Field3D expected = 2.0 * a + b;
+
+  bout::expr::assign(a, 2.0 * lazy(a) + b);
+
+  EXPECT_TRUE(IsFieldEqual(a, expected));
+}
+
+TEST_F(FieldExprTest, AssignShared) {
+  // Assigning to a field must not modify other fields sharing its data
+  Field3D result = a;
+  Field3D original{a};
+  original.allocate();
+
+  bout::expr::assign(result, lazy(b) + 1.0);
+
+  EXPECT_TRUE(IsFieldEqual(result, b + 1.0));
+  EXPECT_TRUE(IsFieldEqual(a, original));
+}
+
+#if CHECK > 0
+TEST_F(FieldExprTest, Unallocated) {
+  Field3D empty;
+
+  EXPECT_THROW(bout::expr::evaluate(lazy(a) + empty), BoutException);
+}
+#endif
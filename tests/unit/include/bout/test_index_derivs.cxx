@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+
+#include "bout/index_derivs.hxx"
+#include "bout/mesh.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "stencils.hxx"
+#include "test_extras.hxx"
+
+#include <functional>
+#include <vector>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Stencils with a different weight for each point, so that any mix-up
+// in the neighbours used by the line-based kernels shows up
+DEFINE_STANDARD_DERIV(WeightedStencil1, "TEST1", 1, DERIV::Standard) {
+  return f.m + 10. * f.c + 100. * f.p;
+}
+
+DEFINE_STANDARD_DERIV(WeightedStencil2, "TEST2", 2, DERIV::Standard) {
+  return f.mm + 10. * f.m + 100. * f.c + 1000. * f.p + 10000. * f.pp;
+}
+
+DEFINE_UPWIND_DERIV(WeightedUpwind2, "TEST2", 2, DERIV::Upwind) {
+  return vc * (f.mm + 10. * f.m + 100. * f.c + 1000. * f.p + 10000. * f.pp);
+}
+
+namespace {
+/// Apply \p Method at each point of \p region, using populateStencil
+template <DIRECTION direction, int nGuards, typename Method, typename T>
+T pointwise(const T& var, const std::string& region) {
+  const Method method{};
+  T result{emptyFrom(var)};
+  BOUT_FOR(i, var.getRegion(region)) {
+    result[i] = method(populateStencil<direction, STAGGER::None, nGuards>(var, i));
+  }
+  return result;
+}
+
+template <DIRECTION direction, int nGuards, typename Method, typename T>
+T pointwiseUpwind(const T& vel, const T& var, const std::string& region) {
+  const Method method{};
+  T result{emptyFrom(var)};
+  BOUT_FOR(i, var.getRegion(region)) {
+    result[i] =
+        method(vel[i], populateStencil<direction, STAGGER::None, nGuards>(var, i));
+  }
+  return result;
+}
+} // namespace
+
+class IndexDerivsTest : public FakeMeshFixture {
+public:
+  IndexDerivsTest()
+      : FakeMeshFixture(),
+        f3d(makeField<Field3D>([](Ind3D& i) { return i.ind * (1. + 0.01 * i.ind); })),
+        v3d(makeField<Field3D>([](Ind3D& i) { return 2. - i.z(); })),
+        f2d(makeField<Field2D>([](Ind2D& i) { return i.ind * (1. + 0.1 * i.ind); })) {}
+
+  Field3D f3d, v3d;
+  Field2D f2d;
+};
+
+TEST_F(IndexDerivsTest, StandardX) {
+  Field3D result{emptyFrom(f3d)};
+  DerivativeType<WeightedStencil1>{}.standard<DIRECTION::X, STAGGER::None, 1>(
+      f3d, result, "RGN_NOX");
+
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::X, 1, WeightedStencil1>(f3d, "RGN_NOX"), "RGN_NOX"));
+}
+
+TEST_F(IndexDerivsTest, StandardY) {
+  Field3D result{emptyFrom(f3d)};
+  DerivativeType<WeightedStencil1>{}.standard<DIRECTION::Y, STAGGER::None, 1>(
+      f3d, result, "RGN_NOY");
+
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::Y, 1, WeightedStencil1>(f3d, "RGN_NOY"), "RGN_NOY"));
+}
+
+TEST_F(IndexDerivsTest, StandardZ) {
+  // Includes points which wrap around the ends of each Z-line
+  Field3D result{emptyFrom(f3d)};
+  DerivativeType<WeightedStencil2>{}.standard<DIRECTION::Z, STAGGER::None, 2>(
+      f3d, result, "RGN_ALL");
+
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::Z, 2, WeightedStencil2>(f3d, "RGN_ALL"), "RGN_ALL"));
+}
+
+TEST_F(IndexDerivsTest, StandardZPartialRegion) {
+  // A region whose blocks don't start or end on Z-line boundaries
+  Region<Ind3D>::RegionIndices indices;
+  for (int i = 3; i < 40; i += 2) {
+    indices.push_back({i, ny, nz});
+    indices.push_back({i + 1, ny, nz});
+    indices.push_back({i + 4, ny, nz});
+  }
+  mesh->addRegion3D("RGN_TEST_PARTIAL", Region<Ind3D>{indices}.unique());
+
+  Field3D result{emptyFrom(f3d)};
+  DerivativeType<WeightedStencil2>{}.standard<DIRECTION::Z, STAGGER::None, 2>(
+      f3d, result, "RGN_TEST_PARTIAL");
+
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::Z, 2, WeightedStencil2>(f3d, "RGN_TEST_PARTIAL"),
+      "RGN_TEST_PARTIAL"));
+}
+
+TEST_F(IndexDerivsTest, UpwindZ) {
+  Field3D result{emptyFrom(f3d)};
+  DerivativeType<WeightedUpwind2>{}.upwindOrFlux<DIRECTION::Z, STAGGER::None, 2>(
+      v3d, f3d, result, "RGN_ALL");
+
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwiseUpwind<DIRECTION::Z, 2, WeightedUpwind2>(v3d, f3d, "RGN_ALL"),
+      "RGN_ALL"));
+}
+
+TEST_F(IndexDerivsTest, Field2D) {
+  Field2D result{emptyFrom(f2d)};
+
+  DerivativeType<WeightedStencil1>{}.standard<DIRECTION::X, STAGGER::None, 1>(
+      f2d, result, "RGN_NOX");
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::X, 1, WeightedStencil1>(f2d, "RGN_NOX"), "RGN_NOX"));
+
+  DerivativeType<WeightedStencil1>{}.standard<DIRECTION::Y, STAGGER::None, 1>(
+      f2d, result, "RGN_NOY");
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::Y, 1, WeightedStencil1>(f2d, "RGN_NOY"), "RGN_NOY"));
+
+  DerivativeType<WeightedStencil2>{}.standard<DIRECTION::Z, STAGGER::None, 2>(
+      f2d, result, "RGN_ALL");
+  EXPECT_TRUE(IsFieldEqual(
+      result, pointwise<DIRECTION::Z, 2, WeightedStencil2>(f2d, "RGN_ALL"), "RGN_ALL"));
+}
+
+TEST_F(IndexDerivsTest, StandardManyX) {
+  const std::vector<std::reference_wrapper<const Field3D>> vars{f3d, v3d};
+  std::vector<Field3D> results{emptyFrom(f3d), emptyFrom(v3d)};
+  DerivativeType<WeightedStencil1>{}.standardMany<DIRECTION::X, STAGGER::None, 1>(
+      vars, results, "RGN_NOX");
+
+  EXPECT_TRUE(IsFieldEqual(results[0],
+                           pointwise<DIRECTION::X, 1, WeightedStencil1>(f3d, "RGN_NOX"),
+                           "RGN_NOX"));
+  EXPECT_TRUE(IsFieldEqual(results[1],
+                           pointwise<DIRECTION::X, 1, WeightedStencil1>(v3d, "RGN_NOX"),
+                           "RGN_NOX"));
+}
+
+TEST_F(IndexDerivsTest, StandardManyZ) {
+  const std::vector<std::reference_wrapper<const Field3D>> vars{f3d, v3d, f3d};
+  std::vector<Field3D> results{emptyFrom(f3d), emptyFrom(v3d), emptyFrom(f3d)};
+  DerivativeType<WeightedStencil2>{}.standardMany<DIRECTION::Z, STAGGER::None, 2>(
+      vars, results, "RGN_ALL");
+
+  const auto expected_f = pointwise<DIRECTION::Z, 2, WeightedStencil2>(f3d, "RGN_ALL");
+  EXPECT_TRUE(IsFieldEqual(results[0], expected_f, "RGN_ALL"));
+  EXPECT_TRUE(IsFieldEqual(
+      results[1], pointwise<DIRECTION::Z, 2, WeightedStencil2>(v3d, "RGN_ALL"),
+      "RGN_ALL"));
+  EXPECT_TRUE(IsFieldEqual(results[2], expected_f, "RGN_ALL"));
+}
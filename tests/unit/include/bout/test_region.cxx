@@ -342,6 +342,83 @@ TEST_F(RegionTest, regionLoopNoBndryInner) {
   EXPECT_EQ(numMatching, ninner);
 }
 
+TEST_F(RegionTest, regionLoopBlocksAll) {
+  const auto &region = mesh->getRegion3D("RGN_ALL");
+
+  Field3D a{0.};
+  BoutReal* a_data = &a(0, 0, 0);
+  BOUT_FOR_BLOCKS(first, last, region) {
+    BOUT_OMP(simd)
+    for (int i = first; i < last; ++i) {
+      a_data[i] += 1.0;
+    }
+  }
+
+  for (int i = 0; i < mesh->LocalNx; ++i) {
+    for (int j = 0; j < mesh->LocalNy; ++j) {
+      for (int k = 0; k < mesh->LocalNz; ++k) {
+        EXPECT_DOUBLE_EQ(a(i, j, k), 1.0);
+      }
+    }
+  }
+}
+
+TEST_F(RegionTest, regionLoopBlocksNoBndry) {
+  const auto &region = mesh->getRegion3D("RGN_NOBNDRY");
+
+  Field3D a{0.};
+  BoutReal* a_data = &a(0, 0, 0);
+  BOUT_FOR_BLOCKS(first, last, region) {
+    for (int i = first; i < last; ++i) {
+      a_data[i] += 1.0;
+    }
+  }
+
+  Field3D expected{0.};
+  BOUT_FOR(i, region) {
+    expected[i] = 1.0;
+  }
+
+  for (int i = 0; i < mesh->LocalNx; ++i) {
+    for (int j = 0; j < mesh->LocalNy; ++j) {
+      for (int k = 0; k < mesh->LocalNz; ++k) {
+        EXPECT_DOUBLE_EQ(a(i, j, k), expected(i, j, k));
+      }
+    }
+  }
+}
+
+TEST_F(RegionTest, regionLoopBlocksSerial) {
+  const auto &region = mesh->getRegion3D("RGN_NOBNDRY");
+
+  int count = 0;
+  int nblocks = 0;
+  BOUT_FOR_BLOCKS_SERIAL(first, last, region) {
+    EXPECT_GT(last, first);
+    EXPECT_LE(last - first, MAXREGIONBLOCKSIZE);
+    count += last - first;
+    ++nblocks;
+  }
+
+  EXPECT_EQ(count, region.size());
+  EXPECT_EQ(nblocks, region.getBlocks().size());
+}
+
+TEST_F(RegionTest, regionLoopBlocksSection) {
+  const auto &region = mesh->getRegion3D("RGN_ALL");
+
+  int count = 0;
+  BOUT_OMP(parallel) {
+    BOUT_FOR_BLOCKS_OMP(first, last, region, for reduction(+:count)) {
+      count += last - first;
+    }
+  }
+
+  const int nmesh = RegionTest::nx * RegionTest::ny * RegionTest::nz;
+
+  EXPECT_EQ(count, nmesh);
+}
+
 TEST_F(RegionTest, regionAsSorted) {
   // Contiguous blocks to insert
   std::vector<std::pair<int, int>> blocksIn = {
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "bout_types.hxx"
+#include "derivs.hxx"
 #include "fft.hxx"
 #include "field3d.hxx"
 #include "test_extras.hxx"
@@ -340,6 +341,44 @@ TEST_P(FirstDerivativesInterfaceTest, Sanity) {
   EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", derivatives_tolerance));
 }
 
+TEST_P(FirstDerivativesInterfaceTest, Batched) {
+  Field3D scaled = 2.0 * input + 1.0;
+  ParallelTransformIdentity identity{*mesh};
+  identity.calcParallelSlices(scaled);
+
+  const std::vector<std::reference_wrapper<const Field3D>> inputs{input, scaled,
+                                                                  velocity};
+  std::vector<Field3D> results;
+  std::vector<Field3D> expected_results;
+  switch (std::get<0>(GetParam())) {
+    case DIRECTION::X:
+      results = bout::derivatives::index::DDX(inputs);
+      for (const Field3D& f : inputs) {
+        expected_results.push_back(bout::derivatives::index::DDX(f));
+      }
+      break;
+    case DIRECTION::Y:
+      results = bout::derivatives::index::DDY(inputs);
+      for (const Field3D& f : inputs) {
+        expected_results.push_back(bout::derivatives::index::DDY(f));
+      }
+      break;
+    case DIRECTION::Z:
+      results = bout::derivatives::index::DDZ(inputs);
+      for (const Field3D& f : inputs) {
+        expected_results.push_back(bout::derivatives::index::DDZ(f));
+      }
+      break;
+  default:
+    break;
+  }
+
+  ASSERT_EQ(results.size(), inputs.size());
+  for (std::size_t k = 0; k < results.size(); ++k) {
+    EXPECT_TRUE(IsFieldEqual(results[k], expected_results[k], "RGN_NOBNDRY"));
+  }
+}
+
 using SecondDerivativesInterfaceTest = DerivativesTest;
 
 INSTANTIATE_TEST_SUITE_P(X, SecondDerivativesInterfaceTest,
@@ -488,3 +527,63 @@ TEST_P(FluxDerivativesInterfaceTest, Sanity) {
 
   EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", derivatives_tolerance));
 }
+
+/////////////////////////////////////////////////////////////////////
+// Batched derivatives including the metric
+
+class BatchedDerivativesTest : public FakeMeshFixture {
+public:
+  BatchedDerivativesTest()
+      : FakeMeshFixture(),
+        a(makeField<Field3D>([](Ind3D& i) { return std::sin(i.x() + 0.3 * i.z()); })),
+        b(makeField<Field3D>([](Ind3D& i) { return i.y() * (1.0 + 0.5 * i.z()); })) {
+    test_coords->dx = makeField<Field2D>([](Ind2D& i) { return 1.0 + 0.1 * i.ind; });
+    test_coords->dy = makeField<Field2D>([](Ind2D& i) { return 2.0 - 0.1 * i.ind; });
+    test_coords->dz = 0.3;
+  }
+
+  Field3D a, b;
+};
+
+TEST_F(BatchedDerivativesTest, DDX) {
+  const auto result = DDX({a, b});
+
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_TRUE(IsFieldEqual(result[0], DDX(a), "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(result[1], DDX(b), "RGN_NOBNDRY"));
+}
+
+TEST_F(BatchedDerivativesTest, DDY) {
+  const auto result = DDY({a, b});
+
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_TRUE(IsFieldEqual(result[0], DDY(a), "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(result[1], DDY(b), "RGN_NOBNDRY"));
+}
+
+TEST_F(BatchedDerivativesTest, DDZ) {
+  const auto result = DDZ({a, b, a});
+
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_TRUE(IsFieldEqual(result[0], DDZ(a), "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(result[1], DDZ(b), "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(result[2], DDZ(a), "RGN_NOBNDRY"));
+}
+
+TEST_F(BatchedDerivativesTest, Empty) {
+  EXPECT_TRUE(DDX(std::vector<std::reference_wrapper<const Field3D>>{}).empty());
+}
+
+TEST_F(BatchedDerivativesTest, DifferentLocations) {
+  Field3D c{mesh_staggered};
+  c.allocate();
+  c = 1.0;
+  c.setLocation(CELL_XLOW);
+  Field3D d{mesh_staggered};
+  d.allocate();
+  d = 1.0;
+
+  EXPECT_THROW(bout::derivatives::index::DDX(
+                   std::vector<std::reference_wrapper<const Field3D>>{c, d}),
+               BoutException);
+}
@@ -109,4 +109,75 @@ TEST_P(FFTTest, RoundTrip) {
     EXPECT_NEAR(output[i], real_signal[i], FFTTolerance);
   }
 }
+
+TEST_P(FFTTest, rfftMany) {
+  // Scale each copy of the signal differently, so we can tell them apart
+  constexpr int howmany = 3;
+  Array<BoutReal> input{size * howmany};
+  for (int line = 0; line < howmany; ++line) {
+    for (int i = 0; i < size; ++i) {
+      input[line * size + i] = (line + 1) * real_signal[i];
+    }
+  }
+
+  Array<dcomplex> output{nmodes * howmany};
+
+  // Compute all the forward real FFTs together
+  bout::fft::rfft_many(input.begin(), size, howmany, output.begin());
+
+  for (int line = 0; line < howmany; ++line) {
+    for (int i = 0; i < nmodes; ++i) {
+      EXPECT_NEAR(real(output[line * nmodes + i]), (line + 1) * real(fft_signal[i]),
+                  FFTTolerance);
+      EXPECT_NEAR(imag(output[line * nmodes + i]), (line + 1) * imag(fft_signal[i]),
+                  FFTTolerance);
+    }
+  }
+}
+
+TEST_P(FFTTest, irfftMany) {
+  constexpr int howmany = 3;
+  Array<dcomplex> input{nmodes * howmany};
+  for (int line = 0; line < howmany; ++line) {
+    for (int i = 0; i < nmodes; ++i) {
+      input[line * nmodes + i] = static_cast<BoutReal>(line + 1) * fft_signal[i];
+    }
+  }
+  const Array<dcomplex> input_copy{copy(input)};
+
+  Array<BoutReal> output{size * howmany};
+
+  // Compute all the inverse real FFTs together
+  bout::fft::irfft_many(input.begin(), size, howmany, output.begin());
+
+  for (int line = 0; line < howmany; ++line) {
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(output[line * size + i], (line + 1) * real_signal[i], FFTTolerance);
+    }
+  }
+
+  // Input should be unchanged
+  for (int i = 0; i < nmodes * howmany; ++i) {
+    EXPECT_EQ(input[i], input_copy[i]);
+  }
+}
+
+TEST_P(FFTTest, RoundTripManyUnaligned) {
+  // Offset the arrays by one element so they are not SIMD aligned
+  constexpr int howmany = 2;
+  Array<BoutReal> input{size * howmany + 1};
+  for (int i = 0; i < size * howmany; ++i) {
+    input[i + 1] = real_signal[i % size];
+  }
+
+  Array<dcomplex> fft_output{nmodes * howmany + 1};
+  Array<BoutReal> output{size * howmany + 1};
+
+  bout::fft::rfft_many(input.begin() + 1, size, howmany, fft_output.begin() + 1);
+  bout::fft::irfft_many(fft_output.begin() + 1, size, howmany, output.begin() + 1);
+
+  for (int i = 0; i < size * howmany; ++i) {
+    EXPECT_NEAR(output[i + 1], real_signal[i % size], FFTTolerance);
+  }
+}
 #endif
@@ -3,6 +3,8 @@
 #include "fft.hxx"
 #include "test_extras.hxx"
 
+#include <vector>
+
 #ifdef BOUT_HAS_FFTW
 // The unit tests use the global mesh
 using namespace bout::globals;
@@ -129,6 +131,18 @@ TEST_F(ShiftedMetricTest, ToFieldAligned) {
   EXPECT_FALSE(areFieldsCompatible(result, input));
 }
 
+TEST_F(ShiftedMetricTest, CalcFieldAligned) {
+  const Field3D expected = toFieldAligned(input);
+
+  // Shift straight into a buffer rather than a new field
+  std::vector<BoutReal> result(mesh->LocalNx * mesh->LocalNy * mesh->LocalNz);
+  input.getCoordinates()->getParallelTransform().calcFieldAligned(input, result.data());
+
+  for (const auto& i : input.getRegion("RGN_ALL")) {
+    EXPECT_NEAR(result[i.ind], expected[i], FFTTolerance);
+  }
+}
+
 TEST_F(ShiftedMetricTest, FromFieldAligned) {
   // reset input.yDirectionType so that fromFieldAligned is not a null
   // operation
@@ -31,3 +31,97 @@ TEST(BoutMeshTest, SingleCoreDecomposition) {
   BoutMesh mesh{new GridFromOptions{&options}, &options};
   EXPECT_NO_THROW(mesh.load());
 }
+
+TEST(BoutMeshTest, CommunicationPlan) {
+  WithQuietOutput info{output_info};
+  WithQuietOutput warn{output_warn};
+  WithQuietOutput progress{output_progress};
+
+  Options options{};
+  options["ny"] = 4;
+  options["nx"] = 4;
+  options["nz"] = 3;
+  options["MXG"] = 1;
+  options["MYG"] = 1;
+  options["calcParallelSlices_on_communicate"] = false;
+
+  // Everything is in the core, so Y is periodic and this processor
+  // exchanges guard cells with itself
+  BoutMesh mesh{new GridFromOptions{&options}, &options};
+  mesh.load();
+
+  Field3D f{&mesh};
+  f.allocate();
+  for (int x = 0; x < mesh.LocalNx; ++x) {
+    for (int y = 0; y < mesh.LocalNy; ++y) {
+      for (int z = 0; z < mesh.LocalNz; ++z) {
+        f(x, y, z) = (y >= mesh.ystart and y <= mesh.yend) ? x + 10. * y + 100. * z : -1.;
+      }
+    }
+  }
+  Field3D expected{f};
+  expected.allocate();
+  mesh.communicate(expected);
+
+  FieldGroup g{f};
+  auto plan = mesh.createCommunicationPlan(g);
+
+  // The plan can be used more than once
+  for (int i = 0; i < 2; ++i) {
+    mesh.communicate(*plan);
+    EXPECT_TRUE(IsFieldEqual(f, expected, "RGN_NOX"));
+  }
+
+  // Lower guard cells come from the top of the domain
+  EXPECT_DOUBLE_EQ(f(1, mesh.ystart - 1, 2), f(1, mesh.yend, 2));
+  EXPECT_DOUBLE_EQ(f(1, mesh.yend + 1, 0), f(1, mesh.ystart, 0));
+}
+
+TEST(BoutMeshTest, CommunicateMixedFields) {
+  WithQuietOutput info{output_info};
+  WithQuietOutput warn{output_warn};
+  WithQuietOutput progress{output_progress};
+
+  Options options{};
+  options["ny"] = 4;
+  options["nx"] = 5;
+  options["nz"] = 3;
+  options["MXG"] = 1;
+  options["MYG"] = 2;
+  options["calcParallelSlices_on_communicate"] = false;
+
+  BoutMesh mesh{new GridFromOptions{&options}, &options};
+  mesh.load();
+
+  const int period = mesh.yend - mesh.ystart + 1;
+  auto interior_y = [&](int y) {
+    return mesh.ystart + (y - mesh.ystart + period) % period;
+  };
+
+  Field3D f{&mesh};
+  Field2D g{&mesh};
+  f.allocate();
+  g.allocate();
+  for (int x = 0; x < mesh.LocalNx; ++x) {
+    for (int y = 0; y < mesh.LocalNy; ++y) {
+      const bool guard = (y < mesh.ystart or y > mesh.yend);
+      g(x, y) = guard ? -1. : x - 10. * y;
+      for (int z = 0; z < mesh.LocalNz; ++z) {
+        f(x, y, z) = guard ? -1. : x + 10. * y + 100. * z;
+      }
+    }
+  }
+
+  // Fields may appear more than once in a group
+  FieldGroup group{f, g, f};
+  mesh.communicate(group);
+
+  for (int x = mesh.xstart; x <= mesh.xend; ++x) {
+    for (int y = 0; y < mesh.LocalNy; ++y) {
+      EXPECT_DOUBLE_EQ(g(x, y), x - 10. * interior_y(y));
+      for (int z = 0; z < mesh.LocalNz; ++z) {
+        EXPECT_DOUBLE_EQ(f(x, y, z), x + 10. * interior_y(y) + 100. * z);
+      }
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#include "gtest/gtest.h"
+
+#include "bout/mesh.hxx"
+#include "difops.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "test_extras.hxx"
+
+#include <cmath>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+// Checks the Arakawa bracket against the straightforward
+// implementation in BRACKET_ARAKAWA_OLD
+class BracketTest : public FakeMeshFixture {
+public:
+  BracketTest()
+      : FakeMeshFixture(),
+        f(makeField<Field3D>(
+            [](Ind3D& i) { return std::sin(i.x() + 0.7 * i.z()) + 0.1 * i.y(); })),
+        g(makeField<Field3D>([](Ind3D& i) { return std::cos(0.3 * i.x() * i.z()) + i.y(); })),
+        h(makeField<Field2D>([](Ind2D& i) { return 1.0 + i.x() * i.x() + 0.5 * i.y(); })) {
+    test_coords->dx = makeField<Field2D>([](Ind2D& i) { return 1.0 + 0.1 * i.ind; });
+    test_coords->dz = 0.4;
+  }
+
+  Field3D f, g;
+  Field2D h;
+};
+
+TEST_F(BracketTest, Arakawa3D3D) {
+  EXPECT_TRUE(IsFieldEqual(bracket(f, g, BRACKET_ARAKAWA),
+                           bracket(f, g, BRACKET_ARAKAWA_OLD), "RGN_NOBNDRY", 1e-13));
+}
+
+TEST_F(BracketTest, Arakawa3D2D) {
+  EXPECT_TRUE(IsFieldEqual(bracket(f, h, BRACKET_ARAKAWA),
+                           bracket(f, h, BRACKET_ARAKAWA_OLD), "RGN_NOBNDRY", 1e-13));
+}
+
+TEST_F(BracketTest, Arakawa2D3D) {
+  // The bracket is antisymmetric
+  EXPECT_TRUE(IsFieldEqual(bracket(h, f, BRACKET_ARAKAWA),
+                           -bracket(f, h, BRACKET_ARAKAWA_OLD), "RGN_NOBNDRY", 1e-13));
+}
+
+TEST_F(BracketTest, ArakawaSelf) {
+  // [f, f] = 0
+  EXPECT_TRUE(IsFieldEqual(bracket(f, f, BRACKET_ARAKAWA), 0.0, "RGN_NOBNDRY", 1e-13));
+}
@@ -82,6 +82,61 @@ TEST_F(MeshTest, AddRegionPerpToMesh) {
   EXPECT_THROW(localmesh.addRegionPerp("RGN_JUNK_Perp", junk), BoutException);
 }
 
+TEST_F(MeshTest, InteriorRegions) {
+  FakeMesh bigmesh(7, 9, 3);
+  bigmesh.createDefaultRegions();
+
+  const auto& interior = bigmesh.getRegion3D("RGN_INTERIOR");
+  const auto& edge = bigmesh.getRegion3D("RGN_INTERIOR_EDGE");
+
+  // One guard cell on each side, so the interior is x in [2, 4], y in [2, 6]
+  EXPECT_EQ(interior.size(), 3 * 5 * 3);
+  EXPECT_EQ(interior.size() + edge.size(), bigmesh.getRegion3D("RGN_NOBNDRY").size());
+
+  for (const auto& i : interior) {
+    EXPECT_GE(i.x(), 2);
+    EXPECT_LE(i.x(), 4);
+    EXPECT_GE(i.y(), 2);
+    EXPECT_LE(i.y(), 6);
+  }
+
+  EXPECT_EQ(bigmesh.getRegion2D("RGN_INTERIOR").size(), 3 * 5);
+  EXPECT_EQ(bigmesh.getRegion2D("RGN_INTERIOR_EDGE").size(), 5 * 7 - 3 * 5);
+  EXPECT_EQ(bigmesh.getRegionPerp("RGN_INTERIOR").size(), 3 * 3);
+  EXPECT_EQ(bigmesh.getRegionPerp("RGN_INTERIOR_EDGE").size(), 5 * 3 - 3 * 3);
+}
+
+TEST_F(MeshTest, InteriorRegionsSmallMesh) {
+  // Only one point in x, so every point is next to a guard cell
+  localmesh.createDefaultRegions();
+
+  EXPECT_EQ(localmesh.getRegion3D("RGN_INTERIOR").size(), 0);
+  EXPECT_EQ(localmesh.getRegion3D("RGN_INTERIOR_EDGE").size(),
+            localmesh.getRegion3D("RGN_NOBNDRY").size());
+}
+
+TEST_F(MeshTest, CommunicateOverlapped) {
+  localmesh.createDefaultRegions();
+
+  FieldGroup g;
+  std::vector<std::string> regions;
+  localmesh.communicateOverlapped(
+      g, [&regions](const std::string& region) { regions.push_back(region); });
+
+  EXPECT_EQ(regions, std::vector<std::string>({"RGN_INTERIOR", "RGN_INTERIOR_EDGE"}));
+}
+
+TEST_F(MeshTest, DefaultCommunicationPlan) {
+  FieldGroup g;
+
+  auto plan = localmesh.createCommunicationPlan(g);
+
+  EXPECT_TRUE(plan->getFields().empty());
+  EXPECT_NO_THROW(plan->start());
+  EXPECT_NO_THROW(plan->wait());
+  EXPECT_NO_THROW(localmesh.communicate(*plan));
+}
+
 TEST_F(MeshTest, Ind2DTo3D) {
   Ind2D index2d_0(0);
   Ind2D index2d_7(7);
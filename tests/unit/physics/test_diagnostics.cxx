@@ -0,0 +1,164 @@
+// Test reduced diagnostics written to a Datafile
+
+#if defined(NCDF4) || defined(NCDF) || defined(HDF5)
+
+#include "gtest/gtest.h"
+
+#include "bout/constants.hxx"
+#include "bout/diagnostics.hxx"
+#include "bout/mesh.hxx"
+#include "boutexception.hxx"
+#include "datafile.hxx"
+#include "dataformat.hxx"
+#include "field3d.hxx"
+#include "options.hxx"
+#include "test_extras.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Global mesh
+namespace bout {
+namespace globals {
+extern Mesh* mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class DiagnosticsTest : public FakeMeshFixture {
+public:
+  DiagnosticsTest()
+      : FakeMeshFixture(),
+        // Z average is x + 10 y, plus a mode 2 with amplitude 3
+        f(makeField<Field3D>([](Ind3D& i) {
+          return i.x() + 10. * i.y() + 3. * std::cos(TWOPI * 2. * i.z() / nz);
+        })) {
+    datafile_options["async"] = false;
+  }
+  ~DiagnosticsTest() override { std::remove((basename + ".0" + extension).c_str()); }
+
+#if defined(NCDF4) || defined(NCDF)
+  const std::string extension{".nc"};
+#else
+  const std::string extension{".h5"};
+#endif
+  /// Temporary filename, to which Datafile adds the processor number
+  const std::string basename{std::tmpnam(nullptr)};
+  const std::string filename{basename + extension};
+
+  /// Calculate the diagnostics set in \p options, write a single
+  /// record, and read back the Field2D \p name
+  std::vector<BoutReal> writeAndRead(Options& options, const std::string& name) {
+    Datafile datafile{&datafile_options, mesh};
+    bout::Diagnostics diagnostics{options, datafile, mesh};
+    diagnostics.add(f, "f");
+
+    datafile.openw("%s", filename.c_str());
+    diagnostics.calculate();
+    EXPECT_TRUE(datafile.write());
+    datafile.close();
+
+    auto file = data_format(filename.c_str());
+    file->setGlobalOrigin(0, 0, 0);
+    std::vector<BoutReal> result(nx * ny);
+    EXPECT_TRUE(file->openr(filename, 0));
+    file->setRecord(0);
+    EXPECT_TRUE(file->read_rec(result.data(), name, nx, ny));
+    file->close();
+    return result;
+  }
+
+  Field3D f;
+  Options datafile_options;
+};
+
+TEST_F(DiagnosticsTest, Disabled) {
+  Options options;
+  Datafile datafile{&datafile_options, mesh};
+  bout::Diagnostics diagnostics{options, datafile, mesh};
+
+  EXPECT_FALSE(diagnostics.enabled());
+  diagnostics.add(f, "f");
+  EXPECT_NO_THROW(diagnostics.calculate());
+}
+
+TEST_F(DiagnosticsTest, DC) {
+  Options options;
+  options["dc"] = "f";
+
+  const auto result = writeAndRead(options, "f_dc");
+  for (int x = 0; x < nx; ++x) {
+    for (int y = 0; y < ny; ++y) {
+      EXPECT_NEAR(result[x * ny + y], x + 10. * y, 1e-12);
+    }
+  }
+}
+
+TEST_F(DiagnosticsTest, SliceElsewhere) {
+  // The slice isn't on this processor, so nothing is written
+  Options options;
+  options["slice"] = "f";
+  options["slice_y"] = 100;
+
+  Datafile datafile{&datafile_options, mesh};
+  bout::Diagnostics diagnostics{options, datafile, mesh};
+  diagnostics.add(f, "f");
+  EXPECT_TRUE(diagnostics.enabled());
+
+  datafile.openw("%s", filename.c_str());
+  EXPECT_NO_THROW(diagnostics.calculate());
+  EXPECT_TRUE(datafile.write());
+  datafile.close();
+}
+
+TEST_F(DiagnosticsTest, MissingField) {
+  Options options;
+  options["dc"] = "f, g";
+
+  Datafile datafile{&datafile_options, mesh};
+  bout::Diagnostics diagnostics{options, datafile, mesh};
+  diagnostics.add(f, "f");
+
+  EXPECT_THROW(diagnostics.calculate(), BoutException);
+}
+
+TEST_F(DiagnosticsTest, AddTwice) {
+  Options options;
+  options["dc"] = "f";
+
+  Datafile datafile{&datafile_options, mesh};
+  bout::Diagnostics diagnostics{options, datafile, mesh};
+  diagnostics.add(f, "f");
+
+  EXPECT_THROW(diagnostics.add(f, "f"), BoutException);
+}
+
+TEST_F(DiagnosticsTest, BadNumberOfModes) {
+  Options options;
+  options["modes"] = "f";
+  options["nmodes"] = nz;
+
+  Datafile datafile{&datafile_options, mesh};
+  EXPECT_THROW((bout::Diagnostics{options, datafile, mesh}), BoutException);
+}
+
+#ifdef BOUT_HAS_FFTW
+TEST_F(DiagnosticsTest, Modes) {
+  Options options;
+  options["modes"] = "f";
+  options["nmodes"] = 3;
+
+  for (int k = 1; k <= 3; ++k) {
+    const BoutReal expected = (k == 2) ? 3.0 : 0.0;
+    for (const auto& value : writeAndRead(options, "f_mode" + std::to_string(k))) {
+      EXPECT_NEAR(value, expected, 1e-12);
+    }
+  }
+}
+#endif
+
+#endif // NCDF4 || NCDF || HDF5
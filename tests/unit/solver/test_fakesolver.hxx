@@ -65,12 +65,17 @@ public:
 
   // Shims for protected functions
   auto getMaxTimestepShim() const -> BoutReal { return max_dt; }
+  auto getIterationShim() const -> int { return iteration; }
+  void setIterationShim(int new_iteration) { iteration = new_iteration; }
   auto getLocalNShim() -> int { return getLocalN(); }
   auto haveUserPreconShim() -> bool { return have_user_precon(); }
   auto runPreconShim(BoutReal t, BoutReal gamma, BoutReal delta) -> int {
     return run_precon(t, gamma, delta);
   }
   auto globalIndexShim(int local_start) -> Field3D { return globalIndex(local_start); }
+  void saveVarsShim(BoutReal* udata) { save_vars(udata); }
+  void loadVarsShim(BoutReal* udata) { load_vars(udata); }
+  void setSlowShim(BoutReal* udata) { set_slow(udata); }
   auto getMonitorsShim() const -> const std::list<Monitor*>& { return getMonitors(); }
   auto callMonitorsShim(BoutReal simtime, int iter, int NOUT) -> int {
     return call_monitors(simtime, iter, NOUT);
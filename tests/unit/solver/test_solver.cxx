@@ -574,6 +574,271 @@ TEST_F(SolverTest, GetLocalN) {
   EXPECT_EQ(solver.getLocalNShim(), expected_total);
 }
 
+TEST_F(SolverTest, InterleavedLayout) {
+  static_cast<FakeMesh*>(bout::globals::mesh)->createBoundaryRegions();
+
+  Options options;
+  FakeSolver solver{&options};
+
+  Field2D field2d{bout::globals::mesh};
+  Field3D field3d{bout::globals::mesh};
+  Field3D another3d{bout::globals::mesh};
+  solver.add(field2d, "field2d");
+  solver.add(field3d, "field3d");
+  solver.add(another3d, "another3d");
+  field2d = makeField<Field2D>([](Ind2D& i) { return -1. - i.ind; });
+  field3d = makeField<Field3D>([](Ind3D& i) { return 1. + i.ind; });
+  another3d = makeField<Field3D>([](Ind3D& i) { return 1000. + i.ind; });
+
+  // At each point, the 2D variables then the 3D variables at each z
+  std::vector<BoutReal> expected;
+  for (const auto& i : field2d.getRegion("RGN_NOBNDRY")) {
+    expected.push_back(field2d[i]);
+    for (int z = 0; z < nz; ++z) {
+      const auto i3d = bout::globals::mesh->ind2Dto3D(i, z);
+      expected.push_back(field3d[i3d]);
+      expected.push_back(another3d[i3d]);
+    }
+  }
+
+  std::vector<BoutReal> state(expected.size());
+  solver.saveVarsShim(state.data());
+  EXPECT_EQ(state, expected);
+
+  std::transform(begin(state), end(state), begin(state),
+                 [](BoutReal value) { return 2. * value; });
+  solver.loadVarsShim(state.data());
+
+  BOUT_FOR(i, field2d.getRegion("RGN_NOBNDRY")) {
+    EXPECT_DOUBLE_EQ(field2d[i], -2. - 2. * i.ind);
+  }
+  BOUT_FOR(i, field3d.getRegion("RGN_NOBNDRY")) {
+    EXPECT_DOUBLE_EQ(field3d[i], 2. + 2. * i.ind);
+    EXPECT_DOUBLE_EQ(another3d[i], 2000. + 2. * i.ind);
+  }
+}
+
+TEST_F(SolverTest, FieldMajorLayout) {
+  Options options;
+  options["field_major"] = true;
+  FakeSolver solver{&options};
+
+  Field2D field2d{bout::globals::mesh};
+  Field3D field3d{bout::globals::mesh};
+  solver.add(field2d, "field2d");
+  solver.add(field3d, "field3d");
+  field2d = makeField<Field2D>([](Ind2D& i) { return -1. - i.ind; });
+  field3d = makeField<Field3D>([](Ind3D& i) { return 1. + i.ind; });
+
+  // Each variable in turn, in the same order as its data
+  std::vector<BoutReal> expected;
+  for (const auto& i : field2d.getRegion("RGN_NOBNDRY")) {
+    expected.push_back(field2d[i]);
+  }
+  for (const auto& i : field3d.getRegion("RGN_NOBNDRY")) {
+    expected.push_back(field3d[i]);
+  }
+
+  std::vector<BoutReal> state(expected.size());
+  solver.saveVarsShim(state.data());
+  EXPECT_EQ(state, expected);
+
+  std::transform(begin(state), end(state), begin(state),
+                 [](BoutReal value) { return 2. * value; });
+  solver.loadVarsShim(state.data());
+
+  BOUT_FOR(i, field2d.getRegion("RGN_NOBNDRY")) {
+    EXPECT_DOUBLE_EQ(field2d[i], -2. - 2. * i.ind);
+  }
+  BOUT_FOR(i, field3d.getRegion("RGN_NOBNDRY")) {
+    EXPECT_DOUBLE_EQ(field3d[i], 2. + 2. * i.ind);
+  }
+}
+
+TEST_F(SolverTest, FieldMajorBoundary) {
+  static_cast<FakeMesh*>(bout::globals::mesh)->createBoundaryRegions();
+  Options::root()["field3d"]["evolve_bndry"] = true;
+
+  Options options;
+  options["field_major"] = true;
+  FakeSolver solver{&options};
+
+  const Field3D values = makeField<Field3D>([](Ind3D& i) { return 1. + i.ind; });
+  Field3D field3d{bout::globals::mesh};
+  solver.add(field3d, "field3d");
+  field3d = copy(values);
+
+  const auto& boundary = field3d.getRegion("RGN_BNDRY");
+  const auto& bulk = field3d.getRegion("RGN_NOBNDRY");
+  std::vector<BoutReal> state(boundary.size() + bulk.size());
+  solver.saveVarsShim(state.data());
+  EXPECT_EQ(state.front(), values[*boundary.begin()]);
+  EXPECT_EQ(state.back(), values[*(bulk.end() - 1)]);
+
+  field3d = 0.0;
+  solver.loadVarsShim(state.data());
+  BOUT_FOR(i, boundary) { EXPECT_EQ(field3d[i], values[i]); }
+  BOUT_FOR(i, bulk) { EXPECT_EQ(field3d[i], values[i]); }
+}
+
+TEST_F(SolverTest, FieldMajorGlobalIndex) {
+  Options options;
+  options["field_major"] = true;
+  FakeSolver solver{&options};
+
+  EXPECT_THROW(solver.globalIndexShim(0), BoutException);
+}
+
+TEST_F(SolverTest, SlowVariables) {
+  static_cast<FakeMesh*>(bout::globals::mesh)->createBoundaryRegions();
+  Options::root()["field2d"]["slow"] = true;
+
+  Options options;
+  FakeSolver solver{&options};
+
+  Field2D field2d{bout::globals::mesh};
+  Field3D field3d{bout::globals::mesh};
+  solver.add(field2d, "field2d");
+  solver.add(field3d, "field3d");
+
+  EXPECT_TRUE(solver.slowDerivsNeeded());
+
+  // With the slow variable set to one and the fast to zero, the state
+  // is the same as the mask
+  field2d = 1.0;
+  field3d = 0.0;
+
+  const auto size = field2d.getRegion("RGN_NOBNDRY").size()
+                    + field3d.getRegion("RGN_NOBNDRY").size();
+  std::vector<BoutReal> expected(size);
+  solver.saveVarsShim(expected.data());
+
+  std::vector<BoutReal> slow(size, -1.0);
+  solver.setSlowShim(slow.data());
+  EXPECT_EQ(slow, expected);
+}
+
+TEST_F(SolverTest, SlowVector) {
+  static_cast<FakeMesh*>(bout::globals::mesh)->createBoundaryRegions();
+  Options::root()["vector"]["slow"] = true;
+  Options::root()["another_vector_x"]["slow"] = true;
+
+  Options options;
+  FakeSolver solver{&options};
+
+  Vector3D vector{bout::globals::mesh};
+  Vector3D another_vector{bout::globals::mesh};
+  solver.add(vector, "vector");
+  solver.add(another_vector, "another_vector");
+
+  // All the components of vector are slow, and only the x component
+  // of another_vector
+  vector = 1.0;
+  another_vector = 0.0;
+  another_vector.x = 1.0;
+
+  const auto size = 6 * vector.x.getRegion("RGN_NOBNDRY").size();
+  std::vector<BoutReal> expected(size);
+  solver.saveVarsShim(expected.data());
+
+  std::vector<BoutReal> slow(size, -1.0);
+  solver.setSlowShim(slow.data());
+  EXPECT_EQ(slow, expected);
+}
+
+TEST_F(SolverTest, RestartDeltas) {
+  Options options;
+  FakeSolver solver{&options};
+
+  Field2D field2d{bout::globals::mesh};
+  Field3D field3d{bout::globals::mesh};
+  solver.add(field2d, "field2d");
+  solver.add(field3d, "field3d");
+
+  Datafile file;
+  solver.outputDeltas(file);
+
+  const Field2D base2d = makeField<Field2D>([](Ind2D& i) { return 1. + i.ind / 3.; });
+  const Field3D base3d = makeField<Field3D>([](Ind3D& i) { return -2. + i.ind / 7.; });
+  field2d = copy(base2d);
+  field3d = copy(base3d);
+  solver.setDeltaBase();
+
+  const Field2D new2d = base2d * (1. + 1e-6);
+  const Field3D new3d = base3d + 1e-5 * base3d * base3d;
+  field2d = copy(new2d);
+  field3d = copy(new3d);
+  solver.setIterationShim(4);
+  solver.calculateDeltas();
+  solver.markDeltasComplete();
+
+  // Restore the base, as read from a full restart file
+  field2d = copy(base2d);
+  field3d = copy(base3d);
+  solver.setIterationShim(0);
+  EXPECT_TRUE(solver.deltasMatchState());
+
+  solver.applyDeltas();
+
+  // The changes are reconstructed exactly
+  BOUT_FOR(i, field2d.getRegion("RGN_ALL")) { EXPECT_EQ(field2d[i], new2d[i]); }
+  BOUT_FOR(i, field3d.getRegion("RGN_ALL")) { EXPECT_EQ(field3d[i], new3d[i]); }
+  EXPECT_EQ(solver.getIterationShim(), 4);
+}
+
+TEST_F(SolverTest, RestartDeltasFromDifferentBase) {
+  Options options;
+  FakeSolver solver{&options};
+
+  Field3D field3d{1.0};
+  solver.add(field3d, "field3d");
+
+  Datafile file;
+  solver.outputDeltas(file);
+  solver.setDeltaBase();
+  solver.calculateDeltas();
+  solver.markDeltasComplete();
+
+  // A full restart file has been written since these deltas
+  solver.setIterationShim(2);
+  EXPECT_FALSE(solver.deltasMatchState());
+  EXPECT_THROW(solver.applyDeltas(), BoutException);
+}
+
+TEST_F(SolverTest, RestartDeltasIncomplete) {
+  Options options;
+  FakeSolver solver{&options};
+
+  Field3D field3d{1.0};
+  solver.add(field3d, "field3d");
+
+  Datafile file;
+  solver.outputDeltas(file);
+  solver.setDeltaBase();
+  solver.setIterationShim(3);
+  solver.calculateDeltas();
+  solver.markDeltasComplete();
+
+  // The next deltas have not been marked as completely written
+  solver.setIterationShim(5);
+  solver.calculateDeltas();
+  solver.setIterationShim(0);
+  EXPECT_FALSE(solver.deltasMatchState());
+  EXPECT_THROW(solver.applyDeltas(), BoutException);
+}
+
+TEST_F(SolverTest, RestartDeltasWithoutBase) {
+  Options options;
+  FakeSolver solver{&options};
+
+  Field3D field3d{1.0};
+  solver.add(field3d, "field3d");
+
+  Datafile file;
+  solver.outputDeltas(file);
+  EXPECT_THROW(solver.calculateDeltas(), BoutException);
+}
+
 TEST_F(SolverTest, HavePreconditioner) {
   PhysicsPrecon preconditioner = [](BoutReal time, BoutReal gamma,
                                     BoutReal delta) -> int {
@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include "bout/solver_kernels.hxx"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+/// Long enough to span several blocks, and not a multiple of the block size
+constexpr int n = 1000;
+
+std::vector<BoutReal> makeVector(BoutReal scale) {
+  std::vector<BoutReal> result(n);
+  for (int i = 0; i < n; ++i) {
+    result[i] = scale * (i + 1);
+  }
+  return result;
+}
+} // namespace
+
+TEST(SolverKernelsTest, LinearCombination) {
+  const auto a = makeVector(1.0);
+  const auto b = makeVector(-2.0);
+  const auto c = makeVector(0.5);
+  std::vector<BoutReal> result(n);
+
+  bout::solver::linearCombination(n, {2.0, 3.0, -4.0}, {a.data(), b.data(), c.data()},
+                                  result.data());
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(result[i], 2.0 * a[i] + 3.0 * b[i] - 4.0 * c[i]);
+  }
+}
+
+TEST(SolverKernelsTest, LinearCombinationInPlace) {
+  const auto a = makeVector(1.0);
+  auto b = makeVector(3.0);
+  const auto expected = makeVector(0.5 + 2.0 * 3.0);
+
+  // The result overwrites the second vector
+  bout::solver::linearCombination(n, {0.5, 2.0}, {a.data(), b.data()}, b.data());
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(b[i], expected[i]);
+  }
+}
+
+TEST(SolverKernelsTest, LinearCombinationEmpty) {
+  auto result = makeVector(1.0);
+
+  bout::solver::linearCombination(n, {}, {}, result.data());
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(result[i], 0.0);
+  }
+}
+
+TEST(SolverKernelsTest, MultiAxpy) {
+  auto x = makeVector(1.0);
+  const auto y = makeVector(10.0);
+  const auto z = makeVector(100.0);
+  const auto expected = makeVector(1.0 + 0.1 * 10.0 - 0.01 * 100.0);
+
+  // The result overwrites x
+  bout::solver::multiAxpy(n, x.data(), {0.1, -0.01}, {y.data(), z.data()}, x.data());
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(x[i], expected[i]);
+  }
+
+  // With nothing to add, x is copied
+  std::vector<BoutReal> result(n);
+  bout::solver::multiAxpy(n, y.data(), {}, {}, result.data());
+  EXPECT_EQ(result, y);
+}
+
+TEST(SolverKernelsTest, MeanRelativeError) {
+  const auto a = makeVector(1.0);
+  const auto b = makeVector(3.0);
+  const BoutReal atol = 1e-3;
+
+  BoutReal expected = 0.0;
+  for (int i = 0; i < n; ++i) {
+    expected += std::abs(a[i] - b[i]) / (std::abs(a[i]) + std::abs(b[i]) + atol);
+  }
+  expected /= 2 * n;
+
+  // As if there were twice as many values on other processors. The
+  // sum may be in a different order
+  EXPECT_NEAR(bout::solver::meanRelativeError(n, a.data(), b.data(), atol, 2 * n),
+              expected, 1e-12);
+  EXPECT_EQ(bout::solver::meanRelativeError(n, a.data(), a.data(), atol, n), 0.0);
+}
@@ -368,6 +368,38 @@ TEST(BoutInitialiseFunctions, SetRunFinishInfo) {
   EXPECT_TRUE(options["run"].isSet("finished"));
 }
 
+TEST(BoutInitialiseFunctions, SetupTimeSlices) {
+  Options options;
+
+  bout::experimental::setupTimeSlices(options);
+
+  // Not split by default
+  EXPECT_EQ(BoutComm::timeSize(), 1);
+  EXPECT_EQ(BoutComm::timeRank(), 0);
+  EXPECT_FALSE(options["output"].isSet("enabled"));
+  EXPECT_FALSE(options["restart"].isSet("enabled"));
+}
+
+TEST(BoutInitialiseFunctions, SetupTimeSlicesBadNumber) {
+  Options options;
+  options["solver"]["type"] = "parareal";
+  options["solver"]["time_slices"] = BoutComm::size() + 1;
+
+  EXPECT_THROW(bout::experimental::setupTimeSlices(options), BoutException);
+  EXPECT_EQ(BoutComm::timeSize(), 1);
+}
+
+TEST(BoutInitialiseFunctions, SetupTimeSlicesNotParareal) {
+  Options options;
+  options["solver"]["time_slices"] = 2;
+
+  EXPECT_THROW(bout::experimental::setupTimeSlices(options), BoutException);
+
+  options["solver"]["type"] = "rk4";
+  EXPECT_THROW(bout::experimental::setupTimeSlices(options), BoutException);
+  EXPECT_EQ(BoutComm::timeSize(), 1);
+}
+
 TEST(BoutInitialiseFunctions, CheckDataDirectoryIsAccessible) {
   using namespace bout::experimental;
   EXPECT_THROW(checkDataDirectoryIsAccessible("./bad/non/existent/directory"),
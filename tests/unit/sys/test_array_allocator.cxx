@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include "bout/array.hxx"
+#include "bout/sys/array_allocator.hxx"
+#include "dcomplex.hxx"
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+using bout::ArrayAllocator;
+
+// Note: the allocator is shared by all tests, so each test uses a
+// different size class to avoid reusing blocks from other tests
+
+namespace {
+bool isAligned(const void* ptr) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % ArrayAllocator::alignment == 0;
+}
+} // namespace
+
+TEST(ArrayAllocatorTest, SizeClass) {
+  EXPECT_EQ(ArrayAllocator::sizeClass(0), 0);
+  EXPECT_EQ(ArrayAllocator::sizeClass(1), 64);
+  EXPECT_EQ(ArrayAllocator::sizeClass(64), 64);
+  EXPECT_EQ(ArrayAllocator::sizeClass(65), 128);
+  EXPECT_EQ(ArrayAllocator::sizeClass(1024), 1024);
+  EXPECT_EQ(ArrayAllocator::sizeClass(1025), 1280);
+  EXPECT_EQ(ArrayAllocator::sizeClass(2048), 2048);
+  EXPECT_EQ(ArrayAllocator::sizeClass(2049), 2560);
+
+  for (std::size_t bytes = 1; bytes < 1000000; bytes = bytes * 3 + 1) {
+    const auto size_class = ArrayAllocator::sizeClass(bytes);
+    EXPECT_GE(size_class, bytes);
+    EXPECT_LE(size_class, std::max<std::size_t>(64, bytes + bytes / 4));
+    EXPECT_EQ(size_class % ArrayAllocator::alignment, 0);
+  }
+}
+
+TEST(ArrayAllocatorTest, AllocateZero) {
+  EXPECT_EQ(ArrayAllocator::allocate(0), nullptr);
+  EXPECT_NO_THROW(ArrayAllocator::deallocate(nullptr, 0));
+}
+
+TEST(ArrayAllocatorTest, Aligned) {
+  for (std::size_t bytes : {1, 8, 100, 1000, 12345, 1000000}) {
+    void* ptr = ArrayAllocator::allocate(bytes);
+    EXPECT_TRUE(isAligned(ptr));
+    ArrayAllocator::deallocate(ptr, bytes);
+  }
+}
+
+TEST(ArrayAllocatorTest, ArrayDataAligned) {
+  Array<double> a(17);
+  Array<dcomplex> b(33);
+  EXPECT_TRUE(isAligned(a.begin()));
+  EXPECT_TRUE(isAligned(b.begin()));
+}
+
+TEST(ArrayAllocatorTest, ReuseWithinSizeClass) {
+  void* first = ArrayAllocator::allocate(41000);
+  ArrayAllocator::deallocate(first, 41000);
+
+  ArrayAllocator::resetStatistics();
+
+  // Different size, but in the same size class
+  void* second = ArrayAllocator::allocate(45000);
+  EXPECT_EQ(first, second);
+
+  const auto stats = ArrayAllocator::getStatistics();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 0);
+
+  ArrayAllocator::deallocate(second, 45000);
+}
+
+TEST(ArrayAllocatorTest, Statistics) {
+  const std::size_t bytes = 777777;
+  const std::size_t size_class = ArrayAllocator::sizeClass(bytes);
+
+  ArrayAllocator::resetStatistics();
+  const auto before = ArrayAllocator::getStatistics();
+
+  void* ptr = ArrayAllocator::allocate(bytes);
+  const auto allocated = ArrayAllocator::getStatistics();
+  EXPECT_EQ(allocated.misses, 1);
+  EXPECT_EQ(allocated.bytes_in_use, before.bytes_in_use + size_class);
+  EXPECT_GE(allocated.peak_bytes_in_use, allocated.bytes_in_use);
+
+  ArrayAllocator::deallocate(ptr, bytes);
+  const auto freed = ArrayAllocator::getStatistics();
+  EXPECT_EQ(freed.bytes_in_use, before.bytes_in_use);
+  EXPECT_EQ(freed.bytes_held, before.bytes_held + size_class);
+  EXPECT_EQ(freed.peak_bytes_in_use, allocated.peak_bytes_in_use);
+}
+
+TEST(ArrayAllocatorTest, MaxBytesHeld) {
+  const std::size_t bytes = 333333;
+  void* ptr = ArrayAllocator::allocate(bytes);
+
+  // No room for any more free blocks
+  ArrayAllocator::setMaxBytesHeld(ArrayAllocator::getStatistics().bytes_held);
+  ArrayAllocator::resetStatistics();
+
+  ArrayAllocator::deallocate(ptr, bytes);
+  const auto stats = ArrayAllocator::getStatistics();
+
+  ArrayAllocator::setMaxBytesHeld(std::numeric_limits<std::size_t>::max());
+
+  EXPECT_EQ(stats.discards, 1);
+}
+
+TEST(ArrayAllocatorTest, FreedOnAnotherThread) {
+  const std::size_t bytes = 55555;
+  void* ptr = ArrayAllocator::allocate(bytes);
+
+  std::thread other([ptr, bytes]() { ArrayAllocator::deallocate(ptr, bytes); });
+  other.join();
+
+  // The other thread's blocks are given back to the shared pool when
+  // it exits, so this thread can reuse them
+  ArrayAllocator::resetStatistics();
+  void* reused = ArrayAllocator::allocate(bytes);
+
+  EXPECT_EQ(reused, ptr);
+  EXPECT_EQ(ArrayAllocator::getStatistics().hits, 1);
+
+  ArrayAllocator::deallocate(reused, bytes);
+}